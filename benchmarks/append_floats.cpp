@@ -0,0 +1,151 @@
+// Measures the time taken to format floating point numbers with snitch::append, compared with
+// std::to_chars.
+//
+// Usage: snitch-benchmark-append_floats [iterations]
+//
+// Each formatter is run over the same inputs; the best time out of several repetitions is
+// reported, in nanoseconds per number.
+
+#include "snitch/snitch_append.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+constexpr std::size_t repetitions = 5u;
+
+template<typename T>
+bool append_fixed_precision(snitch::small_string_span ss, T f) noexcept {
+    return snitch::impl::append_constexpr(ss, f);
+}
+
+template<typename T>
+bool append_shortest(snitch::small_string_span ss, T f) noexcept {
+    return snitch::impl::append_constexpr_shortest(ss, f);
+}
+
+template<typename T>
+bool append_to_chars_fixed_precision(snitch::small_string_span ss, T f) noexcept {
+    constexpr int precision = std::is_same_v<T, float> ? 6 : 15;
+    auto [end, err]         = std::to_chars(
+        ss.end(), ss.begin() + ss.capacity(), f, std::chars_format::scientific, precision);
+    if (err != std::errc{}) {
+        return false;
+    }
+
+    ss.grow(static_cast<std::size_t>(end - ss.end()));
+    return true;
+}
+
+template<typename T>
+bool append_to_chars_shortest(snitch::small_string_span ss, T f) noexcept {
+    auto [end, err] =
+        std::to_chars(ss.end(), ss.begin() + ss.capacity(), f, std::chars_format::scientific);
+    if (err != std::errc{}) {
+        return false;
+    }
+
+    ss.grow(static_cast<std::size_t>(end - ss.end()));
+    return true;
+}
+
+template<typename T>
+using formatter = bool (*)(snitch::small_string_span, T) noexcept;
+
+template<typename T>
+double measure(formatter<T> format, const std::vector<T>& inputs) {
+    double      best_time   = std::numeric_limits<double>::max();
+    std::size_t total_chars = 0u;
+
+    for (std::size_t r = 0; r < repetitions; ++r) {
+        snitch::small_string<4096> buffer;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto f : inputs) {
+            if (buffer.available() < snitch::impl::max_float_length) {
+                total_chars += buffer.size();
+                buffer.clear();
+            }
+
+            static_cast<void>(format(buffer, f));
+        }
+        total_chars += buffer.size();
+        const auto end = std::chrono::steady_clock::now();
+
+        const double time = std::chrono::duration<double, std::nano>(end - start).count();
+        best_time         = time < best_time ? time : best_time;
+    }
+
+    // Make sure the output is used, so the formatting is not optimized away.
+    volatile std::size_t sink = total_chars;
+    static_cast<void>(sink);
+
+    return best_time / static_cast<double>(inputs.size());
+}
+
+template<typename T>
+void run(const char* name, const std::vector<T>& inputs) {
+    std::printf(
+        "%-24s fixed precision: %8.1f ns, shortest: %8.1f ns, to_chars (precision): %6.1f ns, "
+        "to_chars (shortest): %6.1f ns\n",
+        name, measure<T>(&append_fixed_precision<T>, inputs),
+        measure<T>(&append_shortest<T>, inputs),
+        measure<T>(&append_to_chars_fixed_precision<T>, inputs),
+        measure<T>(&append_to_chars_shortest<T>, inputs));
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t iterations =
+        argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 100000u;
+
+    // Deterministic pseudo-random inputs (xorshift64).
+    std::uint64_t state = 88172645463325252ull;
+    const auto    next  = [&]() {
+        state ^= state << 13u;
+        state ^= state >> 7u;
+        state ^= state << 17u;
+        return state;
+    };
+
+    std::vector<double> short_doubles;
+    std::vector<double> random_doubles;
+    std::vector<float>  short_floats;
+    std::vector<float>  random_floats;
+
+    while (random_doubles.size() < iterations) {
+        // Typical of test values: few significant digits, moderate exponents.
+        const double value = static_cast<double>(next() % 100000u) /
+                             std::pow(10.0, static_cast<double>(next() % 10u));
+        short_doubles.push_back(value);
+        short_floats.push_back(static_cast<float>(value));
+
+        // Uniformly distributed bit patterns; mostly very large or very small numbers, with all
+        // digits significant.
+        const std::uint64_t bits = next();
+        double              d    = 0.0;
+        std::memcpy(&d, &bits, sizeof(d));
+        const std::uint32_t bits32 = static_cast<std::uint32_t>(bits >> 16u);
+        float               f      = 0.0f;
+        std::memcpy(&f, &bits32, sizeof(f));
+        if (std::isfinite(d) && std::isfinite(f)) {
+            random_doubles.push_back(d);
+            random_floats.push_back(f);
+        }
+    }
+
+    std::printf("%zu numbers, best of %zu runs, time per number:\n", iterations, repetitions);
+    run("double (short decimal):", short_doubles);
+    run("double (random bits):", random_doubles);
+    run("float (short decimal):", short_floats);
+    run("float (random bits):", random_floats);
+
+    return 0;
+}
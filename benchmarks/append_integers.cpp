@@ -0,0 +1,136 @@
+// Measures the time taken to format integers with snitch::append, compared with std::to_chars.
+//
+// Usage: snitch-benchmark-append_integers [iterations]
+//
+// Each formatter is run over the same inputs; the best time out of several repetitions is
+// reported, in nanoseconds per integer.
+
+#include "snitch/snitch_append.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+constexpr std::size_t repetitions = 10u;
+
+// Straightforward formatter, writing one digit per division; used as a reference.
+bool append_one_digit_per_step(snitch::small_string_span ss, snitch::large_uint_t i) noexcept {
+    if (i == 0u) {
+        return snitch::append(ss, "0");
+    }
+
+    std::size_t num_digits = 0u;
+    for (snitch::large_uint_t j = i; j != 0u; j /= 10u) {
+        ++num_digits;
+    }
+
+    snitch::small_string<snitch::impl::max_uint_length> tmp;
+    tmp.resize(num_digits);
+    std::size_t k = 1u;
+    for (snitch::large_uint_t j = i; j != 0u; j /= 10u, ++k) {
+        tmp[tmp.size() - k] = snitch::impl::digits[j % 10u];
+    }
+
+    return snitch::append(ss, tmp);
+}
+
+bool append_digit_pairs(snitch::small_string_span ss, snitch::large_uint_t i) noexcept {
+    return snitch::impl::append_constexpr(ss, i);
+}
+
+bool append_runtime(snitch::small_string_span ss, snitch::large_uint_t i) noexcept {
+    // std::to_chars if SNITCH_APPEND_TO_CHARS is enabled, the digit pairs otherwise.
+    return snitch::impl::append_fast(ss, i);
+}
+
+bool append_to_chars(snitch::small_string_span ss, snitch::large_uint_t i) noexcept {
+    auto [end, err] = std::to_chars(ss.end(), ss.begin() + ss.capacity(), i);
+    if (err != std::errc{}) {
+        return false;
+    }
+
+    ss.grow(static_cast<std::size_t>(end - ss.end()));
+    return true;
+}
+
+using formatter = bool (*)(snitch::small_string_span, snitch::large_uint_t) noexcept;
+
+double measure(formatter format, const std::vector<snitch::large_uint_t>& inputs) {
+    double      best_time   = std::numeric_limits<double>::max();
+    std::size_t total_chars = 0u;
+
+    for (std::size_t r = 0; r < repetitions; ++r) {
+        snitch::small_string<4096> buffer;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto i : inputs) {
+            if (buffer.available() < snitch::impl::max_uint_length) {
+                total_chars += buffer.size();
+                buffer.clear();
+            }
+
+            static_cast<void>(format(buffer, i));
+        }
+        total_chars += buffer.size();
+        const auto end = std::chrono::steady_clock::now();
+
+        const double time = std::chrono::duration<double, std::nano>(end - start).count();
+        best_time         = time < best_time ? time : best_time;
+    }
+
+    // Make sure the output is used, so the formatting is not optimized away.
+    volatile std::size_t sink = total_chars;
+    static_cast<void>(sink);
+
+    return best_time / static_cast<double>(inputs.size());
+}
+
+void run(const char* name, const std::vector<snitch::large_uint_t>& inputs) {
+    std::printf(
+        "%-22s one digit/step: %6.2f ns, digit pairs: %6.2f ns, append_fast: %6.2f ns, "
+        "to_chars: %6.2f ns\n",
+        name, measure(&append_one_digit_per_step, inputs), measure(&append_digit_pairs, inputs),
+        measure(&append_runtime, inputs), measure(&append_to_chars, inputs));
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t iterations =
+        argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000u;
+
+    // Deterministic pseudo-random inputs (xorshift64).
+    std::uint64_t state = 88172645463325252ull;
+    const auto    next  = [&]() {
+        state ^= state << 13u;
+        state ^= state >> 7u;
+        state ^= state << 17u;
+        return state;
+    };
+
+    std::vector<snitch::large_uint_t> small_inputs;
+    std::vector<snitch::large_uint_t> mixed_inputs;
+    std::vector<snitch::large_uint_t> large_inputs;
+    small_inputs.reserve(iterations);
+    mixed_inputs.reserve(iterations);
+    large_inputs.reserve(iterations);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        // Typical of test output: counts, line numbers, sizes.
+        small_inputs.push_back(next() % 1000u);
+        // Uniform number of digits.
+        mixed_inputs.push_back(next() >> (next() % 64u));
+        large_inputs.push_back(next());
+    }
+
+    std::printf("%zu integers, best of %zu runs, time per integer:\n", iterations, repetitions);
+    run("small (< 1000):", small_inputs);
+    run("mixed lengths:", mixed_inputs);
+    run("large (64 bits):", large_inputs);
+
+    return 0;
+}
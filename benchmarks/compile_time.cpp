@@ -0,0 +1,195 @@
+// Measures the compile-time cost of the test macros, and the size of the code they generate.
+//
+// Usage: snitch-benchmark-compile_time [uses] [repetitions]
+//
+// For each macro, a test file with 'uses' uses of the macro (1000 by default) is generated, and
+// compiled with the same compiler and flags as this benchmark, including either the library
+// headers ('snitch/snitch.hpp') or the single header-only 'snitch_all.hpp'. The best compile time
+// out of 'repetitions' (3 by default) is reported, with the size of the object file. The cost per
+// use excludes that of a file which only includes the header.
+
+#include "compile_time_config.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace {
+constexpr std::size_t uses_per_test_case = 10u;
+
+struct macro_kind {
+    std::string_view name;
+    // Used to name the generated files.
+    std::string_view id;
+    // Code at the start of the file, after the header.
+    std::string_view preamble;
+    // Writes one use of the macro, numbered 'i'.
+    void (*write_use)(std::ofstream& out, std::size_t i);
+    // True if each use is a test case of its own; otherwise, uses are grouped in test cases.
+    bool is_test_case = false;
+};
+
+const macro_kind kinds[] = {
+    {"include only", "include", "", nullptr},
+    {"CHECK", "check", "",
+     [](std::ofstream& out, std::size_t i) { out << "    CHECK(value < " << i + 1u << ");\n"; }},
+    {"REQUIRE_THAT", "require_that", "",
+     [](std::ofstream& out, std::size_t i) {
+         out << "    REQUIRE_THAT(text, snitch::matchers::contains_substring{\"" << i << "\"});\n";
+     }},
+    {"CONSTEXPR_CHECK", "constexpr_check", "constexpr int twice(int i) {\n    return 2 * i;\n}\n",
+     [](std::ofstream& out, std::size_t i) {
+         out << "    CONSTEXPR_CHECK(twice(" << i << ") == " << 2u * i << ");\n";
+     }},
+    {"TEMPLATE_TEST_CASE", "template_test_case", "",
+     [](std::ofstream& out, std::size_t i) {
+         out << "TEMPLATE_TEST_CASE(\"template " << i << "\", \"[template]\", int, float) {\n"
+             << "    CHECK(TestType{} == 0);\n}\n\n";
+     },
+     true}};
+
+struct header_mode {
+    std::string_view name;
+    std::string_view id;
+    std::string_view include;
+};
+
+const header_mode modes[] = {
+    {"library", "library", "#include \"snitch/snitch.hpp\"\n"},
+    {"header-only", "header_only", "#include \"snitch_all.hpp\"\n"}};
+
+void write_test_file(
+    const std::filesystem::path& path,
+    const header_mode&           mode,
+    const macro_kind&            kind,
+    std::size_t                  uses) {
+
+    std::ofstream out(path);
+    out << mode.include << "\n" << kind.preamble << "\n";
+
+    if (kind.write_use == nullptr) {
+        return;
+    }
+
+    if (kind.is_test_case) {
+        for (std::size_t i = 0; i < uses; ++i) {
+            kind.write_use(out, i);
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < uses; ++i) {
+        if (i % uses_per_test_case == 0u) {
+            if (i != 0u) {
+                out << "}\n\n";
+            }
+
+            out << "TEST_CASE(\"test " << i / uses_per_test_case << "\", \"[test]\") {\n"
+                << "    int              value = 0;\n"
+                << "    std::string_view text  = \"0123456789\";\n";
+        }
+
+        kind.write_use(out, i);
+    }
+
+    out << "}\n";
+}
+
+struct result {
+    double         seconds     = std::numeric_limits<double>::max();
+    std::uintmax_t object_size = 0u;
+};
+
+bool compile(
+    const std::filesystem::path& source,
+    const std::filesystem::path& object,
+    std::size_t                  repetitions,
+    result&                      r) {
+
+    const std::string command = std::string(snitch_benchmark::compile_command) + " \"" +
+                                source.string() + "\" " +
+                                std::string(snitch_benchmark::output_option) + "\"" +
+                                object.string() + "\"";
+
+    for (std::size_t i = 0; i < repetitions; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        if (std::system(command.c_str()) != 0) {
+            std::printf("error: could not compile '%s'\n", source.string().c_str());
+            return false;
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        r.seconds            = seconds < r.seconds ? seconds : r.seconds;
+    }
+
+    r.object_size = std::filesystem::file_size(object);
+    return true;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t uses =
+        argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000u;
+    const std::size_t repetitions =
+        argc > 2 ? static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10)) : 3u;
+
+    if (uses == 0u || repetitions == 0u) {
+        std::printf("usage: %s [uses] [repetitions]\n", argv[0]);
+        return 1;
+    }
+
+    const std::filesystem::path directory = snitch_benchmark::work_directory;
+    std::filesystem::create_directories(directory);
+
+    std::printf("%zu uses per file, best of %zu compilations:\n", uses, repetitions);
+    std::printf(
+        "%-12s %-20s %10s %14s %14s %12s\n", "header", "macro", "time (s)", "object (B)",
+        "time/use (us)", "object/use (B)");
+
+    bool success = true;
+    for (const auto& mode : modes) {
+        result baseline;
+        for (const auto& kind : kinds) {
+            const std::string name = std::string(mode.id) + "_" + std::string(kind.id);
+            const std::filesystem::path source = directory / (name + ".cpp");
+            const std::filesystem::path object =
+                directory / (name + std::string(snitch_benchmark::object_extension));
+
+            write_test_file(source, mode, kind, uses);
+
+            result r;
+            if (!compile(source, object, repetitions, r)) {
+                success = false;
+                continue;
+            }
+
+            if (kind.write_use == nullptr) {
+                baseline = r;
+                std::printf(
+                    "%-12s %-20s %10.3f %14ju\n", std::string(mode.name).c_str(),
+                    std::string(kind.name).c_str(), r.seconds, r.object_size);
+                continue;
+            }
+
+            const double time_per_use =
+                (r.seconds - baseline.seconds) * 1e6 / static_cast<double>(uses);
+            const double size_per_use =
+                (static_cast<double>(r.object_size) - static_cast<double>(baseline.object_size)) /
+                static_cast<double>(uses);
+
+            std::printf(
+                "%-12s %-20s %10.3f %14ju %14.1f %12.1f\n", std::string(mode.name).c_str(),
+                std::string(kind.name).c_str(), r.seconds, r.object_size, time_per_use,
+                size_per_use);
+        }
+    }
+
+    return success ? 0 : 1;
+}
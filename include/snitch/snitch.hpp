@@ -1,40 +1,55 @@
 #ifndef SNITCH_HPP
 #define SNITCH_HPP
 
+#include "snitch/snitch_allocations.hpp"
 #include "snitch/snitch_any.hpp"
 #include "snitch/snitch_append.hpp"
+#include "snitch/snitch_cache.hpp"
 #include "snitch/snitch_capture.hpp"
 #include "snitch/snitch_cli.hpp"
+#include "snitch/snitch_compression.hpp"
 #include "snitch/snitch_concepts.hpp"
 #include "snitch/snitch_config.hpp"
 #include "snitch/snitch_console.hpp"
+#include "snitch/snitch_durations.hpp"
 #include "snitch/snitch_error_handling.hpp"
 #include "snitch/snitch_expression.hpp"
 #include "snitch/snitch_file.hpp"
 #include "snitch/snitch_fixed_point.hpp"
 #include "snitch/snitch_function.hpp"
+#include "snitch/snitch_macros_allocations.hpp"
 #include "snitch/snitch_macros_check.hpp"
 #include "snitch/snitch_macros_check_base.hpp"
 #include "snitch/snitch_macros_consteval.hpp"
 #include "snitch/snitch_macros_constexpr.hpp"
 #include "snitch/snitch_macros_exceptions.hpp"
 #include "snitch/snitch_macros_misc.hpp"
+#include "snitch/snitch_macros_property.hpp"
 #include "snitch/snitch_macros_reporter.hpp"
 #include "snitch/snitch_macros_test_case.hpp"
 #include "snitch/snitch_macros_utility.hpp"
 #include "snitch/snitch_macros_warnings.hpp"
 #include "snitch/snitch_main.hpp"
 #include "snitch/snitch_matcher.hpp"
+#include "snitch/snitch_perf_counters.hpp"
+#include "snitch/snitch_profiler.hpp"
+#include "snitch/snitch_property.hpp"
 #include "snitch/snitch_registry.hpp"
+#include "snitch/snitch_reporter_binary.hpp"
 #include "snitch/snitch_reporter_catch2_xml.hpp"
+#include "snitch/snitch_reporter_chrome_trace.hpp"
 #include "snitch/snitch_reporter_console.hpp"
+#include "snitch/snitch_reporter_junit.hpp"
 #include "snitch/snitch_reporter_teamcity.hpp"
+#include "snitch/snitch_rng.hpp"
 #include "snitch/snitch_section.hpp"
+#include "snitch/snitch_startup_stats.hpp"
 #include "snitch/snitch_string.hpp"
 #include "snitch/snitch_string_utility.hpp"
 #include "snitch/snitch_test_data.hpp"
 #include "snitch/snitch_type_id.hpp"
 #include "snitch/snitch_type_name.hpp"
 #include "snitch/snitch_vector.hpp"
+#include "snitch/snitch_watchdog.hpp"
 
 #endif
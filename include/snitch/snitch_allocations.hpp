@@ -0,0 +1,73 @@
+#ifndef SNITCH_ALLOCATIONS_HPP
+#define SNITCH_ALLOCATIONS_HPP
+
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_test_data.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+
+namespace snitch::impl {
+struct allocation_counters {
+    // Number of allocations made by this thread.
+    std::size_t count = 0;
+    // Total number of bytes allocated by this thread.
+    std::size_t bytes = 0;
+    // Number of bytes currently allocated by this thread (and not freed by this thread).
+    std::size_t current = 0;
+    // Maximum value reached by 'current'.
+    std::size_t peak = 0;
+};
+
+// Counters of the calling thread, updated by the global operator new and delete.
+SNITCH_EXPORT allocation_counters& get_allocation_counters() noexcept;
+
+// Measures the allocations made by the calling thread from construction until stop().
+// Scopes can be nested.
+class allocation_scope {
+    allocation_counters start;
+
+public:
+    SNITCH_EXPORT allocation_scope() noexcept;
+
+    allocation_scope(const allocation_scope&)            = delete;
+    allocation_scope& operator=(const allocation_scope&) = delete;
+
+    SNITCH_EXPORT ~allocation_scope() noexcept;
+
+    SNITCH_EXPORT allocation_stats stop() const noexcept;
+};
+
+// Implementation of REQUIRE_NO_ALLOCATIONS and CHECK_NO_ALLOCATIONS.
+class no_allocation_checker {
+    source_location  location;
+    allocation_scope scope;
+#    if SNITCH_WITH_EXCEPTIONS
+    int exceptions_at_start = 0;
+#    endif
+
+public:
+    bool done = false;
+
+    SNITCH_EXPORT explicit no_allocation_checker(const source_location& loc) noexcept;
+
+    // Reports the assertion if the block was left before it completed.
+    SNITCH_EXPORT ~no_allocation_checker() noexcept;
+
+    // Report the assertion; returns false if any allocation was made.
+    SNITCH_EXPORT bool report() const noexcept;
+};
+
+// Call 'func(name, value)' for each allocation statistic.
+template<typename F>
+void for_each_allocation_stat(const allocation_stats& stats, F&& func) noexcept {
+    func(std::string_view{"allocations"}, stats.count);
+    func(std::string_view{"allocated_bytes"}, stats.bytes);
+    func(std::string_view{"peak_allocated_bytes"}, stats.peak);
+}
+} // namespace snitch::impl
+
+#endif
+#endif
@@ -6,6 +6,8 @@
 #include "snitch/snitch_fixed_point.hpp"
 #include "snitch/snitch_string.hpp"
 
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <limits>
 #include <string_view>
@@ -31,6 +33,8 @@ SNITCH_EXPORT [[nodiscard]] bool append_fast(small_string_span ss, large_uint_t
 SNITCH_EXPORT [[nodiscard]] bool append_fast(small_string_span ss, large_int_t i) noexcept;
 SNITCH_EXPORT [[nodiscard]] bool append_fast(small_string_span ss, float f) noexcept;
 SNITCH_EXPORT [[nodiscard]] bool append_fast(small_string_span ss, double f) noexcept;
+SNITCH_EXPORT [[nodiscard]] bool append_fast_shortest(small_string_span ss, float f) noexcept;
+SNITCH_EXPORT [[nodiscard]] bool append_fast_shortest(small_string_span ss, double f) noexcept;
 
 [[nodiscard]] constexpr bool append_constexpr(small_string_span ss, std::string_view str) noexcept {
     const bool        could_fit  = str.size() <= ss.available();
@@ -45,25 +49,108 @@ SNITCH_EXPORT [[nodiscard]] bool append_fast(small_string_span ss, double f) noe
     return could_fit;
 }
 
+constexpr std::array<char, 16> digits = {'0', '1', '2', '3', '4', '5', '6', '7',
+                                         '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+// Decimal digits of all numbers from 00 to 99, to write integers two digits at a time.
+constexpr std::array<char, 200> digit_pairs = [] {
+    std::array<char, 200> pairs = {};
+    for (std::size_t i = 0; i < 100u; ++i) {
+        pairs[2u * i]      = digits[i / 10u];
+        pairs[2u * i + 1u] = digits[i % 10u];
+    }
+    return pairs;
+}();
+
+// All powers of ten that fit in large_uint_t, from 10^0.
+constexpr std::array<large_uint_t, std::numeric_limits<large_uint_t>::digits10 + 1> powers_of_ten =
+    [] {
+        std::array<large_uint_t, std::numeric_limits<large_uint_t>::digits10 + 1> powers = {};
+        large_uint_t                                                              power  = 1u;
+        for (auto& p : powers) {
+            p = power;
+            power *= 10u;
+        }
+        return powers;
+    }();
+
+[[nodiscard]] constexpr std::size_t num_decimal_digits(large_uint_t x) noexcept {
+    // Estimate the number of digits from the number of significant bits (1233/4096 is just above
+    // log10(2)), which is either exact or one too low; then correct it with the next power of
+    // ten. Setting the lowest bit does not change the result, but ensures zero has one digit.
+    x |= 1u;
+    const std::size_t estimate = (static_cast<std::size_t>(std::bit_width(x)) * 1233u) >> 12u;
+    return estimate + (x >= powers_of_ten[estimate] ? 1u : 0u);
+}
+
 template<large_uint_t Base = 10u, unsigned_integral T>
 [[nodiscard]] constexpr std::size_t num_digits(T x) noexcept {
-    return x >= Base ? 1u + num_digits<Base>(x / Base) : 1u;
+    if constexpr (Base == 10u) {
+        return num_decimal_digits(static_cast<large_uint_t>(x));
+    } else {
+        return x >= Base ? 1u + num_digits<Base>(x / Base) : 1u;
+    }
+}
+
+// Absolute value of a signed integer, without overflow for the smallest value.
+template<signed_integral T>
+[[nodiscard]] constexpr large_uint_t unsigned_magnitude(T x) noexcept {
+    return x < 0 ? large_uint_t{0u} - static_cast<large_uint_t>(x) : static_cast<large_uint_t>(x);
 }
 
+// Includes the minus sign for negative values.
 template<large_int_t Base = 10, signed_integral T>
 [[nodiscard]] constexpr std::size_t num_digits(T x) noexcept {
-    return (x >= Base || x <= -Base) ? 1u + num_digits<Base>(x / Base) : x > 0 ? 1u : 2u;
+    return num_digits<static_cast<large_uint_t>(Base)>(unsigned_magnitude(x)) + (x < 0 ? 1u : 0u);
 }
 
-constexpr std::array<char, 16> digits = {'0', '1', '2', '3', '4', '5', '6', '7',
-                                         '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
-
 constexpr std::size_t max_uint_length = num_digits(std::numeric_limits<large_uint_t>::max());
 constexpr std::size_t max_int_length  = max_uint_length + 1;
 
+// Write the decimal digits of 'x' backwards, ending just before position 'end' in 'ss'.
+constexpr void write_decimal_digits(small_string_span ss, std::size_t end, large_uint_t x) noexcept {
+    while (x >= 100u) {
+        const std::size_t pair = 2u * static_cast<std::size_t>(x % 100u);
+        x /= 100u;
+        ss[--end] = digit_pairs[pair + 1u];
+        ss[--end] = digit_pairs[pair];
+    }
+
+    if (x >= 10u) {
+        const std::size_t pair = 2u * static_cast<std::size_t>(x);
+        ss[--end]              = digit_pairs[pair + 1u];
+        ss[--end]              = digit_pairs[pair];
+    } else {
+        ss[--end] = digits[static_cast<std::size_t>(x)];
+    }
+}
+
+// Append the decimal digits of 'magnitude', preceded by a minus sign if 'negative'.
+[[nodiscard]] constexpr bool
+append_decimal(small_string_span ss, large_uint_t magnitude, bool negative) noexcept {
+    const std::size_t length = num_decimal_digits(magnitude) + (negative ? 1u : 0u);
+    if (length > ss.available()) {
+        // Does not fit; format in a temporary string, and append what fits.
+        small_string<max_int_length> tmp;
+        static_cast<void>(append_decimal(tmp, magnitude, negative));
+        return append_constexpr(ss, tmp);
+    }
+
+    const std::size_t offset = ss.size();
+    ss.grow(length);
+    if (negative) {
+        ss[offset] = '-';
+    }
+
+    write_decimal_digits(ss, offset + length, magnitude);
+    return true;
+}
+
 template<large_uint_t Base = 10u, unsigned_integral T>
 [[nodiscard]] constexpr bool append_constexpr(small_string_span ss, T i) noexcept {
-    if (i != 0u) {
+    if constexpr (Base == 10u) {
+        return append_decimal(ss, static_cast<large_uint_t>(i), false);
+    } else if (i != 0u) {
         small_string<max_uint_length> tmp;
         tmp.resize(num_digits<Base>(i));
         std::size_t k = 1;
@@ -78,7 +165,9 @@ template<large_uint_t Base = 10u, unsigned_integral T>
 
 template<large_int_t Base = 10, signed_integral T>
 [[nodiscard]] constexpr bool append_constexpr(small_string_span ss, T i) noexcept {
-    if (i > 0) {
+    if constexpr (Base == 10) {
+        return append_decimal(ss, unsigned_magnitude(i), i < 0);
+    } else if (i > 0) {
         small_string<max_int_length> tmp;
         tmp.resize(num_digits<Base>(i));
         std::size_t k = 1;
@@ -173,8 +262,9 @@ set_precision(signed_fixed_data fd, std::size_t p) noexcept {
     // Resize to fit the digits (without exponent part).
     // +1 for fractional separator '.'
     // +1 for sign
+    // The separator is omitted if there is a single digit, as with std::printf.
     const std::size_t stored_digits = num_digits<10>(static_cast<large_uint_t>(fd.digits));
-    tmp.resize(stored_digits + 1u + (fd.sign ? 1u : 0u));
+    tmp.resize(stored_digits + (stored_digits > 1u ? 1u : 0u) + (fd.sign ? 1u : 0u));
 
     // The exponent has a fixed size, so we can start by writing the main digits.
     // We write the digits with always a single digit before the decimal separator,
@@ -182,7 +272,7 @@ set_precision(signed_fixed_data fd, std::size_t p) noexcept {
     // the exponent later.
     std::size_t k = 1u;
     for (fixed_digits_t j = fd.digits; j != 0u; j /= 10u, ++k) {
-        if (j < 10u) {
+        if (j < 10u && stored_digits > 1u) {
             tmp[tmp.size() - k] = '.';
             ++k;
         }
@@ -266,6 +356,30 @@ template<floating_point T>
     }
 }
 
+// Append the shortest representation that reads back to the same value (e.g., 0.1f is printed as
+// "1e-01" rather than "1.000000e-01"), in the same format as std::to_chars in scientific mode.
+template<floating_point T>
+[[nodiscard]] constexpr bool append_constexpr_shortest(small_string_span ss, T f) noexcept {
+    if constexpr (std::numeric_limits<T>::is_iec559) {
+        using traits = float_traits<T>;
+
+        const float_bits<T> bits = to_bits(f);
+
+        if (bits.exponent == traits::exp_bits_special) {
+            // Infinity or NaN; same as with a fixed precision.
+            return append_constexpr(ss, f);
+        } else if (bits.exponent == 0x0 && bits.significand == 0x0) {
+            // Zero.
+            return append_constexpr(ss, bits.sign ? "-0e+00" : "0e+00");
+        } else {
+            return append_constexpr(ss, to_shortest_fixed(bits));
+        }
+    } else {
+        constexpr std::string_view unknown_str = "?";
+        return append_constexpr(ss, unknown_str);
+    }
+}
+
 [[nodiscard]] constexpr bool append_constexpr(small_string_span ss, const void* p) noexcept {
     if (p == nullptr) {
         constexpr std::string_view nullptr_str = "nullptr";
@@ -315,19 +429,35 @@ namespace snitch {
 }
 
 [[nodiscard]] constexpr bool append(small_string_span ss, float f) noexcept {
+#if SNITCH_SHORTEST_FLOAT_FORMAT
+    if (std::is_constant_evaluated()) {
+        return impl::append_constexpr_shortest(ss, f);
+    } else {
+        return impl::append_fast_shortest(ss, f);
+    }
+#else
     if (std::is_constant_evaluated()) {
         return impl::append_constexpr(ss, f);
     } else {
         return impl::append_fast(ss, f);
     }
+#endif
 }
 
 [[nodiscard]] constexpr bool append(small_string_span ss, double f) noexcept {
+#if SNITCH_SHORTEST_FLOAT_FORMAT
+    if (std::is_constant_evaluated()) {
+        return impl::append_constexpr_shortest(ss, f);
+    } else {
+        return impl::append_fast_shortest(ss, f);
+    }
+#else
     if (std::is_constant_evaluated()) {
         return impl::append_constexpr(ss, f);
     } else {
         return impl::append_fast(ss, f);
     }
+#endif
 }
 
 [[nodiscard]] constexpr bool append(small_string_span ss, bool value) noexcept {
@@ -0,0 +1,71 @@
+#ifndef SNITCH_CACHE_HPP
+#define SNITCH_CACHE_HPP
+
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_file.hpp"
+#include "snitch/snitch_string.hpp"
+#include "snitch/snitch_test_data.hpp"
+#include "snitch/snitch_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace snitch::impl {
+// Maximum number of results stored in the cache; one per test case.
+constexpr std::size_t max_cached_results = SNITCH_MAX_TEST_CASES;
+
+enum class cached_result : std::uint8_t { unknown, passed, failed };
+
+// Which tests to skip when a result cache is used (see '--cache').
+enum class cache_mode {
+    // Run all selected tests, and only record their results.
+    record,
+    // Skip the tests that passed in a previous run.
+    skip_passes,
+    // Only run the tests that failed in a previous run; if none failed, same as 'skip_passes'.
+    only_failed
+};
+
+// Results of the test cases from previous runs of the same build, stored in a file.
+// Only a hash of the full name of each test case is kept in memory, so the memory usage does not
+// depend on the length of the test names.
+class result_cache {
+    struct entry {
+        std::uint64_t hash   = 0u;
+        cached_result result = cached_result::unknown;
+    };
+
+    small_string<max_path_length> path;
+    std::uint64_t                 fingerprint = 0u;
+
+    // Sorted by hash.
+    small_vector<entry, max_cached_results> entries;
+
+public:
+    cache_mode mode = cache_mode::record;
+
+    // Locate the cache file of the test application 'executable' in the folder 'dir', and load
+    // the results it contains, if they were recorded with the same build fingerprint. Other
+    // results are discarded. Returns false if the path of the cache file is too long.
+    SNITCH_EXPORT bool
+    open(std::string_view dir, std::string_view executable, std::uint64_t build) noexcept;
+
+    // Returns the result of a test case in the previous runs, if any.
+    SNITCH_EXPORT cached_result find(const test_id& id) const noexcept;
+
+    // Write the results of the test cases that were run, and keep the previous results of the
+    // others. Returns false if the cache file could not be written.
+    SNITCH_EXPORT bool save(small_vector_span<const test_case> tests) const noexcept;
+};
+
+// Hash of a string, used for build fingerprints and test names.
+SNITCH_EXPORT std::uint64_t hash_string(std::string_view value) noexcept;
+
+// Hash of the content of a file, used as a build fingerprint.
+// Returns an empty optional if the file could not be read.
+SNITCH_EXPORT std::optional<std::uint64_t> hash_file(std::string_view path) noexcept;
+} // namespace snitch::impl
+
+#endif
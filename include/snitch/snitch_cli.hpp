@@ -27,8 +27,9 @@ struct argument {
 };
 
 struct input {
-    std::string_view                              executable = {};
-    small_vector<argument, max_command_line_args> arguments  = {};
+    std::string_view                              executable      = {};
+    small_vector<argument, max_command_line_args> arguments       = {};
+    std::string_view                              executable_path = {};
 };
 
 SNITCH_EXPORT extern function_ref<void(std::string_view) noexcept> console_print;
@@ -53,6 +54,12 @@ SNITCH_EXPORT std::optional<input> parse_arguments(int argc, const char* const a
 SNITCH_EXPORT std::optional<cli::argument>
               get_option(const cli::input& args, std::string_view name) noexcept;
 
+// Call 'callback' with the value of each occurrence of a repeatable option.
+SNITCH_EXPORT void for_each_option(
+    const cli::input&                                    args,
+    std::string_view                                     name,
+    const function_ref<void(std::string_view) noexcept>& callback) noexcept;
+
 SNITCH_EXPORT std::optional<cli::argument>
               get_positional_argument(const cli::input& args, std::string_view name) noexcept;
 
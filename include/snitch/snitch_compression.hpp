@@ -0,0 +1,45 @@
+#ifndef SNITCH_COMPRESSION_HPP
+#define SNITCH_COMPRESSION_HPP
+
+#include "snitch/snitch_config.hpp"
+
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+
+#    include "snitch/snitch_function.hpp"
+
+#    include <cstddef>
+#    include <string_view>
+
+namespace snitch {
+// Maximum number of compressed output files written at the same time.
+constexpr std::size_t max_compressed_outputs = SNITCH_MAX_COMPRESSED_OUTPUTS;
+} // namespace snitch
+
+namespace snitch::impl {
+// Size of the blocks of output compressed independently.
+constexpr std::size_t compression_block_size = 64u * 1024u;
+
+struct compressed_stream;
+
+// Check if output written to this path should be compressed (paths ending in ".z").
+SNITCH_EXPORT bool is_compressed_path(std::string_view path) noexcept;
+
+// Start compressing output to an open file (a 'std::FILE*'), which must remain open until the
+// stream is closed.
+// Requires: number of open compressed streams + 1 <= max_compressed_outputs.
+SNITCH_EXPORT compressed_stream* open_compressed_stream(void* file_handle);
+
+// Buffer output; full blocks are compressed and written to the file in the background.
+SNITCH_EXPORT void write(compressed_stream& stream, std::string_view message) noexcept;
+
+// Compress and write the remaining output, and terminate the compressed data.
+SNITCH_EXPORT void close(compressed_stream& stream) noexcept;
+
+// Decompress data written by a compressed stream, calling 'output' for each decompressed block.
+// Returns false if the data is malformed or uses LZ4 frame features not produced by snitch.
+SNITCH_EXPORT bool decompress(
+    std::string_view data, const function_ref<void(std::string_view) noexcept>& output) noexcept;
+} // namespace snitch::impl
+
+#endif
+#endif
@@ -1,14 +1,45 @@
 #ifndef SNITCH_CONSOLE_HPP
 #define SNITCH_CONSOLE_HPP
 
+#include "snitch/snitch_config.hpp"
 #include "snitch/snitch_string.hpp"
 #include "snitch/snitch_string_utility.hpp"
 
+#include <cstddef>
 #include <string_view>
 
+namespace snitch {
+// Maximum number of characters buffered before writing to the standard output.
+constexpr std::size_t max_stdout_buffer_length = SNITCH_MAX_STDOUT_BUFFER_LENGTH;
+} // namespace snitch
+
 namespace snitch::impl {
+// When output buffered for the standard output is written out (see '--flush').
+enum class stdout_flush_policy {
+    // After each complete line (default if the standard output is a terminal).
+    line,
+    // After each test case (default otherwise).
+    test_case,
+    // At the end of the test run, or when the buffer is full.
+    exit
+};
+
+// Buffer output for the standard output, and write it out according to the flush policy.
+// With multithreading, output is only added to the shared buffer one complete line at a time, so
+// lines printed concurrently by different threads never interleave.
 SNITCH_EXPORT void stdout_print(std::string_view message) noexcept;
 
+// Write out all buffered output.
+SNITCH_EXPORT void stdout_flush() noexcept;
+
+SNITCH_EXPORT stdout_flush_policy get_stdout_flush_policy() noexcept;
+
+SNITCH_EXPORT void set_stdout_flush_policy(stdout_flush_policy policy) noexcept;
+
+// Write out all buffered output, then stop translating line endings in the standard output, for
+// binary data. Only does something on Windows, where the standard output is opened in text mode.
+SNITCH_EXPORT void set_stdout_binary_mode() noexcept;
+
 using color_t = std::string_view;
 
 namespace color {
@@ -0,0 +1,77 @@
+#ifndef SNITCH_DURATIONS_HPP
+#define SNITCH_DURATIONS_HPP
+
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_profiler.hpp"
+#include "snitch/snitch_string.hpp"
+#include "snitch/snitch_test_data.hpp"
+#include "snitch/snitch_time.hpp"
+#include "snitch/snitch_vector.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#if SNITCH_WITH_TIMINGS
+
+namespace snitch {
+// Maximum number of slowest test cases and sections listed with --durations.
+constexpr std::size_t max_slowest_entries = SNITCH_MAX_SLOWEST_ENTRIES;
+} // namespace snitch
+
+namespace snitch::impl {
+struct timed_entry {
+    // Full test case name, followed by the section names (if any), separated by " / ".
+    small_string<max_message_length> name = {};
+    // Time spent in the test case or section, in nanoseconds.
+    time_point_t duration = 0;
+};
+
+// Keeps track of the slowest test cases and sections of a run.
+// Entries are kept in a bounded min-heap, so memory usage does not grow with the number of tests.
+// Sections are accumulated while their test case runs, and recorded once when it ends.
+class duration_tracker {
+    small_vector<timed_entry, max_slowest_entries> slowest;
+    // Sections of the test case currently running; the name only contains the section names.
+    small_vector<timed_entry, max_profile_entries> sections;
+    std::optional<time_point_t>                    last_test_case;
+
+public:
+    // Test cases and sections faster than this are ignored, in nanoseconds.
+    time_point_t min_duration = 0;
+
+    // Record the duration of a test case (if 'sections' is empty) or of its innermost section.
+    // Returns false if the duration is below the threshold.
+    SNITCH_EXPORT bool
+    add(std::string_view test_name, section_info sections, time_point_t duration) noexcept;
+
+    // Record one exit from the innermost section in the provided stack, for the test case
+    // currently running. The time spent in a section is summed over all its exits.
+    // Sections beyond 'max_profile_entries' per test case are ignored.
+    SNITCH_EXPORT void section_exited(section_info sections, time_point_t duration) noexcept;
+
+    // Record the duration of the test case that just ended, and of its sections.
+    SNITCH_EXPORT void test_case_ended(std::string_view test_name, time_point_t duration) noexcept;
+
+    // Duration of the last test case that ended, if it was not below the threshold.
+    SNITCH_EXPORT std::optional<time_point_t> get_last_test_case() const noexcept;
+
+    // Sort the recorded entries from the slowest to the fastest, and return them.
+    // No further entry can be added until the tracker is cleared.
+    SNITCH_EXPORT small_vector_span<const timed_entry> sort() noexcept;
+
+    // Return the recorded entries; they are only ordered after 'sort()' was called.
+    SNITCH_EXPORT small_vector_span<const timed_entry> get_slowest() const noexcept;
+
+    SNITCH_EXPORT void clear() noexcept;
+};
+
+// Parse a positive number of seconds (e.g., "1", "0.25"), returned in nanoseconds.
+SNITCH_EXPORT std::optional<time_point_t> parse_seconds(std::string_view value) noexcept;
+
+// Append a duration given in nanoseconds as seconds with millisecond resolution (e.g., "0.250").
+SNITCH_EXPORT bool append_seconds(small_string_span ss, time_point_t duration) noexcept;
+} // namespace snitch::impl
+
+#endif
+#endif
@@ -1,8 +1,11 @@
 #ifndef SNITCH_FILE_HPP
 #define SNITCH_FILE_HPP
 
+#include "snitch/snitch_compression.hpp"
 #include "snitch/snitch_config.hpp"
 
+#include <cstddef>
+#include <optional>
 #include <string_view>
 
 namespace snitch::impl {
@@ -12,6 +15,26 @@ constexpr std::size_t max_path_length = SNITCH_MAX_PATH_LENGTH;
 class file_writer {
     void* file_handle = nullptr;
 
+#if SNITCH_WITH_MMAP_OUTPUT
+    // When the output is a regular file, it is written through a memory mapping of the file,
+    // which grows as needed; 'file_handle' is then unused. The file is truncated to the written
+    // size when closed, or if the application terminates or crashes before then.
+    int         file_descriptor = -1;
+    char*       mapping         = nullptr;
+    std::size_t mapping_size    = 0;
+    std::size_t written_size    = 0;
+    // Index of the file in the table of mapped files, which tracks the written size.
+    std::size_t mapped_slot = static_cast<std::size_t>(-1);
+
+    bool grow_mapping(std::size_t required_size) noexcept;
+    void close_mapping() noexcept;
+#endif
+
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    // When the path ends in ".z", the output is compressed before being written to 'file_handle'.
+    compressed_stream* compressor = nullptr;
+#endif
+
 public:
     SNITCH_EXPORT constexpr file_writer() noexcept = default;
 
@@ -28,6 +51,14 @@ public:
     SNITCH_EXPORT ~file_writer();
 
     SNITCH_EXPORT void write(std::string_view message) noexcept;
+
+    // Returns the current write position, or nothing if the file is not seekable (e.g., a pipe) or
+    // is compressed.
+    SNITCH_EXPORT std::optional<std::size_t> tell() const noexcept;
+
+    // Overwrite previously written content at the given position, then resume writing at the end.
+    // Requires: position and message within the content already written.
+    SNITCH_EXPORT void write_at(std::size_t position, std::string_view message) const noexcept;
 };
 } // namespace snitch::impl
 
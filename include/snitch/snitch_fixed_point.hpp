@@ -3,12 +3,10 @@
 
 #include "snitch/snitch_config.hpp"
 
+#include <array>
+#include <bit> // for std::bit_cast, std::bit_width
 #include <cstddef>
 #include <cstdint>
-#if SNITCH_CONSTEXPR_FLOAT_USE_BITCAST
-#    include <bit> // for compile-time float to string
-#endif
-#include <array>
 #include <limits>
 
 namespace snitch::impl {
@@ -390,6 +388,344 @@ template<typename T>
 
     return {.digits = fix.digits(), .exponent = fix.exponent(), .sign = bits.sign};
 }
+
+// Unsigned integer large enough to hold, exactly, all the values involved in finding the shortest
+// decimal representation of a double (up to about 2^1140).
+class big_uint {
+    static constexpr std::size_t max_limbs = 40u;
+
+    // Little-endian base 2^32 digits; limbs above 'size' are zero.
+    std::array<std::uint32_t, max_limbs> limbs = {};
+    std::size_t                          size  = 0u;
+
+    constexpr void trim() noexcept {
+        while (size > 0u && limbs[size - 1u] == 0u) {
+            --size;
+        }
+    }
+
+public:
+    constexpr big_uint() noexcept = default;
+
+    constexpr explicit big_uint(std::uint64_t value) noexcept {
+        limbs[0] = static_cast<std::uint32_t>(value);
+        limbs[1] = static_cast<std::uint32_t>(value >> 32u);
+        size     = limbs[1] != 0u ? 2u : limbs[0] != 0u ? 1u : 0u;
+    }
+
+    constexpr void multiply(std::uint32_t factor) noexcept {
+        std::uint64_t carry = 0u;
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::uint64_t product = static_cast<std::uint64_t>(limbs[i]) * factor + carry;
+            limbs[i]                    = static_cast<std::uint32_t>(product);
+            carry                       = product >> 32u;
+        }
+
+        if (carry != 0u) {
+            limbs[size++] = static_cast<std::uint32_t>(carry);
+        }
+    }
+
+    constexpr void multiply_pow10(std::size_t power) noexcept {
+        if (power < 10u) {
+            constexpr std::array<std::uint32_t, 10> small_powers = {
+                1u,          10u,         100u,         1'000u,       10'000u,
+                100'000u,    1'000'000u,  10'000'000u,  100'000'000u, 1'000'000'000u};
+
+            multiply(small_powers[power]);
+            return;
+        }
+
+        // 10^n = 5^n*2^n; powers of five fit more digits in a limb.
+        constexpr std::uint32_t pow5_13 = 1'220'703'125u;
+        constexpr std::array<std::uint32_t, 13> small_powers = {
+            1u,       5u,         25u,        125u,        625u,         3'125u,      15'625u,
+            78'125u,  390'625u,   1'953'125u, 9'765'625u,  48'828'125u,  244'140'625u};
+
+        std::size_t remaining = power;
+        for (; remaining >= 13u; remaining -= 13u) {
+            multiply(pow5_13);
+        }
+
+        multiply(small_powers[remaining]);
+        shift_left(power);
+    }
+
+    constexpr void shift_left(std::size_t bits) noexcept {
+        if (size == 0u) {
+            return;
+        }
+
+        const std::size_t limb_shift = bits / 32u;
+        const std::size_t bit_shift  = bits % 32u;
+
+        if (bit_shift != 0u) {
+            std::uint32_t carry = 0u;
+            for (std::size_t i = 0; i < size; ++i) {
+                const std::uint32_t limb = limbs[i];
+                limbs[i]                 = (limb << bit_shift) | carry;
+                carry                    = limb >> (32u - bit_shift);
+            }
+
+            if (carry != 0u) {
+                limbs[size++] = carry;
+            }
+        }
+
+        if (limb_shift != 0u) {
+            for (std::size_t i = size; i-- > 0u;) {
+                limbs[i + limb_shift] = limbs[i];
+            }
+
+            for (std::size_t i = 0; i < limb_shift; ++i) {
+                limbs[i] = 0u;
+            }
+
+            size += limb_shift;
+        }
+    }
+
+    constexpr big_uint& operator+=(const big_uint& other) noexcept {
+        const std::size_t new_size = size > other.size ? size : other.size;
+
+        std::uint64_t carry = 0u;
+        for (std::size_t i = 0; i < new_size; ++i) {
+            const std::uint64_t sum = static_cast<std::uint64_t>(limbs[i]) + other.limbs[i] + carry;
+            limbs[i]                = static_cast<std::uint32_t>(sum);
+            carry                   = sum >> 32u;
+        }
+
+        size = new_size;
+        if (carry != 0u) {
+            limbs[size++] = static_cast<std::uint32_t>(carry);
+        }
+
+        return *this;
+    }
+
+    // Requires: other <= *this.
+    constexpr big_uint& operator-=(const big_uint& other) noexcept {
+        std::uint32_t borrow = 0u;
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::uint64_t subtracted = static_cast<std::uint64_t>(other.limbs[i]) + borrow;
+            borrow   = static_cast<std::uint64_t>(limbs[i]) < subtracted ? 1u : 0u;
+            limbs[i] = static_cast<std::uint32_t>(limbs[i] - subtracted);
+        }
+
+        trim();
+        return *this;
+    }
+
+    // Returns a negative number if a < b, zero if a == b, and a positive number if a > b.
+    friend constexpr int compare(const big_uint& a, const big_uint& b) noexcept {
+        if (a.size != b.size) {
+            return a.size < b.size ? -1 : 1;
+        }
+
+        for (std::size_t i = a.size; i-- > 0u;) {
+            if (a.limbs[i] != b.limbs[i]) {
+                return a.limbs[i] < b.limbs[i] ? -1 : 1;
+            }
+        }
+
+        return 0;
+    }
+
+    // Returns a negative number if a + b < c, zero if a + b == c, and a positive number if
+    // a + b > c.
+    friend constexpr int
+    compare_sum(const big_uint& a, const big_uint& b, const big_uint& c) noexcept {
+        const std::size_t size = a.size > b.size ? a.size : b.size;
+        if (size + 1u < c.size) {
+            // The sum has at most one more limb than its largest operand.
+            return -1;
+        }
+
+        int           result = 0;
+        std::uint64_t carry  = 0u;
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::uint64_t sum  = static_cast<std::uint64_t>(a.limbs[i]) + b.limbs[i] + carry;
+            const std::uint32_t limb = static_cast<std::uint32_t>(sum);
+            carry                    = sum >> 32u;
+            if (limb != c.limbs[i]) {
+                result = limb < c.limbs[i] ? -1 : 1;
+            }
+        }
+
+        // Limb of c above the operands, to compare against the carry.
+        const std::uint64_t top = size < c.size ? c.limbs[size] : 0u;
+        if (carry != top) {
+            return carry < top ? -1 : 1;
+        }
+
+        return result;
+    }
+
+    // Number of bits to shift left so the most significant limb has 28 bits (1 to 28 would do);
+    // this is the precondition of divide_digit.
+    [[nodiscard]] constexpr std::size_t normalize_shift() const noexcept {
+        const std::size_t width = static_cast<std::size_t>(std::bit_width(limbs[size - 1u]));
+        return (32u + 28u - width) % 32u;
+    }
+
+    // Divide by 'divisor', keeping the remainder, and return the quotient.
+    // Requires: *this < 10 * divisor, and the most significant limb of the divisor is in
+    // [8, 429496729] (see normalize_shift).
+    constexpr std::uint32_t divide_digit(const big_uint& divisor) noexcept {
+        if (size < divisor.size) {
+            return 0u;
+        }
+
+        // Estimate the quotient from the most significant limbs; this is either exact or one
+        // too low. Since 10 * divisor does not overflow the top limb, *this has no more limbs.
+        const std::size_t top      = divisor.size - 1u;
+        std::uint32_t     quotient = limbs[top] / (divisor.limbs[top] + 1u);
+
+        if (quotient != 0u) {
+            std::uint64_t borrow = 0u;
+            for (std::size_t i = 0; i < divisor.size; ++i) {
+                const std::uint64_t product =
+                    static_cast<std::uint64_t>(divisor.limbs[i]) * quotient + borrow;
+                const std::uint32_t low = static_cast<std::uint32_t>(product);
+                borrow                  = (product >> 32u) + (limbs[i] < low ? 1u : 0u);
+                limbs[i] -= low;
+            }
+
+            trim();
+        }
+
+        if (compare(*this, divisor) >= 0) {
+            *this -= divisor;
+            ++quotient;
+        }
+
+        return quotient;
+    }
+};
+
+// floor(x*log10(2)), for |x| < 1700.
+[[nodiscard]] constexpr std::int32_t floor_log10_pow2(std::int32_t x) noexcept {
+    return (x * 315653) >> 20;
+}
+
+// Find the shortest decimal number that reads back to the same floating point value, when
+// rounding to nearest. If several numbers are equally short, the closest one is returned.
+// This is the "free-format" algorithm of Steele & White, as formulated by Burger & Dybvig
+// ("Printing Floating-Point Numbers Quickly and Accurately", 1996), using exact integer
+// arithmetic. Requires: a finite non-zero value.
+template<typename T>
+[[nodiscard]] constexpr signed_fixed_data to_shortest_fixed(const float_bits<T>& bits) noexcept {
+    using traits    = float_traits<T>;
+    using int_exp_t = typename traits::int_exp_t;
+
+    // The value is mantissa*2^exponent.
+    const bool          subnormal = bits.exponent == 0u;
+    const std::uint64_t mantissa = static_cast<std::uint64_t>(bits.significand) |
+                                   (subnormal ? 0u : std::uint64_t{1u} << traits::sig_bits);
+    const int_exp_t exponent =
+        (subnormal ? traits::exp_subnormal
+                   : static_cast<int_exp_t>(bits.exponent) + traits::exp_origin) -
+        static_cast<int_exp_t>(traits::sig_bits);
+
+    // Numbers half-way between two floating point values are read back as the value with an even
+    // mantissa, so the interval of numbers that read back to this value includes its boundaries
+    // if the mantissa is even.
+    const bool even = mantissa % 2u == 0u;
+    // At the start of a binade (except the first), the gap to the previous value is halved.
+    const std::size_t unequal_gaps = bits.significand == 0u && bits.exponent > 1u ? 1u : 0u;
+
+    // Represent the value as r/s, and the distances to the boundaries of the interval as
+    // m_plus/s and m_minus/s, all scaled by two (or four) so they are integers. The distances are
+    // equal except at the start of a binade, so m_minus is only tracked separately there.
+    big_uint r(mantissa);
+    big_uint s(1u);
+    big_uint m_plus(1u);
+    big_uint m_minus(1u);
+    if (exponent >= 0) {
+        r.shift_left(static_cast<std::size_t>(exponent) + 1u + unequal_gaps);
+        s.shift_left(1u + unequal_gaps);
+        m_plus.shift_left(static_cast<std::size_t>(exponent) + unequal_gaps);
+        m_minus.shift_left(static_cast<std::size_t>(exponent));
+    } else {
+        r.shift_left(1u + unequal_gaps);
+        s.shift_left(static_cast<std::size_t>(-exponent) + 1u + unequal_gaps);
+        m_plus.shift_left(unequal_gaps);
+    }
+
+    const big_uint& m_low = unequal_gaps != 0u ? m_minus : m_plus;
+
+    const auto multiply_all = [&](std::size_t power) {
+        r.multiply_pow10(power);
+        m_plus.multiply_pow10(power);
+        if (unequal_gaps != 0u) {
+            m_minus.multiply_pow10(power);
+        }
+    };
+
+    // Estimate the decimal exponent k such that the value is 0.d1d2d3...*10^k, from the position
+    // of the leading bit. This is either exact or one too low.
+    const int_exp_t log2_value =
+        exponent + static_cast<int_exp_t>(std::bit_width(mantissa)) - 1;
+    int_exp_t k = floor_log10_pow2(log2_value) + (log2_value != 0 ? 1 : 0);
+    if (k >= 0) {
+        s.multiply_pow10(static_cast<std::size_t>(k));
+    } else {
+        multiply_all(static_cast<std::size_t>(-k));
+    }
+
+    const auto reaches_high = [&]() {
+        const int c = compare_sum(r, m_plus, s);
+        return even ? c >= 0 : c > 0;
+    };
+
+    if (reaches_high()) {
+        k += 1;
+    } else {
+        multiply_all(1u);
+    }
+
+    // Scale everything so digits can be estimated from the leading limb of s.
+    const std::size_t shift = s.normalize_shift();
+    r.shift_left(shift);
+    s.shift_left(shift);
+    m_plus.shift_left(shift);
+    if (unequal_gaps != 0u) {
+        m_minus.shift_left(shift);
+    }
+
+    // Generate digits until the remaining value is within the interval.
+    signed_fixed_data result{.digits = 0u, .exponent = k, .sign = bits.sign};
+    while (true) {
+        fixed_digits_t digit = r.divide_digit(s);
+        result.exponent -= 1;
+
+        const int  low_cmp = compare(r, m_low);
+        const bool low     = even ? low_cmp <= 0 : low_cmp < 0;
+        const bool high    = reaches_high();
+
+        if (!low && !high) {
+            result.digits = result.digits * 10u + digit;
+            multiply_all(1u);
+            continue;
+        }
+
+        if (low && high) {
+            // Both the digit and the next one are within the interval; pick the closest, and the
+            // even one for ties.
+            big_uint twice_r = r;
+            twice_r.shift_left(1u);
+            const int c = compare(twice_r, s);
+            if (c > 0 || (c == 0 && digit % 2u == 1u)) {
+                digit += 1u;
+            }
+        } else if (high) {
+            digit += 1u;
+        }
+
+        result.digits = result.digits * 10u + digit;
+        return result;
+    }
+}
 } // namespace snitch::impl
 
 #endif
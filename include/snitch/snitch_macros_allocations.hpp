@@ -0,0 +1,38 @@
+#ifndef SNITCH_MACROS_ALLOCATIONS_HPP
+#define SNITCH_MACROS_ALLOCATIONS_HPP
+
+#include "snitch/snitch_allocations.hpp"
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_macros_check_base.hpp"
+#include "snitch/snitch_macros_utility.hpp"
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+#    if SNITCH_ENABLE
+// The block is the body of a for loop that runs once; the check is done in the increment
+// statement, after the block completes, so it can abort the test like any other assertion.
+#        define SNITCH_REQUIRE_NO_ALLOCATIONS_IMPL(ID, MAYBE_ABORT)                                \
+            for (snitch::impl::no_allocation_checker ID{SNITCH_CURRENT_LOCATION}; !ID.done;        \
+                 ID.done = true, ID.report() ? static_cast<void>(0) : MAYBE_ABORT)
+
+#        define SNITCH_REQUIRE_NO_ALLOCATIONS                                                      \
+            SNITCH_REQUIRE_NO_ALLOCATIONS_IMPL(                                                    \
+                SNITCH_MACRO_CONCAT(allocation_check_, __COUNTER__), SNITCH_TESTING_ABORT)
+#        define SNITCH_CHECK_NO_ALLOCATIONS                                                        \
+            SNITCH_REQUIRE_NO_ALLOCATIONS_IMPL(                                                    \
+                SNITCH_MACRO_CONCAT(allocation_check_, __COUNTER__), static_cast<void>(0))
+#    else // SNITCH_ENABLE
+// clang-format off
+#        define SNITCH_REQUIRE_NO_ALLOCATIONS if constexpr (false)
+#        define SNITCH_CHECK_NO_ALLOCATIONS   if constexpr (false)
+// clang-format on
+#    endif // SNITCH_ENABLE
+
+// clang-format off
+#    if SNITCH_WITH_SHORTHAND_MACROS
+#        define REQUIRE_NO_ALLOCATIONS SNITCH_REQUIRE_NO_ALLOCATIONS
+#        define CHECK_NO_ALLOCATIONS   SNITCH_CHECK_NO_ALLOCATIONS
+#    endif
+// clang-format on
+#endif
+
+#endif
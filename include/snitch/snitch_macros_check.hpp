@@ -84,6 +84,23 @@
 #    define SNITCH_CHECK_THAT(EXPR, ...)   SNITCH_REQUIRE_THAT_IMPL("CHECK_THAT",   (void)0,               EXPR, __VA_ARGS__)
 // clang-format on
 
+#    define SNITCH_REQUIRE_RANGE_EQUAL_IMPL(CHECK, MAYBE_ABORT, RANGE, ...)                        \
+        do {                                                                                       \
+            auto       SNITCH_CURRENT_CHECK = SNITCH_NEW_CHECK;                                    \
+            const auto SNITCH_TEMP_RESULT =                                                        \
+                snitch::impl::match(RANGE, snitch::matchers::range_equals(__VA_ARGS__));           \
+            const auto SNITCH_CURRENT_EXPRESSION = snitch::impl::expression{                       \
+                CHECK, #RANGE ", " #__VA_ARGS__,                                                   \
+                snitch::resize_or_truncate<snitch::max_expr_length>(SNITCH_TEMP_RESULT.second),    \
+                SNITCH_TEMP_RESULT.first};                                                         \
+            SNITCH_REPORT_EXPRESSION(MAYBE_ABORT);                                                 \
+        } while (0)
+
+// clang-format off
+#    define SNITCH_REQUIRE_RANGE_EQUAL(RANGE, ...) SNITCH_REQUIRE_RANGE_EQUAL_IMPL("REQUIRE_RANGE_EQUAL", SNITCH_TESTING_ABORT,  RANGE, __VA_ARGS__)
+#    define SNITCH_CHECK_RANGE_EQUAL(RANGE, ...)   SNITCH_REQUIRE_RANGE_EQUAL_IMPL("CHECK_RANGE_EQUAL",   (void)0,               RANGE, __VA_ARGS__)
+// clang-format on
+
 #else // SNITCH_ENABLE
 // clang-format off
 #    define SNITCH_REQUIRE(...)       SNITCH_DISCARD_ARGS(__VA_ARGS__)
@@ -99,6 +116,9 @@
 
 #    define SNITCH_REQUIRE_THAT(EXPR, ...) SNITCH_DISCARD_ARGS(EXPR, __VA_ARGS__)
 #    define SNITCH_CHECK_THAT(EXPR, ...)   SNITCH_DISCARD_ARGS(EXPR, __VA_ARGS__)
+
+#    define SNITCH_REQUIRE_RANGE_EQUAL(RANGE, ...) SNITCH_DISCARD_ARGS(RANGE, __VA_ARGS__)
+#    define SNITCH_CHECK_RANGE_EQUAL(RANGE, ...)   SNITCH_DISCARD_ARGS(RANGE, __VA_ARGS__)
 // clang-format on
 
 #endif // SNITCH_ENABLE
@@ -117,6 +137,8 @@
 #    define CHECK_FALSE(...) SNITCH_CHECK_FALSE(__VA_ARGS__)
 #    define REQUIRE_THAT(EXP, ...) SNITCH_REQUIRE_THAT(EXP, __VA_ARGS__)
 #    define CHECK_THAT(EXP, ...) SNITCH_CHECK_THAT(EXP, __VA_ARGS__)
+#    define REQUIRE_RANGE_EQUAL(RANGE, ...) SNITCH_REQUIRE_RANGE_EQUAL(RANGE, __VA_ARGS__)
+#    define CHECK_RANGE_EQUAL(RANGE, ...) SNITCH_CHECK_RANGE_EQUAL(RANGE, __VA_ARGS__)
 #endif
 // clang-format on
 
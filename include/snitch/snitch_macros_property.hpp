@@ -0,0 +1,25 @@
+#ifndef SNITCH_MACROS_PROPERTY_HPP
+#define SNITCH_MACROS_PROPERTY_HPP
+
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_macros_utility.hpp"
+#include "snitch/snitch_property.hpp"
+#include "snitch/snitch_registry.hpp"
+
+#if SNITCH_ENABLE
+#    define SNITCH_PROPERTY(NAME, TAGS, ...)                                                       \
+        static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =           \
+            snitch::impl::property_registrar{                                                      \
+                snitch::tests, {NAME, TAGS}, SNITCH_CURRENT_LOCATION, __VA_ARGS__} = []
+#else // SNITCH_ENABLE
+#    define SNITCH_PROPERTY(NAME, TAGS, ...)                                                       \
+        [[maybe_unused]] static const auto SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) = []
+#endif // SNITCH_ENABLE
+
+// clang-format off
+#if SNITCH_WITH_SHORTHAND_MACROS
+#    define PROPERTY(NAME, TAGS, ...) SNITCH_PROPERTY(NAME, TAGS, __VA_ARGS__)
+#endif
+// clang-format on
+
+#endif
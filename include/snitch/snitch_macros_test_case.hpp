@@ -5,7 +5,132 @@
 #include "snitch/snitch_macros_utility.hpp"
 #include "snitch/snitch_registry.hpp"
 
-#if SNITCH_ENABLE
+#if SNITCH_ENABLE && SNITCH_WITH_LINKER_REGISTRATION
+// Declare a pointer to a registration entry in the 'snitch_tests' linker section.
+#    define SNITCH_REGISTRATION_POINTER(ENTRY)                                                     \
+        [[gnu::used, gnu::section("snitch_tests")]] SNITCH_RETAIN_SECTION static constinit const   \
+            snitch::impl::registration_entry* SNITCH_MACRO_CONCAT(ENTRY, _ptr) = &ENTRY
+
+#    define SNITCH_TEST_CASE_IMPL(ID, ...)                                                         \
+        static void ID();                                                                          \
+        static constexpr snitch::impl::registration_entry SNITCH_MACRO_CONCAT(ID, _entry) = {      \
+            .add      = &snitch::impl::add_test_entry,                                             \
+            .id       = {{}, __VA_ARGS__},                                                         \
+            .location = SNITCH_CURRENT_LOCATION,                                                   \
+            .func     = &ID};                                                                      \
+        SNITCH_REGISTRATION_POINTER(SNITCH_MACRO_CONCAT(ID, _entry));                              \
+        void ID()
+
+#    define SNITCH_TEST_CASE(...)                                                                  \
+        SNITCH_TEST_CASE_IMPL(SNITCH_MACRO_CONCAT(test_fun_, __COUNTER__), __VA_ARGS__)
+
+#    define SNITCH_TEMPLATE_LIST_TEST_CASE_IMPL(ID, NAME, TAGS, TYPES)                             \
+        template<typename TestType>                                                                \
+        static void ID();                                                                          \
+        static constexpr snitch::impl::registration_entry SNITCH_MACRO_CONCAT(ID, _entry) = {      \
+            .add =                                                                                 \
+                [](snitch::registry& reg, const snitch::impl::registration_entry& entry) {         \
+                    reg.add_with_type_list<TYPES>(                                                 \
+                        {entry.id.name, entry.id.tags}, entry.location,                            \
+                        []<typename TestType>() { ID<TestType>(); });                              \
+                },                                                                                 \
+            .id       = {{}, NAME, TAGS},                                                          \
+            .location = SNITCH_CURRENT_LOCATION};                                                  \
+        SNITCH_REGISTRATION_POINTER(SNITCH_MACRO_CONCAT(ID, _entry));                              \
+        template<typename TestType>                                                                \
+        void ID()
+
+#    define SNITCH_TEMPLATE_LIST_TEST_CASE(NAME, TAGS, TYPES)                                      \
+        SNITCH_TEMPLATE_LIST_TEST_CASE_IMPL(                                                       \
+            SNITCH_MACRO_CONCAT(test_fun_, __COUNTER__), NAME, TAGS, TYPES)
+
+#    define SNITCH_TEMPLATE_TEST_CASE_IMPL(ID, NAME, TAGS, ...)                                    \
+        template<typename TestType>                                                                \
+        static void ID();                                                                          \
+        static constexpr snitch::impl::registration_entry SNITCH_MACRO_CONCAT(ID, _entry) = {      \
+            .add =                                                                                 \
+                [](snitch::registry& reg, const snitch::impl::registration_entry& entry) {         \
+                    reg.add_with_types<__VA_ARGS__>(                                               \
+                        {entry.id.name, entry.id.tags}, entry.location,                            \
+                        []<typename TestType>() { ID<TestType>(); });                              \
+                },                                                                                 \
+            .id       = {{}, NAME, TAGS},                                                          \
+            .location = SNITCH_CURRENT_LOCATION};                                                  \
+        SNITCH_REGISTRATION_POINTER(SNITCH_MACRO_CONCAT(ID, _entry));                              \
+        template<typename TestType>                                                                \
+        void ID()
+
+#    define SNITCH_TEMPLATE_TEST_CASE(NAME, TAGS, ...)                                             \
+        SNITCH_TEMPLATE_TEST_CASE_IMPL(                                                            \
+            SNITCH_MACRO_CONCAT(test_fun_, __COUNTER__), NAME, TAGS, __VA_ARGS__)
+
+#    define SNITCH_TEST_CASE_METHOD_IMPL(ID, FIXTURE, ...)                                         \
+        namespace {                                                                                \
+        struct ID : FIXTURE {                                                                      \
+            void test_fun();                                                                       \
+        };                                                                                         \
+        }                                                                                          \
+        static constexpr snitch::impl::registration_entry SNITCH_MACRO_CONCAT(ID, _entry) = {      \
+            .add      = &snitch::impl::add_fixture_entry,                                          \
+            .id       = {#FIXTURE, __VA_ARGS__},                                                   \
+            .location = SNITCH_CURRENT_LOCATION,                                                   \
+            .func     = []() { ID{}.test_fun(); }};                                                \
+        SNITCH_REGISTRATION_POINTER(SNITCH_MACRO_CONCAT(ID, _entry));                              \
+        void ID::test_fun()
+
+#    define SNITCH_TEST_CASE_METHOD(FIXTURE, ...)                                                  \
+        SNITCH_TEST_CASE_METHOD_IMPL(                                                              \
+            SNITCH_MACRO_CONCAT(test_fixture_, __COUNTER__), FIXTURE, __VA_ARGS__)
+
+#    define SNITCH_TEMPLATE_LIST_TEST_CASE_METHOD_IMPL(ID, FIXTURE, NAME, TAGS, TYPES)             \
+        namespace {                                                                                \
+        template<typename TestType>                                                                \
+        struct ID : FIXTURE<TestType> {                                                            \
+            void test_fun();                                                                       \
+        };                                                                                         \
+        }                                                                                          \
+        static constexpr snitch::impl::registration_entry SNITCH_MACRO_CONCAT(ID, _entry) = {      \
+            .add =                                                                                 \
+                [](snitch::registry& reg, const snitch::impl::registration_entry& entry) {         \
+                    reg.add_fixture_with_type_list<TYPES>(                                         \
+                        entry.id, entry.location,                                                  \
+                        []<typename TestType>() { ID<TestType>{}.test_fun(); });                   \
+                },                                                                                 \
+            .id       = {#FIXTURE, NAME, TAGS},                                                    \
+            .location = SNITCH_CURRENT_LOCATION};                                                  \
+        SNITCH_REGISTRATION_POINTER(SNITCH_MACRO_CONCAT(ID, _entry));                              \
+        template<typename TestType>                                                                \
+        void ID<TestType>::test_fun()
+
+#    define SNITCH_TEMPLATE_LIST_TEST_CASE_METHOD(FIXTURE, NAME, TAGS, TYPES)                      \
+        SNITCH_TEMPLATE_LIST_TEST_CASE_METHOD_IMPL(                                                \
+            SNITCH_MACRO_CONCAT(test_fixture_, __COUNTER__), FIXTURE, NAME, TAGS, TYPES)
+
+#    define SNITCH_TEMPLATE_TEST_CASE_METHOD_IMPL(ID, FIXTURE, NAME, TAGS, ...)                    \
+        namespace {                                                                                \
+        template<typename TestType>                                                                \
+        struct ID : FIXTURE<TestType> {                                                            \
+            void test_fun();                                                                       \
+        };                                                                                         \
+        }                                                                                          \
+        static constexpr snitch::impl::registration_entry SNITCH_MACRO_CONCAT(ID, _entry) = {      \
+            .add =                                                                                 \
+                [](snitch::registry& reg, const snitch::impl::registration_entry& entry) {         \
+                    reg.add_fixture_with_types<__VA_ARGS__>(                                       \
+                        entry.id, entry.location,                                                  \
+                        []<typename TestType>() { ID<TestType>{}.test_fun(); });                   \
+                },                                                                                 \
+            .id       = {#FIXTURE, NAME, TAGS},                                                    \
+            .location = SNITCH_CURRENT_LOCATION};                                                  \
+        SNITCH_REGISTRATION_POINTER(SNITCH_MACRO_CONCAT(ID, _entry));                              \
+        template<typename TestType>                                                                \
+        void ID<TestType>::test_fun()
+
+#    define SNITCH_TEMPLATE_TEST_CASE_METHOD(FIXTURE, NAME, TAGS, ...)                             \
+        SNITCH_TEMPLATE_TEST_CASE_METHOD_IMPL(                                                     \
+            SNITCH_MACRO_CONCAT(test_fixture_, __COUNTER__), FIXTURE, NAME, TAGS, __VA_ARGS__)
+
+#elif SNITCH_ENABLE
 #    define SNITCH_TEST_CASE_IMPL(ID, ...)                                                         \
         static void        ID();                                                                   \
         static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =           \
@@ -68,7 +193,7 @@
         static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =           \
             snitch::tests.add_fixture_with_type_list<TYPES>(                                       \
                 {#FIXTURE, NAME, TAGS}, SNITCH_CURRENT_LOCATION,                                   \
-                []() < typename TestType > { ID<TestType>{}.test_fun(); });                        \
+                []<typename TestType>() { ID<TestType>{}.test_fun(); });                           \
         template<typename TestType>                                                                \
         void ID<TestType>::test_fun()
 
@@ -86,7 +211,7 @@
         static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =           \
             snitch::tests.add_fixture_with_types<__VA_ARGS__>(                                     \
                 {#FIXTURE, NAME, TAGS}, SNITCH_CURRENT_LOCATION,                                   \
-                []() < typename TestType > { ID<TestType>{}.test_fun(); });                        \
+                []<typename TestType>() { ID<TestType>{}.test_fun(); });                           \
         template<typename TestType>                                                                \
         void ID<TestType>::test_fun()
 
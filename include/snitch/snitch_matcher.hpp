@@ -2,12 +2,19 @@
 #define SNITCH_MATCHER_HPP
 
 #include "snitch/snitch_append.hpp"
+#include "snitch/snitch_concepts.hpp"
 #include "snitch/snitch_config.hpp"
 #include "snitch/snitch_error_handling.hpp"
+#include "snitch/snitch_fixed_point.hpp"
 #include "snitch/snitch_string.hpp"
 #include "snitch/snitch_string_utility.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <optional>
+#include <type_traits>
 
 namespace snitch::matchers {
 enum class match_status { failed, matched };
@@ -38,6 +45,214 @@ template<typename T, typename M>
             true, matcher.describe_match(value, matchers::match_status::matched));
     }
 }
+
+template<typename R, typename T>
+concept contiguous_range_of = requires(const R& r) {
+    { r.data() } -> convertible_to<const T*>;
+    { r.size() } -> convertible_to<std::size_t>;
+};
+
+template<typename R>
+using range_element_t = std::remove_cvref_t<decltype(*std::declval<const R&>().data())>;
+
+// std::abs is not constexpr before C++23.
+template<floating_point T>
+[[nodiscard]] constexpr T abs_float(T f) noexcept {
+    return f < T{0} ? -f : f;
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr bool is_within_abs(T value, T target, T margin) noexcept {
+    return value == target || abs_float(value - target) <= margin;
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr bool is_within_rel(T value, T target, T epsilon) noexcept {
+    const T abs_value  = abs_float(value);
+    const T abs_target = abs_float(target);
+    return value == target ||
+           abs_float(value - target) <= epsilon * (abs_value > abs_target ? abs_value : abs_target);
+}
+
+// Number of representable values between 'value' and 'target' (zero if they are equal, and +0
+// and -0 are equal); the maximum integer value if either is NaN.
+template<floating_point T>
+[[nodiscard]] constexpr std::uint64_t ulp_distance(T value, T target) noexcept {
+    if (value != value || target != target) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+
+    // Map the sign-and-magnitude representation to a monotonic integer.
+    const auto to_ordered = [](T f) {
+        const float_bits<T> bits      = to_bits(f);
+        const std::int64_t  magnitude = static_cast<std::int64_t>(
+            (static_cast<std::uint64_t>(bits.exponent) << float_traits<T>::sig_bits) |
+            bits.significand);
+        return bits.sign ? -magnitude : magnitude;
+    };
+
+    const std::int64_t a = to_ordered(value);
+    const std::int64_t b = to_ordered(target);
+    return a > b ? static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b)
+                 : static_cast<std::uint64_t>(b) - static_cast<std::uint64_t>(a);
+}
+
+// Find the index of the first element of 'values' at or after 'start' that does not match the
+// element of 'targets' at the same index, or return 'size' if all match. These compare elements
+// in blocks that the compiler can vectorize, so they are suited to very large ranges.
+SNITCH_EXPORT std::size_t find_mismatch_abs(
+    const float* values, const float* targets, std::size_t size, std::size_t start,
+    float margin) noexcept;
+SNITCH_EXPORT std::size_t find_mismatch_abs(
+    const double* values, const double* targets, std::size_t size, std::size_t start,
+    double margin) noexcept;
+SNITCH_EXPORT std::size_t find_mismatch_rel(
+    const float* values, const float* targets, std::size_t size, std::size_t start,
+    float epsilon) noexcept;
+SNITCH_EXPORT std::size_t find_mismatch_rel(
+    const double* values, const double* targets, std::size_t size, std::size_t start,
+    double epsilon) noexcept;
+SNITCH_EXPORT std::size_t find_mismatch_ulps(
+    const float* values, const float* targets, std::size_t size, std::size_t start,
+    std::uint64_t max_ulps) noexcept;
+SNITCH_EXPORT std::size_t find_mismatch_ulps(
+    const double* values, const double* targets, std::size_t size, std::size_t start,
+    std::uint64_t max_ulps) noexcept;
+
+template<typename R>
+concept sized_range = requires(const R& r) {
+    r.begin();
+    r.end();
+    { r.size() } -> convertible_to<std::size_t>;
+};
+
+template<typename R>
+concept contiguous_sized_range = sized_range<R> && requires(const R& r) {
+    { r.data() } -> convertible_to<const range_element_t<R>*>;
+};
+
+// Types for which equality is the same as equality of the object representation.
+template<typename T>
+concept bitwise_comparable = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+// Compare the elements of two ranges of equal size.
+template<sized_range R1, sized_range R2>
+[[nodiscard]] constexpr bool equal_elements(const R1& values, const R2& expected) noexcept {
+    const std::size_t size = values.size();
+
+    if constexpr (contiguous_sized_range<R1> && contiguous_sized_range<R2>) {
+        using value_t = range_element_t<R1>;
+        if constexpr (
+            std::is_same_v<value_t, range_element_t<R2>> && bitwise_comparable<value_t>) {
+            if (!std::is_constant_evaluated()) {
+                return size == 0u ||
+                       std::memcmp(values.data(), expected.data(), size * sizeof(value_t)) == 0;
+            }
+        }
+
+        // Compare elements in blocks with no early exit, so the compiler can vectorize the loop.
+        constexpr std::size_t block_size = 64u;
+
+        const auto* a = values.data();
+        const auto* b = expected.data();
+
+        std::size_t i = 0u;
+        for (; size - i >= block_size; i += block_size) {
+            std::size_t num_mismatches = 0u;
+            for (std::size_t j = 0; j < block_size; ++j) {
+                num_mismatches += static_cast<bool>(a[i + j] == b[i + j]) ? 0u : 1u;
+            }
+
+            if (num_mismatches != 0u) {
+                return false;
+            }
+        }
+
+        for (; i < size; ++i) {
+            if (!static_cast<bool>(a[i] == b[i])) {
+                return false;
+            }
+        }
+
+        return true;
+    } else {
+        auto it_expected = expected.begin();
+        for (const auto& value : values) {
+            if (!static_cast<bool>(value == *it_expected)) {
+                return false;
+            }
+
+            ++it_expected;
+        }
+
+        return true;
+    }
+}
+
+// Common implementation of the matchers comparing ranges of floating point numbers element-wise.
+// 'Derived' must provide 'find_mismatch(values, start)' and 'append_tolerance(string)'.
+template<typename Derived, floating_point T>
+struct all_within {
+    const T*    targets      = nullptr;
+    std::size_t size         = 0u;
+    std::size_t max_reported = 0u;
+
+    template<contiguous_range_of<T> R>
+    constexpr all_within(const R& expected, std::size_t max_reported_mismatches) noexcept :
+        targets(expected.data()), size(expected.size()), max_reported(max_reported_mismatches) {}
+
+    template<contiguous_range_of<T> R>
+    bool match(const R& values) const noexcept {
+        return values.size() == size &&
+               static_cast<const Derived&>(*this).find_mismatch(values.data(), 0u) == size;
+    }
+
+    template<contiguous_range_of<T> R>
+    small_string<max_message_length>
+    describe_match(const R& values, matchers::match_status status) const noexcept {
+        const Derived& self = static_cast<const Derived&>(*this);
+
+        small_string<max_message_length> description_buffer;
+        if (values.size() != size) {
+            append_or_truncate(
+                description_buffer, "range has ", values.size(), " elements, expected ", size);
+            return description_buffer;
+        }
+
+        if (status == matchers::match_status::matched) {
+            append_or_truncate(description_buffer, "all ", size, " elements are within ");
+            self.append_tolerance(description_buffer);
+            return description_buffer;
+        }
+
+        // Only the first mismatches are listed, but all are counted.
+        small_string<max_message_length> mismatches_buffer;
+        std::size_t                      num_mismatches = 0u;
+        for (std::size_t i = self.find_mismatch(values.data(), 0u); i < size;
+             i             = self.find_mismatch(values.data(), i + 1u)) {
+            if (num_mismatches < max_reported) {
+                append_or_truncate(
+                    mismatches_buffer, (num_mismatches == 0u ? "" : ", "), "[", i, "] '",
+                    values.data()[i], "' vs '", targets[i], "'");
+            }
+
+            ++num_mismatches;
+        }
+
+        append_or_truncate(
+            description_buffer, num_mismatches, " of ", size, " elements are not within ");
+        self.append_tolerance(description_buffer);
+        if (max_reported > 0u) {
+            append_or_truncate(description_buffer, "; ");
+            if (num_mismatches > max_reported) {
+                append_or_truncate(description_buffer, "first ", max_reported, " ");
+            }
+            append_or_truncate(description_buffer, "mismatches: ", mismatches_buffer);
+        }
+
+        return description_buffer;
+    }
+};
 } // namespace snitch::impl
 
 namespace snitch::matchers {
@@ -109,6 +324,233 @@ struct with_what_contains : private contains_substring {
     }
 };
 
+template<floating_point T>
+struct within_abs {
+    T target;
+    T margin;
+
+    constexpr within_abs(T target_value, T margin_value) noexcept :
+        target(target_value), margin(margin_value) {}
+
+    constexpr bool match(T value) const noexcept {
+        return impl::is_within_abs(value, target, margin);
+    }
+
+    constexpr small_string<max_message_length>
+    describe_match(T value, match_status status) const noexcept {
+        small_string<max_message_length> description_buffer;
+        append_or_truncate(
+            description_buffer, "'", value, "' is ", (status == match_status::failed ? "not " : ""),
+            "within ", margin, " of '", target, "'");
+        return description_buffer;
+    }
+};
+
+template<floating_point T, typename U>
+within_abs(T, U) -> within_abs<T>;
+
+template<floating_point T>
+struct within_rel {
+    T target;
+    T epsilon;
+
+    constexpr within_rel(T target_value, T epsilon_value) noexcept :
+        target(target_value), epsilon(epsilon_value) {}
+
+    constexpr bool match(T value) const noexcept {
+        return impl::is_within_rel(value, target, epsilon);
+    }
+
+    constexpr small_string<max_message_length>
+    describe_match(T value, match_status status) const noexcept {
+        small_string<max_message_length> description_buffer;
+        append_or_truncate(
+            description_buffer, "'", value, "' is ", (status == match_status::failed ? "not " : ""),
+            "within ", epsilon, " (relative) of '", target, "'");
+        return description_buffer;
+    }
+};
+
+template<floating_point T, typename U>
+within_rel(T, U) -> within_rel<T>;
+
+template<floating_point T>
+struct within_ulps {
+    T             target;
+    std::uint64_t max_ulps;
+
+    constexpr within_ulps(T target_value, std::uint64_t max_ulps_value) noexcept :
+        target(target_value), max_ulps(max_ulps_value) {}
+
+    constexpr bool match(T value) const noexcept {
+        return impl::ulp_distance(value, target) <= max_ulps;
+    }
+
+    constexpr small_string<max_message_length>
+    describe_match(T value, match_status status) const noexcept {
+        small_string<max_message_length> description_buffer;
+        append_or_truncate(
+            description_buffer, "'", value, "' is ", (status == match_status::failed ? "not " : ""),
+            "within ", max_ulps, " ULPs of '", target, "'");
+
+        const std::uint64_t distance = impl::ulp_distance(value, target);
+        if (distance != std::numeric_limits<std::uint64_t>::max()) {
+            append_or_truncate(description_buffer, " (distance: ", distance, " ULPs)");
+        }
+
+        return description_buffer;
+    }
+};
+
+template<floating_point T>
+within_ulps(T, std::uint64_t) -> within_ulps<T>;
+
+// Number of mismatching elements listed by the range matchers below, unless specified otherwise.
+constexpr std::size_t default_max_reported_mismatches = 5u;
+
+template<floating_point T>
+struct all_within_abs : impl::all_within<all_within_abs<T>, T> {
+    T margin;
+
+    template<impl::contiguous_range_of<T> R>
+    constexpr all_within_abs(
+        const R&    expected,
+        T           margin_value,
+        std::size_t max_reported_mismatches = default_max_reported_mismatches) noexcept :
+        impl::all_within<all_within_abs<T>, T>(expected, max_reported_mismatches),
+        margin(margin_value) {}
+
+    std::size_t find_mismatch(const T* values, std::size_t start) const noexcept {
+        return impl::find_mismatch_abs(values, this->targets, this->size, start, margin);
+    }
+
+    void append_tolerance(small_string_span ss) const noexcept {
+        append_or_truncate(ss, margin);
+    }
+};
+
+template<typename R, typename... Args>
+all_within_abs(const R&, Args...) -> all_within_abs<impl::range_element_t<R>>;
+
+template<floating_point T>
+struct all_within_rel : impl::all_within<all_within_rel<T>, T> {
+    T epsilon;
+
+    template<impl::contiguous_range_of<T> R>
+    constexpr all_within_rel(
+        const R&    expected,
+        T           epsilon_value,
+        std::size_t max_reported_mismatches = default_max_reported_mismatches) noexcept :
+        impl::all_within<all_within_rel<T>, T>(expected, max_reported_mismatches),
+        epsilon(epsilon_value) {}
+
+    std::size_t find_mismatch(const T* values, std::size_t start) const noexcept {
+        return impl::find_mismatch_rel(values, this->targets, this->size, start, epsilon);
+    }
+
+    void append_tolerance(small_string_span ss) const noexcept {
+        append_or_truncate(ss, epsilon, " (relative)");
+    }
+};
+
+template<typename R, typename... Args>
+all_within_rel(const R&, Args...) -> all_within_rel<impl::range_element_t<R>>;
+
+template<floating_point T>
+struct all_within_ulps : impl::all_within<all_within_ulps<T>, T> {
+    std::uint64_t max_ulps;
+
+    template<impl::contiguous_range_of<T> R>
+    constexpr all_within_ulps(
+        const R&      expected,
+        std::uint64_t max_ulps_value,
+        std::size_t   max_reported_mismatches = default_max_reported_mismatches) noexcept :
+        impl::all_within<all_within_ulps<T>, T>(expected, max_reported_mismatches),
+        max_ulps(max_ulps_value) {}
+
+    std::size_t find_mismatch(const T* values, std::size_t start) const noexcept {
+        return impl::find_mismatch_ulps(values, this->targets, this->size, start, max_ulps);
+    }
+
+    void append_tolerance(small_string_span ss) const noexcept {
+        append_or_truncate(ss, max_ulps, " ULPs");
+    }
+};
+
+template<typename R, typename... Args>
+all_within_ulps(const R&, Args...) -> all_within_ulps<impl::range_element_t<R>>;
+
+// The expected range is not copied; it must outlive the matcher.
+template<impl::sized_range R>
+struct range_equals {
+    const R*    expected     = nullptr;
+    std::size_t max_reported = 0u;
+
+    constexpr explicit range_equals(
+        const R&    expected_range,
+        std::size_t max_reported_mismatches = default_max_reported_mismatches) noexcept :
+        expected(&expected_range), max_reported(max_reported_mismatches) {}
+
+    template<impl::sized_range V>
+    constexpr bool match(const V& values) const noexcept {
+        return values.size() == expected->size() && impl::equal_elements(values, *expected);
+    }
+
+    template<impl::sized_range V>
+    constexpr small_string<max_message_length>
+    describe_match(const V& values, match_status status) const noexcept {
+        small_string<max_message_length> description_buffer;
+        if (values.size() != expected->size()) {
+            append_or_truncate(
+                description_buffer, "range has ", values.size(), " elements, expected ",
+                expected->size());
+            return description_buffer;
+        }
+
+        if (status == match_status::matched) {
+            append_or_truncate(description_buffer, "all ", values.size(), " elements are equal");
+            return description_buffer;
+        }
+
+        // Only the first mismatches are listed, but all are counted.
+        small_string<max_message_length> mismatches_buffer;
+        std::size_t                      num_mismatches = 0u;
+        std::size_t                      index          = 0u;
+        auto                             it_expected    = expected->begin();
+        for (const auto& value : values) {
+            if (!static_cast<bool>(value == *it_expected)) {
+                if (num_mismatches < max_reported) {
+                    append_or_truncate(
+                        mismatches_buffer, (num_mismatches == 0u ? "" : ", "), "[", index, "]");
+                    if constexpr (
+                        string_appendable<decltype(value)> &&
+                        string_appendable<decltype(*it_expected)>) {
+                        append_or_truncate(
+                            mismatches_buffer, " '", value, "' vs '", *it_expected, "'");
+                    }
+                }
+
+                ++num_mismatches;
+            }
+
+            ++it_expected;
+            ++index;
+        }
+
+        append_or_truncate(
+            description_buffer, num_mismatches, " of ", values.size(), " elements differ");
+        if (max_reported > 0u) {
+            append_or_truncate(description_buffer, "; ");
+            if (num_mismatches > max_reported) {
+                append_or_truncate(description_buffer, "first ", max_reported, " ");
+            }
+            append_or_truncate(description_buffer, "mismatches: ", mismatches_buffer);
+        }
+
+        return description_buffer;
+    }
+};
+
 template<typename T, matcher_for<T> M>
 bool operator==(const T& value, const M& m) noexcept {
     return m.match(value);
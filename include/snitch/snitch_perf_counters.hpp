@@ -0,0 +1,39 @@
+#ifndef SNITCH_PERF_COUNTERS_HPP
+#define SNITCH_PERF_COUNTERS_HPP
+
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_test_data.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#if SNITCH_WITH_PERF_COUNTERS
+
+namespace snitch::impl {
+// Read the current value of the counters for the calling thread, opening them on first use.
+// Counters that cannot be opened (not supported, not permitted, or not on Linux) are left empty.
+SNITCH_EXPORT perf_counters read_perf_counters() noexcept;
+
+// Compute the counter increments between two readings.
+SNITCH_EXPORT perf_counters
+get_perf_counters_delta(const perf_counters& start, const perf_counters& end) noexcept;
+
+// Call 'func(name, value)' for each available counter.
+template<typename F>
+void for_each_perf_counter(const perf_counters& counters, F&& func) noexcept {
+    const auto call = [&](std::string_view name, const std::optional<std::uint64_t>& value) {
+        if (value.has_value()) {
+            func(name, value.value());
+        }
+    };
+
+    call("instructions", counters.instructions);
+    call("cycles", counters.cycles);
+    call("cache_misses", counters.cache_misses);
+    call("branch_misses", counters.branch_misses);
+}
+} // namespace snitch::impl
+
+#endif
+#endif
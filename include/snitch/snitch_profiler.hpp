@@ -0,0 +1,78 @@
+#ifndef SNITCH_PROFILER_HPP
+#define SNITCH_PROFILER_HPP
+
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_error_handling.hpp"
+#include "snitch/snitch_file.hpp"
+#include "snitch/snitch_string.hpp"
+#include "snitch/snitch_test_data.hpp"
+#include "snitch/snitch_time.hpp"
+#include "snitch/snitch_vector.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+#if SNITCH_WITH_TIMINGS
+
+namespace snitch {
+// Maximum number of distinct section paths timed per test case when profiling.
+constexpr std::size_t max_profile_entries = SNITCH_MAX_PROFILE_ENTRIES;
+} // namespace snitch
+
+namespace snitch::impl {
+enum class profile_format { collapsed_stack, chrome_trace };
+
+struct profile_entry {
+    // Section names, from the outermost to the innermost, separated by ';'.
+    small_string<max_message_length> path = {};
+    // Number of nested sections in the path (1 for a top-level section).
+    std::size_t depth = 0;
+    // Number of times the section was entered (once per leaf section executed below it).
+    std::size_t calls = 0;
+    // Time index of the instant when the section was first entered.
+    time_point_t first_start = 0;
+    // Accumulated time spent in the section, over all entries.
+    time_point_t total_time = 0;
+};
+
+// Aggregates section timings per test case, and writes them to a file when the test case ends.
+// Only the sections of the test case currently running are kept in memory.
+class profiler {
+    file_writer                                      file;
+    profile_format                                   format = profile_format::collapsed_stack;
+    small_vector<profile_entry, max_profile_entries> entries;
+    bool                                             first_record  = true;
+    bool                                             overflow_seen = false;
+
+    void write_collapsed_stack(std::string_view test_name, time_point_t duration) noexcept;
+    void write_chrome_trace(
+        std::string_view test_name, time_point_t start, time_point_t duration) noexcept;
+    void write_chrome_event(
+        std::string_view name,
+        std::string_view category,
+        time_point_t     start,
+        time_point_t     duration,
+        std::size_t      calls) noexcept;
+
+public:
+    // Requires: permission to write to the given path, path length less than max_path_length
+    SNITCH_EXPORT explicit profiler(std::string_view path);
+
+    profiler(const profiler&)            = delete;
+    profiler& operator=(const profiler&) = delete;
+
+    SNITCH_EXPORT ~profiler();
+
+    // Record one exit from the innermost section in the provided stack.
+    // Returns false if the section could not be recorded because the maximum number of entries
+    // was reached (only the first time this happens in a given test case).
+    SNITCH_EXPORT bool section_exited(section_info sections, time_point_t end) noexcept;
+
+    // Write the timings of the test case that just ended, and clear them.
+    SNITCH_EXPORT void
+    test_ended(std::string_view test_name, time_point_t start, time_point_t end) noexcept;
+};
+} // namespace snitch::impl
+
+#endif
+#endif
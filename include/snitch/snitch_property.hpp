@@ -0,0 +1,573 @@
+#ifndef SNITCH_PROPERTY_HPP
+#define SNITCH_PROPERTY_HPP
+
+#include "snitch/snitch_append.hpp"
+#include "snitch/snitch_capture.hpp"
+#include "snitch/snitch_concepts.hpp"
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_function.hpp"
+#include "snitch/snitch_registry.hpp"
+#include "snitch/snitch_rng.hpp"
+#include "snitch/snitch_string.hpp"
+#include "snitch/snitch_string_utility.hpp"
+#include "snitch/snitch_test_data.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace snitch {
+// Maximum number of shrinking steps applied to a failing input.
+constexpr std::size_t max_property_shrinks = SNITCH_MAX_PROPERTY_SHRINKS;
+// Maximum number of threads used to evaluate shrunk inputs.
+constexpr std::size_t max_property_threads = SNITCH_MAX_PROPERTY_THREADS;
+// Default number of random inputs tried for each property.
+constexpr std::size_t default_property_runs = 100u;
+// Size hint given to the generators for the last run; it grows linearly from 1 on the first run.
+constexpr std::size_t max_property_size = 100u;
+
+static_assert(max_property_threads > 0u, "SNITCH_MAX_PROPERTY_THREADS must be at least 1");
+
+// Pseudo-random number generator (SplitMix64) used to generate inputs.
+// The generated sequence only depends on the seed.
+class property_rng {
+    std::uint64_t state = 0u;
+
+public:
+    constexpr explicit property_rng(std::uint64_t seed) noexcept : state(seed) {}
+
+    constexpr std::uint64_t next() noexcept {
+        return impl::splitmix64(state);
+    }
+
+    // Uniform integer in [0, bound).
+    // Requires: bound > 0.
+    constexpr std::uint64_t below(std::uint64_t bound) noexcept {
+        const std::uint64_t threshold = (std::uint64_t{0u} - bound) % bound;
+        while (true) {
+            const std::uint64_t r = next();
+            if (r >= threshold) {
+                return r % bound;
+            }
+        }
+    }
+
+    // Uniform floating point number in [0, 1).
+    constexpr double unit() noexcept {
+        return static_cast<double>(next() >> 11u) * 0x1.0p-53;
+    }
+};
+
+// Generates random values of type T, and simpler versions of a value (shrinking).
+// Specialize this template to generate values of a new type; a specialization must provide:
+//  - 'value_type', the type of the generated values,
+//  - 'generate(rng, size)', which returns a new random value; 'size' grows with the runs, and
+//    should bound the magnitude or length of the generated value,
+//  - 'shrink(value, index)', which returns the candidate number 'index' for a simpler version
+//    of 'value', or an empty optional when there are no more candidates. Candidates should be
+//    listed from the simplest to the least simple, and never be equal to 'value'.
+template<typename T>
+struct generator {
+    static_assert(!std::is_same_v<T, T>, "no generator available for this type");
+};
+
+template<typename G>
+concept property_generator = requires(
+    const G& g, property_rng& rng, const typename G::value_type& value, std::size_t n) {
+    { g.generate(rng, n) } -> convertible_to<typename G::value_type>;
+    { g.shrink(value, n) } -> same_as<std::optional<typename G::value_type>>;
+};
+
+template<>
+struct generator<bool> {
+    using value_type = bool;
+
+    constexpr bool generate(property_rng& rng, std::size_t) const noexcept {
+        return (rng.next() & 1u) != 0u;
+    }
+
+    constexpr std::optional<bool> shrink(bool value, std::size_t index) const noexcept {
+        if (value && index == 0u) {
+            return false;
+        }
+
+        return {};
+    }
+};
+
+template<integral T>
+    requires(!same_as<T, bool>)
+struct generator<T> {
+    using value_type = T;
+
+    T min = std::numeric_limits<T>::min();
+    T max = std::numeric_limits<T>::max();
+
+    // Values are handled as unsigned offsets from 'min', which avoids signed overflow.
+    constexpr std::uint64_t offset(T value) const noexcept {
+        return static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(min);
+    }
+
+    constexpr T from_offset(std::uint64_t value) const noexcept {
+        return static_cast<T>(static_cast<std::uint64_t>(min) + value);
+    }
+
+    // The simplest value: zero, or the bound closest to zero.
+    constexpr T target() const noexcept {
+        if (offset(T{0}) <= offset(max)) {
+            return T{0};
+        }
+
+        return min > T{0} ? min : max;
+    }
+
+    constexpr T generate(property_rng& rng, std::size_t size) const noexcept {
+        const std::uint64_t span = offset(max);
+        switch (rng.below(8u)) {
+        case 0u: {
+            // Bounds.
+            const std::uint64_t pick = rng.below(3u);
+            return pick == 0u ? min : pick == 1u ? max : target();
+        }
+        case 1u: {
+            // Anywhere in the range.
+            return from_offset(
+                span == std::numeric_limits<std::uint64_t>::max() ? rng.next()
+                                                                  : rng.below(span + 1u));
+        }
+        default: {
+            // Close to the target.
+            const std::uint64_t center = offset(target());
+            const std::uint64_t spread = static_cast<std::uint64_t>(size);
+            const std::uint64_t low    = center - (spread < center ? spread : center);
+            const std::uint64_t high = center + (spread < span - center ? spread : span - center);
+            return from_offset(low + rng.below(high - low + 1u));
+        }
+        }
+    }
+
+    constexpr std::optional<T> shrink(T value, std::size_t index) const noexcept {
+        const std::uint64_t center   = offset(target());
+        const std::uint64_t current  = offset(value);
+        const std::uint64_t distance = current > center ? current - center : center - current;
+        if (index >= 64u || (distance >> index) == 0u) {
+            return {};
+        }
+
+        // Move towards the target: all the way first, then half the way, then 3/4 of the way, ...
+        const std::uint64_t new_distance = distance - (distance >> index);
+        return from_offset(current > center ? center + new_distance : center - new_distance);
+    }
+};
+
+template<floating_point T>
+struct generator<T> {
+    using value_type = T;
+
+    static constexpr std::size_t max_float_shrink_steps = 8u;
+
+    T min = -std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::max();
+
+    // The simplest value: zero, or the bound closest to zero.
+    constexpr T target() const noexcept {
+        return min > T{0} ? min : max < T{0} ? max : T{0};
+    }
+
+    constexpr T clamp(T value) const noexcept {
+        return value < min ? min : value > max ? max : value;
+    }
+
+    constexpr T generate(property_rng& rng, std::size_t size) const noexcept {
+        const T u = static_cast<T>(rng.unit());
+        switch (rng.below(8u)) {
+        case 0u: {
+            // Bounds and other special values.
+            const std::array<T, 6> special = {
+                min, max, target(), clamp(T{1}), clamp(T{-1}),
+                clamp(std::numeric_limits<T>::min())};
+            return special[rng.below(special.size())];
+        }
+        case 1u: {
+            // Anywhere in the range; written to avoid overflowing when the range is very wide.
+            return clamp(min * (T{1} - u) + max * u);
+        }
+        default: {
+            // Close to the target.
+            return clamp(target() + (T{2} * u - T{1}) * static_cast<T>(size));
+        }
+        }
+    }
+
+    constexpr std::optional<T> shrink(T value, std::size_t index) const noexcept {
+        const T center = target();
+        if (value == center) {
+            return {};
+        }
+
+        std::array<T, 2u + max_float_shrink_steps> candidates = {};
+        std::size_t                                count      = 0u;
+        candidates[count++]                                   = center;
+
+        // Drop the fractional part; values this large have none.
+        constexpr T integral_limit = static_cast<T>(std::uint64_t{1u} << 62u);
+        if (value > -integral_limit && value < integral_limit) {
+            const T truncated = static_cast<T>(static_cast<std::int64_t>(value));
+            if (truncated != value && truncated != center && truncated >= min &&
+                truncated <= max) {
+                candidates[count++] = truncated;
+            }
+        }
+
+        // Move towards the target: half the way, then 3/4 of the way, ...
+        T step = (value - center) / T{2};
+        for (std::size_t i = 0; i < max_float_shrink_steps; ++i, step /= T{2}) {
+            const T candidate = value - step;
+            if (candidate == value) {
+                break;
+            }
+
+            if (candidate != center) {
+                candidates[count++] = candidate;
+            }
+        }
+
+        if (index >= count) {
+            return {};
+        }
+
+        return candidates[index];
+    }
+};
+
+namespace impl {
+template<typename T>
+concept growable_range = requires(T& c, const T& cc, const typename T::value_type& v) {
+    c.push_back(v);
+    cc.begin();
+    cc.end();
+    { cc.size() } -> convertible_to<std::size_t>;
+};
+} // namespace impl
+
+// Containers are generated with a random length, and random elements. They are shrunk by removing
+// elements, then by shrinking each element.
+template<impl::growable_range T>
+struct generator<T> {
+    using value_type   = T;
+    using element_type = typename T::value_type;
+
+    generator<element_type> element  = {};
+    std::size_t             min_size = 0u;
+    std::size_t             max_size = max_property_size;
+
+    T generate(property_rng& rng, std::size_t size) const {
+        const std::size_t upper  = size < max_size ? size : max_size;
+        const std::size_t length = upper > min_size ? min_size + rng.below(upper - min_size + 1u)
+                                                    : min_size;
+
+        T result;
+        for (std::size_t i = 0; i < length; ++i) {
+            result.push_back(element.generate(rng, size));
+        }
+
+        return result;
+    }
+
+    std::optional<T> shrink(const T& value, std::size_t index) const {
+        const std::size_t length = value.size();
+
+        // Remove blocks of elements, largest blocks first.
+        for (std::size_t block = length; block > 0u; block /= 2u) {
+            if (length - block < min_size) {
+                continue;
+            }
+
+            const std::size_t count = (length + block - 1u) / block;
+            if (index < count) {
+                const std::size_t first = index * block;
+                T                 result;
+                std::size_t       i = 0;
+                for (const auto& e : value) {
+                    if (i < first || i >= first + block) {
+                        result.push_back(e);
+                    }
+                    ++i;
+                }
+
+                return result;
+            }
+
+            index -= count;
+        }
+
+        // Shrink each element.
+        std::size_t position = 0;
+        for (const auto& e : value) {
+            for (std::size_t j = 0;; ++j) {
+                auto candidate = element.shrink(e, j);
+                if (!candidate.has_value()) {
+                    break;
+                }
+
+                if (index == 0u) {
+                    T           result;
+                    std::size_t i = 0;
+                    for (const auto& other : value) {
+                        if (i == position) {
+                            result.push_back(candidate.value());
+                        } else {
+                            result.push_back(other);
+                        }
+                        ++i;
+                    }
+
+                    return result;
+                }
+
+                --index;
+            }
+
+            ++position;
+        }
+
+        return {};
+    }
+};
+
+template<typename T, typename... Args>
+constexpr generator<T> gen(Args&&... args) {
+    return generator<T>{std::forward<Args>(args)...};
+}
+
+struct property_config {
+    // Number of random inputs to try.
+    std::size_t runs = default_property_runs;
+    // Seed of the random number generator; if zero, derived from the name of the test case and
+    // the run seed (see '--rng-seed').
+    std::uint64_t seed = 0u;
+    // Maximum number of shrinking steps applied to a failing input.
+    std::size_t max_shrinks = max_property_shrinks;
+};
+} // namespace snitch
+
+namespace snitch::impl {
+// Number of threads to use for shrinking, in [1, max_property_threads].
+SNITCH_EXPORT std::size_t get_property_threads() noexcept;
+
+// Run 'func' in a muted copy of 'parent', on the calling thread. Returns false if it failed.
+SNITCH_EXPORT bool
+evaluate_property(test_state& parent, const function_ref<void()>& func) noexcept;
+
+// Call 'fails' for each index in [0, count), possibly in parallel. Returns the lowest index for
+// which it returned true, or 'count' if none did.
+// Requires: count <= max_property_threads.
+SNITCH_EXPORT std::size_t find_first_failure(
+    std::size_t count, const function_ref<bool(std::size_t) noexcept>& fails) noexcept;
+
+template<typename T>
+bool append_property_input(small_string_span ss, const T& value) noexcept {
+    if constexpr (string_appendable<T>) {
+        return append(ss, value);
+    } else if constexpr (requires { value.begin() != value.end(); }) {
+        if (!append(ss, "{")) {
+            return false;
+        }
+
+        bool first = true;
+        for (const auto& e : value) {
+            if (!first && !append(ss, ", ")) {
+                return false;
+            }
+
+            first = false;
+            if (!append_property_input(ss, e)) {
+                return false;
+            }
+        }
+
+        return append(ss, "}");
+    } else {
+        return append(ss, "?");
+    }
+}
+
+// Requires: number of captures < max_captures.
+template<typename... Args>
+scoped_capture add_property_inputs(test_state& state, const std::tuple<Args...>& inputs) {
+    auto& capture = add_capture(state);
+
+    bool first   = true;
+    bool success = append(capture, "inputs := (");
+    std::apply(
+        [&](const Args&... args) {
+            ((success = success && (first || append(capture, ", ")) &&
+                        append_property_input(capture, args),
+              first   = false),
+             ...);
+        },
+        inputs);
+
+    if (!success || !append(capture, ")")) {
+        truncate_end(capture);
+    }
+
+    return {state, 1u};
+}
+
+template<typename Inputs, typename Generators, std::size_t... I>
+std::optional<Inputs> shrink_property_input(
+    const Generators& generators,
+    const Inputs&     inputs,
+    std::size_t       position,
+    std::size_t       index,
+    std::index_sequence<I...>) {
+
+    std::optional<Inputs> result;
+    (
+        [&] {
+            if (I == position) {
+                auto candidate = std::get<I>(generators).shrink(std::get<I>(inputs), index);
+                if (candidate.has_value()) {
+                    result.emplace(inputs);
+                    std::get<I>(result.value()) = std::move(candidate.value());
+                }
+            }
+        }(),
+        ...);
+
+    return result;
+}
+} // namespace snitch::impl
+
+namespace snitch {
+// Check that 'body' passes for random inputs created by 'gens'. When an input fails, it is shrunk
+// to a simpler failing input, and 'body' is run one last time with it to report the failure.
+// Shrunk inputs are evaluated in parallel; 'body' must then be safe to run concurrently.
+template<typename F, property_generator... Gens>
+void check_property(const property_config& config, const F& body, const Gens&... gens) {
+    using inputs_type = std::tuple<typename Gens::value_type...>;
+
+    impl::test_state&   state = impl::get_current_test();
+    const std::uint64_t seed  = config.seed != 0u
+                                    ? config.seed
+                                    : impl::get_test_seed(state.reg.rng_seed, state.test.id);
+    property_rng rng{seed};
+
+    const auto holds = [&](const inputs_type& inputs) noexcept {
+        const auto call = [&]() { std::apply(body, inputs); };
+        return impl::evaluate_property(state, call);
+    };
+
+    for (std::size_t run = 0; run < config.runs; ++run) {
+        const std::size_t size = 1u + (run * (max_property_size - 1u)) / config.runs;
+        inputs_type       inputs{gens.generate(rng, size)...};
+        if (holds(inputs)) {
+            continue;
+        }
+
+        // Shrink: try candidates in batches, and keep the first one that still fails.
+        const std::tuple<const Gens&...> generators{gens...};
+        const std::size_t                threads  = impl::get_property_threads();
+        std::size_t                      shrinks  = 0u;
+        std::size_t                      position = 0u;
+        std::size_t                      index    = 0u;
+
+        std::array<std::optional<inputs_type>, max_property_threads> batch;
+        while (shrinks < config.max_shrinks) {
+            std::size_t count = 0u;
+            while (count < threads && position < sizeof...(Gens)) {
+                batch[count] = impl::shrink_property_input(
+                    generators, inputs, position, index, std::index_sequence_for<Gens...>{});
+                if (batch[count].has_value()) {
+                    ++count;
+                    ++index;
+                } else {
+                    ++position;
+                    index = 0u;
+                }
+            }
+
+            if (count == 0u) {
+                break;
+            }
+
+            const auto fails = [&](std::size_t i) noexcept { return !holds(batch[i].value()); };
+            const std::size_t failed = impl::find_first_failure(count, fails);
+            if (failed == count) {
+                continue;
+            }
+
+            inputs   = std::move(batch[failed].value());
+            position = 0u;
+            index    = 0u;
+            ++shrinks;
+        }
+
+        // Report the failure, and run the body again to report the failed checks.
+        const auto captures = impl::add_property_inputs(state, inputs);
+
+        small_string<max_message_length> message;
+        append_or_truncate(
+            message, "property falsified after ", run + 1u, " run(s) and ", shrinks,
+            " shrink(s); seed: ", seed);
+        state.in_check = true;
+        registry::report_assertion(false, message);
+        state.in_check = false;
+
+        std::apply(body, inputs);
+        return;
+    }
+
+    small_string<max_message_length> message;
+    append_or_truncate(message, "property held for ", config.runs, " run(s); seed: ", seed);
+    state.in_check = true;
+    registry::report_assertion(true, message);
+    state.in_check = false;
+}
+
+template<typename F, property_generator... Gens>
+void check_property(const F& body, const Gens&... gens) {
+    check_property(property_config{}, body, gens...);
+}
+} // namespace snitch
+
+namespace snitch::impl {
+template<typename F, typename... Gens>
+struct property_storage {
+    static inline std::optional<std::tuple<Gens...>> generators;
+};
+
+template<typename... Gens>
+struct property_registrar {
+    registry&           reg;
+    name_and_tags       id;
+    source_location     location;
+    std::tuple<Gens...> generators;
+
+    property_registrar(
+        registry& r, const name_and_tags& i, const source_location& l, const Gens&... g) :
+        reg(r), id(i), location(l), generators(g...) {}
+
+    // Requires: number of tests + 1 <= max_test_cases, well-formed test ID, F is a lambda
+    // without captures.
+    template<typename F>
+    const char* operator=(const F&) && {
+        static_assert(std::is_default_constructible_v<F>, "PROPERTY body must not capture");
+
+        property_storage<F, Gens...>::generators.emplace(std::move(generators));
+        return reg.add(id, location, []() {
+            std::apply(
+                [](const Gens&... g) { check_property(F{}, g...); },
+                property_storage<F, Gens...>::generators.value());
+        });
+    }
+};
+} // namespace snitch::impl
+
+#endif
@@ -3,13 +3,16 @@
 
 #include "snitch/snitch_any.hpp"
 #include "snitch/snitch_append.hpp"
+#include "snitch/snitch_cache.hpp"
 #include "snitch/snitch_cli.hpp"
 #include "snitch/snitch_config.hpp"
 #include "snitch/snitch_console.hpp"
+#include "snitch/snitch_durations.hpp"
 #include "snitch/snitch_error_handling.hpp"
 #include "snitch/snitch_expression.hpp"
 #include "snitch/snitch_file.hpp"
 #include "snitch/snitch_function.hpp"
+#include "snitch/snitch_profiler.hpp"
 #include "snitch/snitch_reporter_console.hpp"
 #include "snitch/snitch_string.hpp"
 #include "snitch/snitch_string_utility.hpp"
@@ -17,7 +20,13 @@
 #include "snitch/snitch_type_name.hpp"
 #include "snitch/snitch_vector.hpp"
 
+#include <array>
+#if SNITCH_WITH_MULTITHREADING
+#    include <atomic>
+#endif
 #include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string_view>
 #include <utility>
 
@@ -35,6 +44,8 @@ constexpr std::size_t max_tag_length = SNITCH_MAX_TAG_LENGTH;
 constexpr std::size_t max_unique_tags = SNITCH_MAX_UNIQUE_TAGS;
 // Maximum number of registered reporters to select from the command line.
 constexpr std::size_t max_registered_reporters = SNITCH_MAX_REGISTERED_REPORTERS;
+// Maximum number of reporters used at once (see repeated --reporter options).
+constexpr std::size_t max_active_reporters = SNITCH_MAX_ACTIVE_REPORTERS;
 // Maximum size of a reporter instance, in bytes.
 constexpr std::size_t max_reporter_size_bytes = SNITCH_MAX_REPORTER_SIZE_BYTES;
 // Is snitch disabled?
@@ -63,6 +74,24 @@ constexpr test_ptr to_test_case_ptr(const F&) noexcept {
 
 struct abort_exception {};
 
+#if SNITCH_WITH_LINKER_REGISTRATION
+// A test case registered at compile time (see 'SNITCH_WITH_LINKER_REGISTRATION').
+// Entries are constant-initialized, and a pointer to each is placed in the 'snitch_tests' linker
+// section; the registry adds them when it is first used, so no code runs before main().
+struct registration_entry {
+    // Adds the test case(s) described by the entry to the registry.
+    void (*add)(registry& reg, const registration_entry& entry) = nullptr;
+    // The fixture name is empty for test cases without fixture.
+    fixture_name_and_tags id       = {};
+    source_location       location = {};
+    // Only used for test cases without types.
+    test_ptr func = nullptr;
+};
+
+SNITCH_EXPORT void add_test_entry(registry& reg, const registration_entry& entry);
+SNITCH_EXPORT void add_fixture_entry(registry& reg, const registration_entry& entry);
+#endif
+
 SNITCH_EXPORT bool parse_colour_mode_option(registry& reg, std::string_view color_option) noexcept;
 SNITCH_EXPORT bool parse_color_option(registry& reg, std::string_view color_option) noexcept;
 } // namespace snitch::impl
@@ -105,6 +134,9 @@ struct registered_reporter {
         [](registry&, std::string_view, std::string_view) noexcept { return false; };
     report_function        callback = [](const registry&, const event::data&) noexcept {};
     finish_report_function finish   = [](registry&) noexcept {};
+    // Types of events sent to the reporter; other events are not sent, and the registry does not
+    // build them if no active reporter needs them.
+    event::mask events = event::all_events;
 };
 
 template<typename T>
@@ -114,6 +146,16 @@ concept reporter_type = requires(registry& reg) {
     { rep.configure(reg, k, v) } -> convertible_to<bool>;
 } && requires(T& rep, const registry& reg, const event::data& e) { rep.report(reg, e); };
 
+// Types of events needed by the reporter 'T', given by its optional 'event_mask' static member.
+template<typename T>
+constexpr event::mask reporter_event_mask = [] {
+    if constexpr (requires { requires convertible_to<decltype(T::event_mask), event::mask>; }) {
+        return event::mask{T::event_mask};
+    } else {
+        return event::all_events;
+    }
+}();
+
 class registry {
     // Contains all registered test cases.
     small_vector<impl::test_case, max_test_cases> test_list;
@@ -121,25 +163,81 @@ class registry {
     // Contains all registered reporters.
     small_vector<registered_reporter, max_registered_reporters> registered_reporters;
 
+    // Test cases selected for the current run, in the order in which they are run (see '--order').
+    // This can be large, so it is kept here rather than on the stack.
+    struct selected_test {
+        impl::test_case* test = nullptr;
+        // Sort key, for the random order.
+        std::uint64_t key = 0u;
+    };
+
+    small_vector<selected_test, max_test_cases> selected_tests;
+
+    // Totals of the current test run. They are kept here rather than on the stack, so the run can
+    // still be ended if a test case times out (see '--test-timeout').
+    event::test_run_ended run_totals;
+
+#if SNITCH_WITH_TIMINGS
+    // Start time of the current test run.
+    time_point_t run_start = {};
+#endif
+
     // Used when writing output to file.
     std::optional<impl::file_writer> file_writer;
 
-    // Type-erased storage for the current reporter instance.
-    inplace_any<max_reporter_size_bytes> reporter_storage;
+#if SNITCH_WITH_TIMINGS
+    // Used when writing a section timing profile to file.
+    std::optional<impl::profiler> profiler;
+
+    // Used when printing test case durations and the slowest test cases and sections.
+    std::optional<impl::duration_tracker> durations;
+#endif
+
+    // Used to skip tests which passed in previous runs (see '--cache').
+    std::optional<impl::result_cache> cache;
+
+    // Number of failed assertions in the current test run, and true once it reached 'abort_after'.
+    // Assertions may be reported from other threads than the one running the tests.
+#if SNITCH_WITH_MULTITHREADING
+    std::atomic<std::size_t> run_failures = 0u;
+    std::atomic<bool>        aborting     = false;
+#else
+    std::size_t run_failures = 0u;
+    bool        aborting     = false;
+#endif
+
+    // Type-erased storage for the current reporter instances, one for each active reporter.
+    std::array<inplace_any<max_reporter_size_bytes>, max_active_reporters> reporter_storage;
+
+    // Index of the active reporter currently being initialized, configured, or notified.
+    std::size_t current_reporter = 0;
+
+#if SNITCH_WITH_LINKER_REGISTRATION
+    // True once the test cases of the 'snitch_tests' linker section have been added.
+    bool linked_tests_loaded = false;
+#endif
+
+    // Add the test cases registered in the linker section, if not done already. Const, so test
+    // cases can be listed from a const registry; they are only ever added to the global registry,
+    // which is not const.
+    SNITCH_EXPORT void load_linked_tests() const noexcept;
+
+    // Tell the reporters the test run is over, and close the output files.
+    SNITCH_EXPORT void finish_run() noexcept;
 
     template<typename T>
     void initialize_reporter(registry&) noexcept {
-        this->reporter_storage.emplace<T>(*this);
+        this->reporter_storage[current_reporter].emplace<T>(*this);
     }
 
     template<typename T>
     void report(const registry&, const event::data& e) noexcept {
-        this->reporter_storage.get<T>().report(*this, e);
+        this->reporter_storage[current_reporter].get<T>().report(*this, e);
     }
 
     template<typename T>
     bool configure_reporter(registry&, std::string_view k, std::string_view v) noexcept {
-        return this->reporter_storage.get<T>().configure(*this, k, v);
+        return this->reporter_storage[current_reporter].get<T>().configure(*this, k, v);
     }
 
     SNITCH_EXPORT void destroy_reporter(registry&) noexcept;
@@ -150,6 +248,47 @@ public:
     enum class verbosity { quiet, normal, high, full } verbose = verbosity::normal;
     bool with_color                                            = SNITCH_DEFAULT_WITH_COLOR == 1;
 
+    // Order in which the selected test cases are run (see '--order').
+    enum class test_order { declaration, lexical, random } order = test_order::declaration;
+    // Seed of the random test order and of the test random number generators (see '--rng-seed').
+    std::uint64_t rng_seed = 0u;
+    // Maximum number of times a failed test case is run again (see '--retry').
+    std::size_t max_retries = 0u;
+    // Number of failed assertions after which the test run is aborted (see '--abort' and
+    // '--abortx'); zero to never abort.
+    std::size_t abort_after = 0u;
+    // Default timeout of each test case, in milliseconds, unless set with a "[!timeout=...]" tag
+    // (see '--test-timeout'); zero for no timeout.
+    std::uint64_t test_timeout_ms = 0u;
+    // Print how long the application took to start and run its first test case, at the end of
+    // the run (see '--startup-stats'); requires SNITCH_WITH_TIMINGS.
+    bool startup_stats = false;
+
+private:
+    // A reporter selected with --reporter, when more than one is used in the same run.
+    struct active_reporter {
+        report_function        callback   = [](const registry&, const event::data&) noexcept {};
+        finish_report_function finish     = [](registry&) noexcept {};
+        verbosity              verbose    = verbosity::normal;
+        event::mask            events     = event::all_events;
+        bool                   with_color = false;
+
+        // Used when writing the output of this reporter to its own file (see '::out=path').
+        std::optional<impl::file_writer> file_writer;
+    };
+
+    // Contains all active reporters; empty if a single reporter is used.
+    small_vector<active_reporter, max_active_reporters> active_reporters;
+
+    SNITCH_EXPORT void configure_reporters(
+        small_vector_span<const std::string_view> reporters, bool color_override) noexcept;
+
+    SNITCH_EXPORT void report_all(const registry&, const event::data& e) noexcept;
+
+    SNITCH_EXPORT void finish_all(registry&) noexcept;
+
+public:
+
     using print_function             = snitch::print_function;
     using initialize_report_function = snitch::initialize_report_function;
     using configure_report_function  = snitch::configure_report_function;
@@ -160,6 +299,9 @@ public:
     report_function        report_callback = {*this, constant<&registry::report_default>{}};
     finish_report_function finish_callback = [](registry&) noexcept {};
 
+    // Types of events sent to 'report_callback'; set from the selected reporters.
+    event::mask report_events = event::all_events;
+
     // Internal API; do not use.
     template<typename T>
     void append_or_print(small_string<max_message_length>& ss, T&& value) const noexcept {
@@ -200,13 +342,39 @@ public:
         this->print_callback(str);
     }
 
+    // Internal API; do not use.
+    // Counts a failed assertion towards 'abort_after'.
+    SNITCH_EXPORT void count_failure() noexcept;
+
+    // Returns true if the test run is being aborted; the remaining tests and sections are skipped.
+    SNITCH_EXPORT bool is_aborting() const noexcept;
+
+    // Internal API; do not use.
+    // Report the test case run by 'state' as failed with 'message', at its last known location,
+    // then end the test run and close the output files. Called from the thread running the test
+    // case when it ran for longer than 'timeout_ms' (see '--test-timeout'); it is never resumed.
+    SNITCH_EXPORT void end_timed_out_run(
+        const impl::test_state& state, std::uint64_t timeout_ms, std::string_view message) noexcept;
+
+    // Internal API; do not use.
+    // Returns the file the output of the current reporter is written to (see '--out' and
+    // '::out=path'), or nullptr if none, or if the file is shared with other reporters.
+    SNITCH_EXPORT const impl::file_writer* output_file() const noexcept;
+
+#if SNITCH_WITH_TIMINGS
+    // Internal API; do not use.
+    // Returns the durations of the current test run (see '--durations'), or nullptr if disabled.
+    SNITCH_EXPORT const impl::duration_tracker* test_durations() const noexcept;
+#endif
+
     // Requires: number of reporters + 1 <= max_registered_reporters.
     SNITCH_EXPORT std::string_view add_reporter(
         std::string_view                                 name,
         const std::optional<initialize_report_function>& initialize,
         const std::optional<configure_report_function>&  configure,
         const report_function&                           report,
-        const std::optional<finish_report_function>&     finish);
+        const std::optional<finish_report_function>&     finish,
+        event::mask                                      events = event::all_events);
 
     // Requires: number of reporters + 1 <= max_registered_reporters.
     template<reporter_type T>
@@ -215,7 +383,8 @@ public:
             name, initialize_report_function{*this, constant<&registry::initialize_reporter<T>>{}},
             configure_report_function{*this, constant<&registry::configure_reporter<T>>{}},
             report_function{*this, constant<&registry::report<T>>{}},
-            finish_report_function{*this, constant<&registry::destroy_reporter>{}});
+            finish_report_function{*this, constant<&registry::destroy_reporter>{}},
+            reporter_event_mask<T>);
     }
 
     // Internal API; do not use.
@@ -300,7 +469,11 @@ public:
     SNITCH_EXPORT static void report_section_ended(const section& sec) noexcept;
 
     // Internal API; do not use.
-    SNITCH_EXPORT impl::test_state run(impl::test_case& test) noexcept;
+    SNITCH_EXPORT static void report_section_exited(section_info sections) noexcept;
+
+    // Internal API; do not use.
+    // 'retries' is the number of previous runs of this test case which failed.
+    SNITCH_EXPORT impl::test_state run(impl::test_case& test, std::size_t retries = 0u) noexcept;
 
     // Internal API; do not use.
     SNITCH_EXPORT bool run_tests(std::string_view run_name) noexcept;
@@ -0,0 +1,49 @@
+#ifndef SNITCH_REPORTER_BINARY_HPP
+#define SNITCH_REPORTER_BINARY_HPP
+
+#include "snitch/snitch_config.hpp"
+
+#if SNITCH_WITH_BINARY_REPORTER || SNITCH_WITH_ALL_REPORTERS
+
+#    include "snitch/snitch_test_data.hpp"
+
+#    include <array>
+#    include <cstddef>
+#    include <cstdint>
+#    include <string_view>
+
+namespace snitch {
+// Maximum number of distinct strings remembered by the binary reporter (test names, file paths,
+// ...).
+constexpr std::size_t max_interned_strings = SNITCH_MAX_INTERNED_STRINGS;
+} // namespace snitch
+
+namespace snitch::reporter::binary {
+// Hashes of the strings stored in each interning slot, as seen by the reader; zero if empty.
+using interned_table = std::array<std::uint64_t, max_interned_strings>;
+
+struct reporter {
+    // Interning table of this reporter, or null if all tables are in use by other instances,
+    // in which case all strings are written inline.
+    interned_table* interned_hashes = nullptr;
+
+    SNITCH_EXPORT explicit reporter(registry& r) noexcept;
+
+    reporter(const reporter&)            = delete;
+    reporter& operator=(const reporter&) = delete;
+
+    SNITCH_EXPORT ~reporter() noexcept;
+
+    SNITCH_EXPORT bool configure(registry&, std::string_view, std::string_view) noexcept;
+
+    SNITCH_EXPORT void report(const registry& r, const snitch::event::data& event) noexcept;
+};
+
+// Decode a log written by the binary reporter, and send each event to the reporter of 'r',
+// filtered by its verbosity. Returns false if the log is malformed; events decoded before the
+// error are still reported.
+SNITCH_EXPORT bool replay(const registry& r, std::string_view log) noexcept;
+} // namespace snitch::reporter::binary
+
+#endif
+#endif
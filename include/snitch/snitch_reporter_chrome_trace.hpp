@@ -0,0 +1,29 @@
+#ifndef SNITCH_REPORTER_CHROME_TRACE_HPP
+#define SNITCH_REPORTER_CHROME_TRACE_HPP
+
+#include "snitch/snitch_config.hpp"
+
+#if (SNITCH_WITH_CHROME_TRACE_REPORTER || SNITCH_WITH_ALL_REPORTERS) && SNITCH_WITH_TIMINGS
+
+#    include "snitch/snitch_test_data.hpp"
+
+#    include <string_view>
+
+namespace snitch::reporter::chrome_trace {
+struct reporter {
+    // Successful assertions are not part of the trace, so the registry can skip them.
+    static constexpr event::mask event_mask =
+        event::all_events & ~event::mask_for<event::assertion_succeeded>;
+
+    bool first_event = true;
+
+    SNITCH_EXPORT explicit reporter(registry& r) noexcept;
+
+    SNITCH_EXPORT bool configure(registry&, std::string_view, std::string_view) noexcept;
+
+    SNITCH_EXPORT void report(const registry& r, const snitch::event::data& event) noexcept;
+};
+} // namespace snitch::reporter::chrome_trace
+
+#endif
+#endif
@@ -0,0 +1,44 @@
+#ifndef SNITCH_REPORTER_JUNIT_HPP
+#define SNITCH_REPORTER_JUNIT_HPP
+
+#include "snitch/snitch_config.hpp"
+
+#if SNITCH_WITH_JUNIT_REPORTER || SNITCH_WITH_ALL_REPORTERS
+
+#    include "snitch/snitch_test_data.hpp"
+
+#    include <cstddef>
+#    include <string_view>
+
+namespace snitch::reporter::junit {
+struct reporter {
+    // Section events and successful assertions are not reported, so the registry can skip them.
+    static constexpr event::mask event_mask = event::mask_for<
+        event::test_run_started,
+        event::test_run_ended,
+        event::test_case_started,
+        event::test_case_ended,
+        event::test_case_skipped,
+        event::assertion_failed,
+        event::test_case_listed>;
+
+    // Position in the output file of the space reserved for the test suite totals, which are
+    // written there at the end of the run. Zero if the output cannot be patched (e.g., standard
+    // output), in which case the totals are written at the end of the test suite instead.
+    std::size_t suite_totals_position = 0;
+
+#    if SNITCH_WITH_TIMINGS
+    // Same as above, for the duration of the current test case.
+    std::size_t test_case_time_position = 0;
+#    endif
+
+    SNITCH_EXPORT explicit reporter(registry& r) noexcept;
+
+    SNITCH_EXPORT bool configure(registry&, std::string_view, std::string_view) noexcept;
+
+    SNITCH_EXPORT void report(const registry& r, const snitch::event::data& event) noexcept;
+};
+} // namespace snitch::reporter::junit
+
+#endif
+#endif
@@ -10,6 +10,10 @@
 #    include <string_view>
 
 namespace snitch::reporter::teamcity {
+// The start and end of a test listing are not reported, so the registry can skip them.
+constexpr event::mask event_mask =
+    event::all_events & ~event::mask_for<event::list_test_run_started, event::list_test_run_ended>;
+
 SNITCH_EXPORT void initialize(registry& r) noexcept;
 
 SNITCH_EXPORT void report(const registry& r, const snitch::event::data& event) noexcept;
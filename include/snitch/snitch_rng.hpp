@@ -0,0 +1,94 @@
+#ifndef SNITCH_RNG_HPP
+#define SNITCH_RNG_HPP
+
+#include "snitch/snitch_config.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace snitch {
+struct test_id;
+} // namespace snitch
+
+namespace snitch::impl {
+// Advances 'state' and returns the next output of SplitMix64.
+constexpr std::uint64_t splitmix64(std::uint64_t& state) noexcept {
+    state += 0x9e3779b97f4a7c15u;
+    std::uint64_t z = state;
+    z               = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9u;
+    z               = (z ^ (z >> 27u)) * 0x94d049bb133111ebu;
+    return z ^ (z >> 31u);
+}
+} // namespace snitch::impl
+
+namespace snitch {
+// Pseudo-random number generator (xoshiro256**), fast and with a small state.
+// It satisfies the UniformRandomBitGenerator requirements, so it can be used with the standard
+// distributions and algorithms (std::uniform_int_distribution, std::shuffle, ...).
+class rng_engine {
+    std::array<std::uint64_t, 4> state = {};
+
+    static constexpr std::uint64_t rotl(std::uint64_t x, unsigned int k) noexcept {
+        return (x << k) | (x >> (64u - k));
+    }
+
+public:
+    using result_type = std::uint64_t;
+
+    constexpr rng_engine() noexcept {
+        seed(0u);
+    }
+
+    constexpr explicit rng_engine(std::uint64_t value) noexcept {
+        seed(value);
+    }
+
+    // The state is expanded from the seed with SplitMix64, so it is never all zeros.
+    constexpr void seed(std::uint64_t value) noexcept {
+        for (auto& s : state) {
+            s = impl::splitmix64(value);
+        }
+    }
+
+    static constexpr result_type min() noexcept {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr result_type operator()() noexcept {
+        const std::uint64_t result = rotl(state[1] * 5u, 7u) * 9u;
+        const std::uint64_t t      = state[1] << 17u;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45u);
+
+        return result;
+    }
+
+    constexpr bool operator==(const rng_engine&) const noexcept = default;
+};
+
+// Returns the random number generator of the current test case.
+// It is reseeded from the run seed (see '--rng-seed') and the full name of the test case before
+// each run through the test case, so the numbers drawn by a test case do not depend on which
+// other tests were run, or in which order.
+SNITCH_EXPORT rng_engine& rng() noexcept;
+} // namespace snitch
+
+namespace snitch::impl {
+// Returns the seed of a test case, derived from the run seed and the full test name; never zero.
+SNITCH_EXPORT std::uint64_t get_test_seed(std::uint64_t run_seed, const test_id& id) noexcept;
+
+// Returns a new non-zero seed, from the current time.
+SNITCH_EXPORT std::uint64_t make_random_seed() noexcept;
+} // namespace snitch::impl
+
+#endif
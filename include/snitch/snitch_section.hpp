@@ -2,6 +2,7 @@
 #define SNITCH_SECTION_HPP
 
 #include "snitch/snitch_config.hpp"
+#include "snitch/snitch_function.hpp"
 #include "snitch/snitch_test_data.hpp"
 
 namespace snitch::impl {
@@ -16,6 +17,9 @@ struct section_entry_checker {
     // Requires: number of sections < max_nested_sections.
     SNITCH_EXPORT explicit operator bool();
 };
+
+// Run 'func' repeatedly, until each of its leaf sections has been executed once.
+SNITCH_EXPORT void run_sections(test_state& state, const function_ref<void()>& func);
 } // namespace snitch::impl
 
 #endif
@@ -0,0 +1,46 @@
+#ifndef SNITCH_STARTUP_STATS_HPP
+#define SNITCH_STARTUP_STATS_HPP
+
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_time.hpp"
+
+#include <cstddef>
+#include <optional>
+
+#if SNITCH_WITH_TIMINGS
+
+namespace snitch::impl {
+// Phases between the start of the test application and the end of the first test case.
+enum class startup_phase : std::size_t {
+    // From the first test case registration until the command line is parsed; this includes
+    // other static initializers, if any. With SNITCH_WITH_LINKER_REGISTRATION, this is the time
+    // spent adding the test cases of the linker section instead.
+    registration,
+    // Call to 'cli::parse_arguments()'.
+    parse_arguments,
+    // Call to 'registry::configure()'.
+    configure,
+    // Run of the first test case, including all its sections.
+    first_test_case,
+    count
+};
+
+struct startup_timing {
+    std::optional<time_point_t> start = {};
+    std::optional<time_point_t> end   = {};
+};
+
+// Record the start or the end of a phase at the current time. Only the first call for each phase
+// is recorded; the end is ignored if the phase was not started.
+SNITCH_EXPORT void start_startup_phase(startup_phase phase) noexcept;
+SNITCH_EXPORT void end_startup_phase(startup_phase phase) noexcept;
+
+// Overwrite the recorded start and end of a phase.
+SNITCH_EXPORT void
+set_startup_phase(startup_phase phase, time_point_t start, time_point_t end) noexcept;
+
+SNITCH_EXPORT startup_timing get_startup_phase(startup_phase phase) noexcept;
+} // namespace snitch::impl
+
+#endif
+#endif
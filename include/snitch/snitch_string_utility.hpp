@@ -6,6 +6,8 @@
 #include "snitch/snitch_string.hpp"
 
 #include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string_view>
 #include <utility>
 
@@ -65,10 +67,18 @@ SNITCH_EXPORT [[nodiscard]] bool replace_all(
 SNITCH_EXPORT [[nodiscard]] bool escape_all_or_truncate(
     small_string_span string, std::string_view pattern, std::string_view replacement);
 
+// Escape a string for use in a JSON string literal: quotes, backslashes, and all control
+// characters ("\\n", "\\r", "\\t", or "\\u00XX" for the others).
+SNITCH_EXPORT [[nodiscard]] bool escape_json_or_truncate(small_string_span string);
+
 SNITCH_EXPORT [[nodiscard]] std::size_t
 find_first_not_escaped(std::string_view str, char c) noexcept;
 
 SNITCH_EXPORT [[nodiscard]] bool is_match(std::string_view string, std::string_view regex) noexcept;
+
+// Parse a decimal number; returns an empty optional if invalid or out of range.
+SNITCH_EXPORT [[nodiscard]] std::optional<std::uint64_t>
+parse_unsigned(std::string_view str) noexcept;
 } // namespace snitch
 
 #endif
@@ -2,13 +2,17 @@
 #define SNITCH_TEST_DATA_HPP
 
 #include "snitch/snitch_config.hpp"
+#include "snitch/snitch_rng.hpp"
 #include "snitch/snitch_string.hpp"
 #include "snitch/snitch_time.hpp"
 #include "snitch/snitch_vector.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string_view>
+#include <type_traits>
+#include <variant>
 
 namespace snitch {
 class registry;
@@ -61,6 +65,33 @@ struct section {
 #endif
 };
 
+#if SNITCH_WITH_PERF_COUNTERS
+/// Hardware performance counters, measured while running a test case
+/// A counter is empty if it is not supported, or if reading it is not permitted.
+struct perf_counters {
+    /// Number of instructions retired
+    std::optional<std::uint64_t> instructions = {};
+    /// Number of CPU cycles
+    std::optional<std::uint64_t> cycles = {};
+    /// Number of cache misses
+    std::optional<std::uint64_t> cache_misses = {};
+    /// Number of mispredicted branches
+    std::optional<std::uint64_t> branch_misses = {};
+};
+#endif
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+/// Heap allocations made by the thread running a test case
+struct allocation_stats {
+    /// Number of allocations
+    std::size_t count = 0;
+    /// Total number of bytes allocated
+    std::size_t bytes = 0;
+    /// Maximum number of bytes allocated and not yet freed, at any point in the test case
+    std::size_t peak = 0;
+};
+#endif
+
 /// List of test case filters
 using filter_info = small_vector_span<const std::string_view>;
 /// List of active sections (in increasing nesting level)
@@ -122,6 +153,8 @@ struct test_run_started {
     std::string_view name = {};
     /// List of test case filters, as given in the command-line arguments
     filter_info filters = {};
+    /// Seed of the random number generators and of the random test order (see '--rng-seed')
+    std::uint64_t rng_seed = 0u;
 };
 
 /// Fired at the end of a test run (application finished)
@@ -139,6 +172,8 @@ struct test_run_ended {
     std::size_t allowed_fail_count = 0;
     /// Counts all skipped test cases
     std::size_t skip_count = 0;
+    /// Counts all test cases which failed, and then passed when run again (see '--retry')
+    std::size_t flaky_count = 0;
 
     /// Counts all assertions; passed, failed, or allowed failed
     std::size_t assertion_count = 0;
@@ -154,6 +189,9 @@ struct test_run_ended {
 
     /// True if all tests passed, or all failures were allowed
     bool success = true;
+    /// True if the run stopped early after too many failures (see '--abort'), or because a test
+    /// case timed out (see '--test-timeout'); the remaining test cases were not run
+    bool aborted = false;
 };
 
 /// Fired at the start of a test case
@@ -162,6 +200,9 @@ struct test_case_started {
     const test_id& id;
     /// Test location
     const source_location& location;
+
+    /// Number of previous runs of this test case which failed, in this test run (see '--retry')
+    std::size_t retries = 0;
 };
 
 /// Fired at the end of a test case
@@ -180,12 +221,26 @@ struct test_case_ended {
 
     /// Test result
     test_case_state state = test_case_state::success;
+    /// Number of previous runs of this test case which failed, in this test run (see '--retry')
+    std::size_t retries = 0;
+    /// True if this run failed, and the test case will be run again (see '--retry')
+    bool will_retry = false;
 
 #if SNITCH_WITH_TIMINGS
     /// Test case duration, in seconds
     float duration = 0.0f;
 #endif
 
+#if SNITCH_WITH_PERF_COUNTERS
+    /// Hardware performance counters
+    perf_counters counters = {};
+#endif
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+    /// Heap allocations
+    allocation_stats allocations = {};
+#endif
+
     bool failure_expected = false;
     bool failure_allowed  = false;
 };
@@ -225,8 +280,9 @@ struct assertion_failed {
     capture_info              captures = {};
     const assertion_location& location;
     assertion_data            data     = {};
-    bool                      expected = false; /// [!shouldfail]
-    bool                      allowed  = false; /// [!mayfail]
+    bool                      expected  = false; /// [!shouldfail]
+    bool                      allowed   = false; /// [!mayfail]
+    bool                      may_retry = false; /// test case run again if this run fails (--retry)
 };
 
 struct assertion_succeeded {
@@ -282,6 +338,32 @@ using data = std::variant<
     list_test_run_started,
     list_test_run_ended,
     test_case_listed>;
+
+/// Set of event types, with one bit for each alternative of 'data'
+using mask = std::uint32_t;
+
+static_assert(std::variant_size_v<data> <= sizeof(mask) * 8u, "too many event types for mask");
+
+/// Mask containing all event types
+constexpr mask all_events = ~mask{0};
+
+/// Mask containing only the event type 'E'
+template<typename E>
+constexpr mask mask_bit = []<typename... Events>(const std::variant<Events...>*) {
+    static_assert((std::is_same_v<E, Events> || ...), "not an event type");
+    std::size_t index = 0;
+    static_cast<void>(((std::is_same_v<E, Events> || (++index, false)) || ...));
+    return mask{1} << index;
+}(static_cast<const data*>(nullptr));
+
+/// Mask containing the event types 'Events'
+template<typename... Events>
+constexpr mask mask_for = (mask_bit<Events> | ... | mask{0});
+
+/// Mask containing the type of the event 'e'
+constexpr mask mask_of(const data& e) noexcept {
+    return mask{1} << e.index();
+}
 } // namespace snitch::event
 
 namespace snitch {
@@ -346,6 +428,19 @@ struct test_state {
     bool        should_fail      = false;
     bool        in_check         = false;
 
+    // Assertions are counted but not sent to the reporters (used when evaluating properties).
+    bool muted = false;
+
+    // Number of previous runs of this test case which failed (see '--retry').
+    std::size_t retries = 0;
+
+    // The test case will be run again if this run fails (see '--retry'), so its failures are not
+    // counted towards the abort limit.
+    bool may_retry = false;
+
+    // Random number generator returned by 'snitch::rng()'.
+    rng_engine rng = {};
+
 #if SNITCH_WITH_EXCEPTIONS
     bool unhandled_exception = false;
 #endif
@@ -353,6 +448,14 @@ struct test_state {
 #if SNITCH_WITH_TIMINGS
     float duration = 0.0f;
 #endif
+
+#if SNITCH_WITH_PERF_COUNTERS
+    perf_counters counters = {};
+#endif
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+    allocation_stats allocations = {};
+#endif
 };
 
 SNITCH_EXPORT test_state& get_current_test() noexcept;
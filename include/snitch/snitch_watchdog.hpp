@@ -0,0 +1,45 @@
+#ifndef SNITCH_WATCHDOG_HPP
+#define SNITCH_WATCHDOG_HPP
+
+#include "snitch/snitch_config.hpp"
+#include "snitch/snitch_test_data.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace snitch::impl {
+// Called from the watchdog thread when a test case runs for longer than its timeout, with the
+// timeout in milliseconds.
+using timeout_handler = void (*)(const test_state& state, std::uint64_t timeout_ms) noexcept;
+
+// Start watching the test case run by 'state' on the calling thread, which must stay alive until
+// 'unwatch_test()' is called. If it is still watched after 'timeout_ms' milliseconds, it is flagged
+// as timed out (see 'check_timeout()'); if it is still watched one second later, 'handler' is
+// called once from the watchdog thread. Only one test case is watched at a time; watching another
+// one replaces it. Without SNITCH_WITH_MULTITHREADING, this does nothing.
+SNITCH_EXPORT void
+watch_test(const test_state& state, std::uint64_t timeout_ms, timeout_handler handler) noexcept;
+
+// Stop watching the current test case, if any.
+SNITCH_EXPORT void unwatch_test() noexcept;
+
+// Called from the thread running the test case, at each assertion and section. If the test case
+// is flagged as timed out, report it as failed at its last known location, end the test run and
+// close the output files, then print the name and the last known location of the test case, and
+// terminate the test application. Otherwise, does nothing.
+SNITCH_EXPORT void check_timeout(const test_state& state) noexcept;
+
+// Default timeout handler, for test cases which did not reach 'check_timeout()' in time: print the
+// name of the test case to the standard error, and terminate the test application. The test case
+// is still running on another thread, so neither the reporters nor the output files are touched,
+// and its stack is not printed.
+[[noreturn]] SNITCH_EXPORT void
+report_timeout(const test_state& state, std::uint64_t timeout_ms) noexcept;
+
+// Parse a timeout, as a number of seconds ("5", "5s") or milliseconds ("500ms"), returned in
+// milliseconds. Returns an empty optional if invalid, or zero.
+SNITCH_EXPORT std::optional<std::uint64_t> parse_timeout(std::string_view value) noexcept;
+} // namespace snitch::impl
+
+#endif
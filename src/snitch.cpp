@@ -1,16 +1,29 @@
+#include "snitch_allocations.cpp"
 #include "snitch_append.cpp"
+#include "snitch_cache.cpp"
 #include "snitch_capture.cpp"
 #include "snitch_cli.cpp"
+#include "snitch_compression.cpp"
 #include "snitch_console.cpp"
+#include "snitch_durations.cpp"
 #include "snitch_error_handling.cpp"
 #include "snitch_file.cpp"
 #include "snitch_main.cpp"
 #include "snitch_matcher.cpp"
+#include "snitch_perf_counters.cpp"
+#include "snitch_profiler.cpp"
+#include "snitch_property.cpp"
 #include "snitch_registry.cpp"
+#include "snitch_reporter_binary.cpp"
 #include "snitch_reporter_catch2_xml.cpp"
+#include "snitch_reporter_chrome_trace.cpp"
 #include "snitch_reporter_console.cpp"
+#include "snitch_reporter_junit.cpp"
 #include "snitch_reporter_teamcity.cpp"
+#include "snitch_rng.cpp"
 #include "snitch_section.cpp"
+#include "snitch_startup_stats.cpp"
 #include "snitch_string_utility.cpp"
 #include "snitch_test_data.cpp"
 #include "snitch_time.cpp"
+#include "snitch_watchdog.cpp"
@@ -0,0 +1,240 @@
+#include "snitch/snitch_allocations.hpp"
+
+#include "snitch/snitch_append.hpp"
+#include "snitch/snitch_registry.hpp"
+#include "snitch/snitch_string.hpp"
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+
+#    include <cstdint> // for std::uintptr_t
+#    include <cstdlib> // for std::malloc, std::free
+#    include <exception> // for std::terminate, std::uncaught_exceptions
+#    include <limits> // for std::numeric_limits
+#    include <new> // for std::bad_alloc, std::align_val_t, std::nothrow_t
+
+namespace snitch::impl {
+namespace {
+SNITCH_THREAD_LOCAL allocation_counters thread_allocation_counters;
+
+// Stored just before each allocated block, so it can be freed and accounted for without
+// knowing its size or alignment.
+struct allocation_header {
+    void*       raw  = nullptr;
+    std::size_t size = 0;
+};
+
+constexpr std::size_t default_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+void* tracked_allocate(std::size_t size, std::size_t alignment) noexcept {
+    if (alignment < default_alignment) {
+        alignment = default_alignment;
+    }
+
+    // malloc() is aligned for any fundamental type, so only over-aligned types need padding.
+    const std::size_t header_size =
+        (sizeof(allocation_header) + default_alignment - 1) / default_alignment * default_alignment;
+    const std::size_t padding = alignment > default_alignment ? alignment : 0u;
+
+    if (size > std::numeric_limits<std::size_t>::max() - header_size - padding) {
+        return nullptr;
+    }
+
+    void* raw = std::malloc(size + header_size + padding);
+    if (raw == nullptr) {
+        return nullptr;
+    }
+
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(raw) + header_size;
+    void* user = reinterpret_cast<void*>((first + alignment - 1) / alignment * alignment);
+
+    new (static_cast<allocation_header*>(user) - 1) allocation_header{.raw = raw, .size = size};
+
+    allocation_counters& counters = thread_allocation_counters;
+    ++counters.count;
+    counters.bytes += size;
+    counters.current += size;
+    if (counters.current > counters.peak) {
+        counters.peak = counters.current;
+    }
+
+    return user;
+}
+
+void* tracked_allocate_or_throw(std::size_t size, std::size_t alignment) {
+    void* user = tracked_allocate(size, alignment);
+    if (user == nullptr) {
+#    if SNITCH_WITH_EXCEPTIONS
+        throw std::bad_alloc{};
+#    else
+        std::terminate();
+#    endif
+    }
+
+    return user;
+}
+
+void tracked_free(void* user) noexcept {
+    if (user == nullptr) {
+        return;
+    }
+
+    const allocation_header header = static_cast<allocation_header*>(user)[-1];
+
+    // The block may have been allocated by another thread.
+    allocation_counters& counters = thread_allocation_counters;
+    counters.current -= header.size < counters.current ? header.size : counters.current;
+
+    std::free(header.raw);
+}
+} // namespace
+
+allocation_counters& get_allocation_counters() noexcept {
+    return thread_allocation_counters;
+}
+
+allocation_scope::allocation_scope() noexcept : start(thread_allocation_counters) {
+    // Measure the peak from the current level.
+    thread_allocation_counters.peak = thread_allocation_counters.current;
+}
+
+allocation_scope::~allocation_scope() noexcept {
+    // Restore the peak of the enclosing scope, if it was higher.
+    if (start.peak > thread_allocation_counters.peak) {
+        thread_allocation_counters.peak = start.peak;
+    }
+}
+
+allocation_stats allocation_scope::stop() const noexcept {
+    const allocation_counters& counters = thread_allocation_counters;
+    return {
+        .count = counters.count - start.count,
+        .bytes = counters.bytes - start.bytes,
+        .peak  = counters.peak - start.current};
+}
+
+no_allocation_checker::no_allocation_checker(const source_location& loc) noexcept :
+    location(loc) {
+#    if SNITCH_WITH_EXCEPTIONS
+    exceptions_at_start = std::uncaught_exceptions();
+#    endif
+}
+
+no_allocation_checker::~no_allocation_checker() noexcept {
+    if (done) {
+        return;
+    }
+
+#    if SNITCH_WITH_EXCEPTIONS
+    if (std::uncaught_exceptions() > exceptions_at_start) {
+        // Leaving the block because of an exception; the block did not complete.
+        return;
+    }
+#    endif
+
+    // Leaving the block early (with 'break', 'return', ...); the check is still reported, but
+    // it is too late to abort the test case.
+    static_cast<void>(report());
+}
+
+bool no_allocation_checker::report() const noexcept {
+    const allocation_stats stats = scope.stop();
+
+    scoped_test_check check{location};
+    if (stats.count == 0u) {
+        registry::report_assertion(true, "no allocation made");
+        return true;
+    }
+
+    small_string<max_message_length> message;
+    append_or_truncate(
+        message, "expected no allocation, got ", stats.count, " allocation(s) for a total of ",
+        stats.bytes, " bytes");
+    registry::report_assertion(false, message);
+    return false;
+}
+} // namespace snitch::impl
+
+// Replacements for the global allocation functions.
+// -------------------------------------------------
+
+void* operator new(std::size_t size) {
+    return snitch::impl::tracked_allocate_or_throw(size, 0u);
+}
+
+void* operator new[](std::size_t size) {
+    return snitch::impl::tracked_allocate_or_throw(size, 0u);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return snitch::impl::tracked_allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return snitch::impl::tracked_allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return snitch::impl::tracked_allocate(size, 0u);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return snitch::impl::tracked_allocate(size, 0u);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return snitch::impl::tracked_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return snitch::impl::tracked_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    snitch::impl::tracked_free(ptr);
+}
+
+#endif
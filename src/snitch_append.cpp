@@ -39,6 +39,28 @@ bool append_to(small_string_span ss, T value) noexcept {
     return true;
 }
 
+template<floating_point T>
+bool append_to_shortest(small_string_span ss, T value) noexcept {
+    // Without a precision, std::to_chars writes the shortest representation.
+    constexpr auto fmt = std::chars_format::scientific;
+    auto [end, err]    = std::to_chars(ss.end(), ss.begin() + ss.capacity(), value, fmt);
+    if (err != std::errc{}) {
+        // Not enough space, try into a temporary string that is big enough, and copy whatever
+        // we can.
+        small_string<32> fallback;
+        auto [end2, err2] =
+            std::to_chars(fallback.end(), fallback.begin() + fallback.capacity(), value, fmt);
+        if (err2 != std::errc{}) {
+            return false;
+        }
+        fallback.grow(end2 - fallback.begin());
+        return append(ss, fallback);
+    }
+
+    ss.grow(end - ss.end());
+    return true;
+}
+
 template<large_int_t Base = 10, integral T>
 bool append_to(small_string_span ss, T value) noexcept {
     auto [end, err] = std::to_chars(ss.end(), ss.begin() + ss.capacity(), value, Base);
@@ -64,6 +86,11 @@ bool append_to(small_string_span ss, T value) noexcept {
     return append_constexpr(ss, value);
 }
 
+template<floating_point T>
+bool append_to_shortest(small_string_span ss, T value) noexcept {
+    return append_constexpr_shortest(ss, value);
+}
+
 template<large_int_t Base = 10, integral T>
 bool append_to(small_string_span ss, T value) noexcept {
     return append_constexpr<Base>(ss, value);
@@ -127,4 +154,12 @@ bool append_fast(small_string_span ss, float f) noexcept {
 bool append_fast(small_string_span ss, double d) noexcept {
     return append_to(ss, d);
 }
+
+bool append_fast_shortest(small_string_span ss, float f) noexcept {
+    return append_to_shortest(ss, f);
+}
+
+bool append_fast_shortest(small_string_span ss, double d) noexcept {
+    return append_to_shortest(ss, d);
+}
 } // namespace snitch::impl
@@ -0,0 +1,349 @@
+#include "snitch/snitch_cache.hpp"
+
+#include "snitch/snitch_append.hpp"
+#include "snitch/snitch_registry.hpp"
+
+#include <algorithm> // for std::sort, std::lower_bound
+#include <array> // for std::array
+#include <cstdio> // for std::fopen, std::fgets, std::fread, std::fwrite, std::rename
+#include <cstring> // for std::memcpy
+
+#if defined(_WIN32)
+#    include <direct.h> // for _mkdir
+#else
+#    include <sys/stat.h> // for mkdir
+#endif
+
+// Format
+// ------
+// The cache is a text file, named after the test application. The first line is a header made of
+// the word "snitch-cache", the format version, and the build fingerprint (16 hexadecimal digits).
+// Each following line is the result of a test case: "pass" or "fail", the hash of the full test
+// name (16 hexadecimal digits), and the full test name (for information only).
+
+namespace snitch::impl {
+namespace {
+constexpr std::string_view header_magic = "snitch-cache";
+constexpr std::string_view version      = "1";
+constexpr std::string_view extension    = ".snitch-cache";
+constexpr std::string_view pass_word    = "pass";
+constexpr std::string_view fail_word    = "fail";
+constexpr std::size_t      hash_digits  = 16u;
+
+std::FILE* open_file(const char* path, const char* mode) noexcept {
+#if defined(_MSC_VER)
+    // MSVC thinks std::fopen is unsafe.
+    std::FILE* handle = nullptr;
+    fopen_s(&handle, path, mode);
+    return handle;
+#else
+    return std::fopen(path, mode);
+#endif
+}
+
+void make_directory(const char* path) noexcept {
+    // Errors are ignored; if the folder cannot be created, the cache file cannot be written
+    // either, and this will be reported then.
+#if defined(_WIN32)
+    static_cast<void>(::_mkdir(path));
+#else
+    static_cast<void>(::mkdir(path, 0777));
+#endif
+}
+
+bool append_hash(small_string_span ss, std::uint64_t hash) noexcept {
+    constexpr std::string_view digits = "0123456789abcdef";
+
+    std::array<char, hash_digits> buffer = {};
+    for (std::size_t i = 0; i < hash_digits; ++i) {
+        buffer[hash_digits - 1u - i] = digits[(hash >> (4u * i)) & 0xfu];
+    }
+
+    return append(ss, std::string_view{buffer.data(), buffer.size()});
+}
+
+std::optional<std::uint64_t> parse_hash(std::string_view value) noexcept {
+    if (value.size() != hash_digits) {
+        return {};
+    }
+
+    std::uint64_t hash = 0u;
+    for (const char c : value) {
+        std::uint64_t digit = 0u;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<std::uint64_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = static_cast<std::uint64_t>(c - 'a' + 10);
+        } else {
+            return {};
+        }
+
+        hash = (hash << 4u) | digit;
+    }
+
+    return hash;
+}
+
+// Split the first word (up to the next space) from 'line'.
+std::string_view pop_word(std::string_view& line) noexcept {
+    const std::size_t      end  = line.find(' ');
+    const std::string_view word = line.substr(0, end);
+    line.remove_prefix(end == std::string_view::npos ? line.size() : end + 1u);
+    return word;
+}
+
+std::uint64_t hash_test_id(const test_id& id) noexcept {
+    small_string<max_test_name_length> buffer;
+    return hash_string(make_full_name(buffer, id));
+}
+
+class line_reader {
+    std::FILE* file = nullptr;
+
+    // Long enough for a result line with the longest test name.
+    std::array<char, max_test_name_length + 2u * hash_digits> buffer = {};
+
+public:
+    explicit line_reader(std::FILE* f) noexcept : file(f) {}
+
+    // Returns the next line, without the end of line character.
+    // Lines too long to fit in the buffer are truncated.
+    std::optional<std::string_view> next() noexcept {
+        if (std::fgets(buffer.data(), static_cast<int>(buffer.size()), file) == nullptr) {
+            return {};
+        }
+
+        std::string_view line{buffer.data()};
+        if (!line.empty() && line.back() == '\n') {
+            line.remove_suffix(1u);
+        } else {
+            // Skip the rest of the line.
+            for (int c = std::fgetc(file); c != EOF && c != '\n'; c = std::fgetc(file)) {
+            }
+        }
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1u);
+        }
+
+        return line;
+    }
+};
+} // namespace
+
+bool result_cache::open(
+    std::string_view dir, std::string_view executable, std::uint64_t build) noexcept {
+    path.clear();
+    entries.clear();
+    fingerprint = build;
+
+    // Keep room for the ".tmp" suffix of the temporary file, and for the null terminator.
+    constexpr std::size_t reserved = 5u;
+
+    small_string<max_path_length + 1> null_terminated_dir;
+    if (!append(null_terminated_dir, dir) ||
+        !append(path, dir, "/", executable.empty() ? "snitch" : executable, extension) ||
+        path.available() < reserved) {
+        path.clear();
+        return false;
+    }
+
+    null_terminated_dir.push_back('\0');
+    make_directory(null_terminated_dir.data());
+
+    path.push_back('\0');
+    std::FILE* file = open_file(path.data(), "r");
+    path.pop_back();
+
+    if (file == nullptr) {
+        // No previous run.
+        return true;
+    }
+
+    line_reader reader{file};
+
+    // Check the header; results from another build or format are discarded.
+    if (auto line = reader.next()) {
+        const bool valid_header = pop_word(*line) == header_magic && pop_word(*line) == version &&
+                                  parse_hash(pop_word(*line)) == fingerprint;
+
+        while (valid_header && entries.available() > 0u) {
+            line = reader.next();
+            if (!line.has_value()) {
+                break;
+            }
+
+            const std::string_view result = pop_word(*line);
+            const auto             hash   = parse_hash(pop_word(*line));
+            if (!hash.has_value() || (result != pass_word && result != fail_word)) {
+                continue;
+            }
+
+            entries.push_back(
+                {*hash, result == pass_word ? cached_result::passed : cached_result::failed});
+        }
+    }
+
+    std::fclose(file);
+
+    std::sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+        return a.hash < b.hash;
+    });
+
+    return true;
+}
+
+cached_result result_cache::find(const test_id& id) const noexcept {
+    const std::uint64_t hash = hash_test_id(id);
+
+    const auto iter = std::lower_bound(
+        entries.begin(), entries.end(), hash,
+        [](const entry& e, std::uint64_t h) { return e.hash < h; });
+
+    if (iter == entries.end() || iter->hash != hash) {
+        return cached_result::unknown;
+    }
+
+    return iter->result;
+}
+
+bool result_cache::save(small_vector_span<const test_case> tests) const noexcept {
+    if (path.empty()) {
+        return false;
+    }
+
+    // Write to a temporary file first, so an interrupted run does not leave a truncated cache.
+    small_string<max_path_length> temp_path = path;
+    static_cast<void>(append(temp_path, ".tmp"));
+    temp_path.push_back('\0');
+
+    std::FILE* file = open_file(temp_path.data(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    bool       success = true;
+    const auto write   = [&](std::string_view line) noexcept {
+        success = std::fwrite(line.data(), sizeof(char), line.size(), file) == line.size() &&
+                  success;
+    };
+
+    small_string<max_test_name_length + 2u * hash_digits> line;
+    static_cast<void>(append(line, header_magic, " ", version, " "));
+    static_cast<void>(append_hash(line, fingerprint));
+    static_cast<void>(append(line, "\n"));
+    write(line);
+
+    small_string<max_test_name_length> name_buffer;
+    for (const test_case& t : tests) {
+        cached_result result = cached_result::unknown;
+        switch (t.state) {
+        case test_case_state::success:
+        case test_case_state::allowed_fail: {
+            result = cached_result::passed;
+            break;
+        }
+        case test_case_state::failed: {
+            result = cached_result::failed;
+            break;
+        }
+        case test_case_state::skipped: {
+            // Not a pass; run it again next time.
+            break;
+        }
+        case test_case_state::not_run: {
+            result = find(t.id);
+            break;
+        }
+        }
+
+        if (result == cached_result::unknown) {
+            continue;
+        }
+
+        const std::string_view full_name = make_full_name(name_buffer, t.id);
+
+        line.clear();
+        const std::string_view word = result == cached_result::passed ? pass_word : fail_word;
+        static_cast<void>(append(line, word, " "));
+        static_cast<void>(append_hash(line, hash_string(full_name)));
+        static_cast<void>(append(line, " ", full_name, "\n"));
+        write(line);
+    }
+
+    success = std::fclose(file) == 0 && success;
+
+    small_string<max_path_length> null_terminated_path = path;
+    null_terminated_path.push_back('\0');
+
+    if (!success) {
+        static_cast<void>(std::remove(temp_path.data()));
+        return false;
+    }
+
+#if defined(_WIN32)
+    // On Windows, std::rename() does not replace an existing file.
+    static_cast<void>(std::remove(null_terminated_path.data()));
+#endif
+
+    return std::rename(temp_path.data(), null_terminated_path.data()) == 0;
+}
+
+std::uint64_t hash_string(std::string_view value) noexcept {
+    // FNV-1a.
+    std::uint64_t hash = 0xcbf29ce484222325u;
+    for (const char c : value) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3u;
+    }
+
+    return hash;
+}
+
+std::optional<std::uint64_t> hash_file(std::string_view file_path) noexcept {
+    small_string<max_path_length + 1> null_terminated_path;
+    if (!append(null_terminated_path, file_path)) {
+        return {};
+    }
+    null_terminated_path.push_back('\0');
+
+    std::FILE* file = open_file(null_terminated_path.data(), "rb");
+    if (file == nullptr) {
+        return {};
+    }
+
+    // The file may be large (a test application with debug information); hash it a word at a
+    // time rather than a byte at a time.
+    constexpr std::uint64_t multiplier = 0x9e3779b97f4a7c15u;
+
+    std::array<char, 16u * 1024u> buffer = {};
+    std::uint64_t                 hash   = 0xcbf29ce484222325u;
+    std::uint64_t                 size   = 0u;
+
+    std::size_t read = 0u;
+    while ((read = std::fread(buffer.data(), sizeof(char), buffer.size(), file)) > 0u) {
+        std::size_t i = 0u;
+        for (; i + sizeof(std::uint64_t) <= read; i += sizeof(std::uint64_t)) {
+            std::uint64_t word = 0u;
+            std::memcpy(&word, buffer.data() + i, sizeof(word));
+            hash = (hash ^ word) * multiplier;
+            hash ^= hash >> 32u;
+        }
+
+        for (; i < read; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(buffer[i])) * multiplier;
+            hash ^= hash >> 32u;
+        }
+
+        size += read;
+    }
+
+    const bool failed = std::ferror(file) != 0;
+    std::fclose(file);
+
+    if (failed) {
+        return {};
+    }
+
+    return (hash ^ size) * multiplier;
+}
+} // namespace snitch::impl
@@ -2,6 +2,7 @@
 
 #include "snitch/snitch_console.hpp"
 #include "snitch/snitch_error_handling.hpp"
+#include "snitch/snitch_startup_stats.hpp"
 #include "snitch/snitch_string_utility.hpp"
 
 #include <algorithm> // for std::find
@@ -69,7 +70,8 @@ std::optional<cli::input> parse_arguments(
     const parser_settings&    settings = parser_settings{}) noexcept {
 
     std::optional<cli::input> ret(std::in_place);
-    ret->executable = extract_executable(argv[0]);
+    ret->executable      = extract_executable(argv[0]);
+    ret->executable_path = argv[0];
 
     auto& args = ret->arguments;
     bool  bad  = false;
@@ -312,17 +314,32 @@ void print_help(
 
 // clang-format off
 constexpr expected_arguments expected_args = {
-    {{"-l", "--list-tests"},    {},                         false, "List tests by name"},
-    {{"--list-tags"},           {},                         false, "List tags by name"},
-    {{"--list-tests-with-tag"}, {"tag"},                    false, "List tests by name with a given tag"},
-    {{"--list-reporters"},      {},                         false, "List available test reporters (see --reporter)"},
-    {{"-r", "--reporter"},      {"reporter[::key=value]*"}, false, "Choose which reporter to use to output the test results"},
-    {{"-v", "--verbosity"},     {"quiet|normal|high|full"}, false, "Define how much gets sent to the standard output"},
-    {{"-o", "--out"},           {"path"},                   false, "Saves output to a file given as 'path'"},
-    {{"--color"},               {"always|default|never"},   false, "Enable/disable color in output"},
-    {{"--colour-mode"},         {"ansi|default|none"},      false, "Enable/disable color in output (for compatibility with Catch2)"},
-    {{"-h", "--help"},          {},                         false, "Print help"},
-    {{},                        {"test regex"},             false, "A regex to select which test cases to run", argument_type::repeatable},
+    {{"-l", "--list-tests"},    {},                          false, "List tests by name"},
+    {{"--list-tags"},           {},                          false, "List tags by name"},
+    {{"--list-tests-with-tag"}, {"tag"},                     false, "List tests by name with a given tag"},
+    {{"--list-reporters"},      {},                          false, "List available test reporters (see --reporter)"},
+    {{"-r", "--reporter"},      {"reporter[::key=value]*"},  false, "Choose which reporter to use to output the test results (can be repeated)", argument_type::repeatable},
+    {{"-v", "--verbosity"},     {"quiet|normal|high|full"},  false, "Define how much gets sent to the standard output"},
+    {{"-o", "--out"},           {"path"},                    false, "Saves output to a file given as 'path'"},
+    {{"--color"},               {"always|default|never"},    false, "Enable/disable color in output"},
+    {{"--colour-mode"},         {"ansi|default|none"},       false, "Enable/disable color in output (for compatibility with Catch2)"},
+    {{"--flush"},               {"line|test-case|exit"},     false, "Choose when the standard output is flushed (default: line if a terminal, test-case otherwise)"},
+    {{"--profile"},             {"path"},                    false, "Saves section timings to a file given as 'path' (Chrome trace if '.json', collapsed stacks otherwise)"},
+    {{"-d", "--durations"},     {"yes|no"},                  false, "Print the duration of each test case, and a summary of the slowest test cases and sections"},
+    {{"-D", "--min-duration"},  {"seconds"},                 false, "Only print durations of at least 'seconds' (implies '--durations yes')"},
+    {{"--cache"},               {"dir"},                     false, "Store the test results in 'dir', to skip unchanged passing tests in later runs"},
+    {{"--cache-key"},           {"key"},                     false, "Identify the build with 'key' in the cache (default: hash of the test application)"},
+    {{"--only-failed"},         {},                          false, "Only run the tests that failed in the cached results (if none, same as --skip-cached-passes)"},
+    {{"--skip-cached-passes"},  {},                          false, "Skip the tests that passed in the cached results"},
+    {{"--retry"},               {"count"},                   false, "Run failed test cases again, up to 'count' times, and report those which then pass as flaky"},
+    {{"--test-timeout"},        {"duration"},                false, "Stop the test application if a test case runs for longer than 'duration' (e.g., 5s, 500ms)"},
+    {{"-a", "--abort"},         {},                          false, "Stop the test run at the first failed assertion"},
+    {{"-x", "--abortx"},        {"count"},                   false, "Stop the test run after 'count' failed assertions"},
+    {{"--order"},               {"decl|lex|rand"},           false, "Choose the order in which test cases are run (default: decl)"},
+    {{"--rng-seed"},            {"time|random-device|seed"}, false, "Seed for the random order and 'snitch::rng()' (default: 0, or time with '--order rand')"},
+    {{"--startup-stats"},       {},                          false, "Print the time taken by each startup phase, up to the end of the first test case"},
+    {{"-h", "--help"},          {},                          false, "Print help"},
+    {{},                        {"test regex"},              false, "A regex to select which test cases to run", argument_type::repeatable},
     // For compatibility with Catch2; unused.
     // This is used just to swallow the argument and its parameters.
     // The argument will still be reported as unknown.
@@ -331,17 +348,11 @@ constexpr expected_arguments expected_args = {
     {{"-e", "--nothrow"},           {},    true, ""},
     {{"-i", "--invisibles"},        {},    true, ""},
     {{"-n", "--name"},              {},    true, ""},
-    {{"-a", "--abort"},             {},    true, ""},
-    {{"-x", "--abortx"},            {"x"}, true, ""},
     {{"-w", "--warn"},              {"x"}, true, ""},
-    {{"-d", "--durations"},         {"x"}, true, ""},
-    {{"-D", "--min-duration"},      {"x"}, true, ""},
     {{"-f", "--input-file"},        {"x"}, true, ""},
     {{"-#", "--filenames-as-tags"}, {"x"}, true, ""},
     {{"-c", "--section"},           {"x"}, true, ""},
     {{"--list-listeners"},          {},    true, ""},
-    {{"--order"},                   {"x"}, true, ""},
-    {{"--rng-seed"},                {"x"}, true, ""},
     {{"--libidentify"},             {},    true, ""},
     {{"--wait-for-keypress"},       {"x"}, true, ""},
     {{"--shard-count"},             {"x"}, true, ""},
@@ -401,6 +412,12 @@ void print_help(std::string_view program_name, const print_help_settings& settin
 }
 
 std::optional<cli::input> parse_arguments(int argc, const char* const argv[]) noexcept {
+#if SNITCH_WITH_TIMINGS
+    // Static initialization is over by the time the command line is parsed.
+    impl::end_startup_phase(impl::startup_phase::registration);
+    impl::start_startup_phase(impl::startup_phase::parse_arguments);
+#endif
+
     // First, parse just looking for color options so we can display console messages correctly.
     const bool with_color = impl::parse_color_options(argc, argv);
 
@@ -413,6 +430,10 @@ std::optional<cli::input> parse_arguments(int argc, const char* const argv[]) no
         print_help(argv[0], {.with_color = with_color});
     }
 
+#if SNITCH_WITH_TIMINGS
+    impl::end_startup_phase(impl::startup_phase::parse_arguments);
+#endif
+
     return ret_args;
 }
 
@@ -445,6 +466,18 @@ get_positional_argument(const cli::input& args, std::string_view name) noexcept
     return ret;
 }
 
+void for_each_option(
+    const cli::input&                                    args,
+    std::string_view                                     name,
+    const function_ref<void(std::string_view) noexcept>& callback) noexcept {
+
+    for (const auto& arg : args.arguments) {
+        if (impl::is_option(arg) && arg.name == name && arg.value.has_value()) {
+            callback(*arg.value);
+        }
+    }
+}
+
 void for_each_positional_argument(
     const cli::input&                                    args,
     std::string_view                                     name,
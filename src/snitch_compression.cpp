@@ -0,0 +1,497 @@
+#include "snitch/snitch_compression.hpp"
+
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+
+#    include "snitch/snitch_error_handling.hpp"
+
+#    include <algorithm> // for std::fill, std::min
+#    include <array> // for std::array
+#    include <cstdint> // for std::uint8_t, std::uint16_t, std::uint32_t
+#    include <cstdio> // for std::fwrite, std::fflush
+#    include <cstring> // for std::memcpy
+#    include <optional> // for std::optional
+#    if SNITCH_WITH_MULTITHREADING
+#        include <condition_variable> // for std::condition_variable
+#        include <mutex> // for std::mutex, std::unique_lock
+#        include <thread> // for std::thread
+#    endif
+
+// Compressed output is written in the LZ4 frame format, so it can also be decompressed with the
+// standard 'lz4' command-line tool:
+//  - frame header: magic number, flags (version 1, independent blocks, no checksum), maximum
+//    block size (64 KB), and header checksum.
+//  - blocks: 32-bit little-endian size (with the high bit set if the block is stored
+//    uncompressed), followed by the block data.
+//  - end mark: a block size of zero.
+// Blocks are compressed with a greedy LZ77 matcher, which finds earlier occurrences of each 4-byte
+// sequence in a hash table. A block that does not shrink is stored uncompressed.
+
+namespace snitch::impl {
+namespace {
+constexpr std::uint32_t frame_magic            = 0x184d2204u;
+constexpr std::uint8_t  frame_flags            = 0x60u;
+constexpr std::uint8_t  frame_block_max_size   = 0x40u;
+constexpr std::uint32_t uncompressed_block_bit = 0x80000000u;
+
+// Limits imposed by the LZ4 block format: a match is at least 4 bytes long, at most 65535 bytes
+// away, cannot start in the last 12 bytes of a block, and the last 5 bytes are always literals.
+constexpr std::size_t min_match_length  = 4u;
+constexpr std::size_t max_match_offset  = 65535u;
+constexpr std::size_t match_start_limit = 12u;
+constexpr std::size_t last_literals     = 5u;
+
+constexpr std::size_t hash_bits       = 12u;
+constexpr std::size_t hash_table_size = std::size_t{1} << hash_bits;
+
+static_assert(compression_block_size <= 65536u, "block positions must fit in 16 bits");
+
+// Second byte of the xxHash32 (with seed 0) of the frame flags and block size.
+constexpr std::uint8_t header_checksum(std::uint8_t flags, std::uint8_t block_max_size) noexcept {
+    constexpr std::uint32_t prime1 = 2654435761u;
+    constexpr std::uint32_t prime2 = 2246822519u;
+    constexpr std::uint32_t prime3 = 3266489917u;
+    constexpr std::uint32_t prime5 = 374761393u;
+
+    std::uint32_t hash = prime5 + 2u;
+    for (const std::uint32_t byte : {flags, block_max_size}) {
+        hash += byte * prime5;
+        hash = ((hash << 11u) | (hash >> 21u)) * prime1;
+    }
+
+    hash ^= hash >> 15u;
+    hash *= prime2;
+    hash ^= hash >> 13u;
+    hash *= prime3;
+    hash ^= hash >> 16u;
+
+    return static_cast<std::uint8_t>(hash >> 8u);
+}
+
+std::uint32_t read_u32(const unsigned char* data) noexcept {
+    std::uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+std::size_t hash_sequence(std::uint32_t sequence) noexcept {
+    return static_cast<std::uint32_t>(sequence * 2654435761u) >> (32u - hash_bits);
+}
+
+// Destination of a compressed block; 'full' is set if the block does not fit.
+struct block_output {
+    unsigned char* data     = nullptr;
+    std::size_t    capacity = 0;
+    std::size_t    size     = 0;
+    bool           full     = false;
+
+    void byte(std::size_t value) noexcept {
+        if (size == capacity) {
+            full = true;
+            return;
+        }
+
+        data[size++] = static_cast<unsigned char>(value);
+    }
+
+    void bytes(const unsigned char* values, std::size_t count) noexcept {
+        if (count > capacity - size) {
+            full = true;
+            return;
+        }
+
+        std::memcpy(data + size, values, count);
+        size += count;
+    }
+
+    // Remainder of a literal or match length, after the 15 stored in the sequence token.
+    void length(std::size_t value) noexcept {
+        for (; value >= 255u; value -= 255u) {
+            byte(255u);
+        }
+
+        byte(value);
+    }
+};
+
+void write_sequence(
+    block_output&        out,
+    const unsigned char* literals,
+    std::size_t          literal_count,
+    std::size_t          offset,
+    std::size_t          match_length) noexcept {
+
+    const std::size_t match_code = match_length == 0u ? 0u : match_length - min_match_length;
+    out.byte((std::min<std::size_t>(literal_count, 15u) << 4u) | std::min<std::size_t>(match_code, 15u));
+    if (literal_count >= 15u) {
+        out.length(literal_count - 15u);
+    }
+
+    out.bytes(literals, literal_count);
+
+    if (match_length == 0u) {
+        // Last sequence of the block.
+        return;
+    }
+
+    out.byte(offset & 0xffu);
+    out.byte(offset >> 8u);
+    if (match_code >= 15u) {
+        out.length(match_code - 15u);
+    }
+}
+
+// Returns the size of the compressed block, or zero if it would not be smaller than the input.
+std::size_t compress_block(
+    const unsigned char* input,
+    std::size_t          size,
+    unsigned char*       output,
+    std::uint16_t*       table) noexcept {
+
+    block_output out{.data = output, .capacity = size};
+
+    std::size_t anchor = 0;
+    if (size > match_start_limit) {
+        std::fill(table, table + hash_table_size, std::uint16_t{0});
+
+        const std::size_t start_limit = size - match_start_limit;
+        const std::size_t end_limit   = size - last_literals;
+
+        std::size_t position = 0;
+        while (position < start_limit && !out.full) {
+            const std::uint32_t sequence  = read_u32(input + position);
+            std::uint16_t&      entry     = table[hash_sequence(sequence)];
+            const std::size_t   candidate = entry;
+            entry                         = static_cast<std::uint16_t>(position);
+
+            if (candidate >= position || position - candidate > max_match_offset ||
+                read_u32(input + candidate) != sequence) {
+                // No match; skip ahead faster in data that does not compress.
+                position += 1u + ((position - anchor) >> 6u);
+                continue;
+            }
+
+            std::size_t length = min_match_length;
+            while (position + length < end_limit &&
+                   input[candidate + length] == input[position + length]) {
+                ++length;
+            }
+
+            write_sequence(
+                out, input + anchor, position - anchor, position - candidate, length);
+
+            position += length;
+            anchor = position;
+        }
+    }
+
+    write_sequence(out, input + anchor, size - anchor, 0u, 0u);
+
+    return out.full || out.size >= size ? 0u : out.size;
+}
+
+void write_u32(std::FILE* file, std::uint32_t value) noexcept {
+    const unsigned char bytes[4] = {
+        static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8u),
+        static_cast<unsigned char>(value >> 16u), static_cast<unsigned char>(value >> 24u)};
+    std::fwrite(bytes, 1u, sizeof(bytes), file);
+}
+} // namespace
+
+struct compressed_stream {
+    bool       in_use = false;
+    std::FILE* file   = nullptr;
+
+    // Uncompressed output; one block is filled while the other is being compressed.
+    std::array<std::array<unsigned char, compression_block_size>, 2> blocks = {};
+    std::size_t current_block = 0;
+    std::size_t current_size  = 0;
+
+    std::array<unsigned char, compression_block_size> output = {};
+    std::array<std::uint16_t, hash_table_size>         table  = {};
+
+#    if SNITCH_WITH_MULTITHREADING
+    std::thread             worker;
+    std::mutex              mutex;
+    std::condition_variable condition;
+    std::size_t             pending_block = 0;
+    std::size_t             pending_size  = 0;
+    bool                    pending       = false;
+    bool                    stopping      = false;
+#    endif
+};
+
+namespace {
+compressed_stream streams[max_compressed_outputs];
+
+void compress_and_write(compressed_stream& stream, std::size_t block, std::size_t size) noexcept {
+    const unsigned char* input = stream.blocks[block].data();
+    const std::size_t    compressed_size =
+        compress_block(input, size, stream.output.data(), stream.table.data());
+
+    if (compressed_size == 0u) {
+        write_u32(stream.file, static_cast<std::uint32_t>(size) | uncompressed_block_bit);
+        std::fwrite(input, 1u, size, stream.file);
+    } else {
+        write_u32(stream.file, static_cast<std::uint32_t>(compressed_size));
+        std::fwrite(stream.output.data(), 1u, compressed_size, stream.file);
+    }
+
+    std::fflush(stream.file);
+}
+
+#    if SNITCH_WITH_MULTITHREADING
+void run_worker(compressed_stream& stream) noexcept {
+    std::unique_lock lock(stream.mutex);
+    while (true) {
+        stream.condition.wait(lock, [&] { return stream.pending || stream.stopping; });
+        if (!stream.pending) {
+            return;
+        }
+
+        const std::size_t block = stream.pending_block;
+        const std::size_t size  = stream.pending_size;
+
+        lock.unlock();
+        compress_and_write(stream, block, size);
+        lock.lock();
+
+        stream.pending = false;
+        stream.condition.notify_all();
+    }
+}
+#    endif
+
+// Hand over the current block for compression, and start filling the other block.
+void submit_block(compressed_stream& stream) noexcept {
+#    if SNITCH_WITH_MULTITHREADING
+    {
+        std::unique_lock lock(stream.mutex);
+        stream.condition.wait(lock, [&] { return !stream.pending; });
+        stream.pending       = true;
+        stream.pending_block = stream.current_block;
+        stream.pending_size  = stream.current_size;
+    }
+    stream.condition.notify_all();
+#    else
+    compress_and_write(stream, stream.current_block, stream.current_size);
+#    endif
+
+    stream.current_block = 1u - stream.current_block;
+    stream.current_size  = 0u;
+}
+
+bool read_u32(std::string_view& data, std::uint32_t& value) noexcept {
+    if (data.size() < 4u) {
+        return false;
+    }
+
+    value = 0u;
+    for (std::size_t i = 0; i < 4u; ++i) {
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << (8u * i);
+    }
+
+    data.remove_prefix(4u);
+    return true;
+}
+
+bool read_length(std::string_view& data, std::size_t& length) noexcept {
+    unsigned char byte = 255u;
+    while (byte == 255u) {
+        if (data.empty()) {
+            return false;
+        }
+
+        byte = static_cast<unsigned char>(data[0]);
+        data.remove_prefix(1u);
+        length += byte;
+    }
+
+    return true;
+}
+
+// Returns the size of the decompressed block, or nothing if the block is malformed.
+std::optional<std::size_t> decompress_block(std::string_view data, char* output) noexcept {
+    std::size_t size = 0;
+    while (!data.empty()) {
+        const unsigned char token = static_cast<unsigned char>(data[0]);
+        data.remove_prefix(1u);
+
+        std::size_t literal_count = token >> 4u;
+        if (literal_count == 15u && !read_length(data, literal_count)) {
+            return {};
+        }
+
+        if (literal_count > data.size() || literal_count > compression_block_size - size) {
+            return {};
+        }
+
+        std::memcpy(output + size, data.data(), literal_count);
+        data.remove_prefix(literal_count);
+        size += literal_count;
+
+        if (data.empty()) {
+            // Last sequence of the block.
+            break;
+        }
+
+        if (data.size() < 2u) {
+            return {};
+        }
+
+        const std::size_t offset = static_cast<unsigned char>(data[0]) |
+                                   (static_cast<std::size_t>(static_cast<unsigned char>(data[1]))
+                                    << 8u);
+        data.remove_prefix(2u);
+
+        std::size_t match_length = token & 0xfu;
+        if (match_length == 15u && !read_length(data, match_length)) {
+            return {};
+        }
+
+        match_length += min_match_length;
+        if (offset == 0u || offset > size || match_length > compression_block_size - size) {
+            return {};
+        }
+
+        // The match may overlap the output it produces, so copy one byte at a time.
+        for (std::size_t i = 0; i < match_length; ++i, ++size) {
+            output[size] = output[size - offset];
+        }
+    }
+
+    return size;
+}
+} // namespace
+
+bool is_compressed_path(std::string_view path) noexcept {
+    return path.size() > 2u && path.ends_with(".z");
+}
+
+compressed_stream* open_compressed_stream(void* file_handle) {
+    compressed_stream* stream = nullptr;
+    for (auto& s : streams) {
+        if (!s.in_use) {
+            stream = &s;
+            break;
+        }
+    }
+
+    if (stream == nullptr) {
+        assertion_failed(
+            "max number of compressed outputs reached; "
+            "please increase 'SNITCH_MAX_COMPRESSED_OUTPUTS'");
+    }
+
+    stream->in_use        = true;
+    stream->file          = static_cast<std::FILE*>(file_handle);
+    stream->current_block = 0u;
+    stream->current_size  = 0u;
+
+    write_u32(stream->file, frame_magic);
+    const unsigned char descriptor[3] = {
+        frame_flags, frame_block_max_size, header_checksum(frame_flags, frame_block_max_size)};
+    std::fwrite(descriptor, 1u, sizeof(descriptor), stream->file);
+
+#    if SNITCH_WITH_MULTITHREADING
+    stream->pending  = false;
+    stream->stopping = false;
+    stream->worker   = std::thread([stream] { run_worker(*stream); });
+#    endif
+
+    return stream;
+}
+
+void write(compressed_stream& stream, std::string_view message) noexcept {
+    while (!message.empty()) {
+        const std::size_t count =
+            std::min(message.size(), compression_block_size - stream.current_size);
+        std::memcpy(
+            stream.blocks[stream.current_block].data() + stream.current_size, message.data(),
+            count);
+        stream.current_size += count;
+        message.remove_prefix(count);
+
+        if (stream.current_size == compression_block_size) {
+            submit_block(stream);
+        }
+    }
+}
+
+void close(compressed_stream& stream) noexcept {
+    if (stream.current_size > 0u) {
+        submit_block(stream);
+    }
+
+#    if SNITCH_WITH_MULTITHREADING
+    {
+        std::unique_lock lock(stream.mutex);
+        stream.stopping = true;
+    }
+    stream.condition.notify_all();
+    stream.worker.join();
+#    endif
+
+    write_u32(stream.file, 0u);
+    std::fflush(stream.file);
+
+    stream.file   = nullptr;
+    stream.in_use = false;
+}
+
+bool decompress(
+    std::string_view data, const function_ref<void(std::string_view) noexcept>& output) noexcept {
+
+    std::uint32_t magic = 0;
+    if (!read_u32(data, magic) || magic != frame_magic || data.size() < 3u) {
+        return false;
+    }
+
+    const unsigned char flags          = static_cast<unsigned char>(data[0]);
+    const unsigned char block_max_size = static_cast<unsigned char>(data[1]);
+
+    // Only accept the features used when compressing: version 1, independent blocks, no block
+    // checksum, no content size, no dictionary, and blocks of at most 64 KB. A content checksum
+    // is allowed, but not verified.
+    constexpr unsigned char content_checksum_flag = 0x04u;
+    if ((flags & ~content_checksum_flag) != frame_flags ||
+        block_max_size != frame_block_max_size) {
+        return false;
+    }
+
+    data.remove_prefix(3u);
+
+    std::array<char, compression_block_size> block = {};
+    while (true) {
+        std::uint32_t block_size = 0;
+        if (!read_u32(data, block_size)) {
+            return false;
+        }
+
+        if (block_size == 0u) {
+            // End mark.
+            return (flags & content_checksum_flag) == 0u || data.size() >= 4u;
+        }
+
+        const bool uncompressed = (block_size & uncompressed_block_bit) != 0u;
+        block_size &= ~uncompressed_block_bit;
+        if (block_size > data.size() || block_size > compression_block_size) {
+            return false;
+        }
+
+        if (uncompressed) {
+            output(data.substr(0, block_size));
+        } else {
+            const auto size = decompress_block(data.substr(0, block_size), block.data());
+            if (!size.has_value()) {
+                return false;
+            }
+
+            output(std::string_view{block.data(), size.value()});
+        }
+
+        data.remove_prefix(block_size);
+    }
+}
+} // namespace snitch::impl
+
+#endif
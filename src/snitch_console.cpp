@@ -1,9 +1,209 @@
 #include "snitch/snitch_console.hpp"
 
-#include <cstdio> // for std::fwrite
+#include "snitch/snitch_append.hpp"
+#include "snitch/snitch_error_handling.hpp"
+
+#include <array> // for std::array
+#include <cstdio> // for std::fwrite, std::fflush
+#include <cstring> // for std::memcpy
+#if SNITCH_WITH_MULTITHREADING
+#    include <mutex> // for std::mutex, std::scoped_lock
+#endif
+#if defined(_WIN32)
+#    include <fcntl.h> // for _O_BINARY
+#    include <io.h> // for _isatty, _fileno, _setmode
+#elif defined(__unix__) || defined(__APPLE__)
+#    include <unistd.h> // for isatty, fileno
+#endif
 
 namespace snitch::impl {
+namespace {
+bool is_stdout_terminal() noexcept {
+#if defined(_WIN32)
+    return _isatty(_fileno(stdout)) != 0;
+#elif defined(__unix__) || defined(__APPLE__)
+    return isatty(fileno(stdout)) != 0;
+#else
+    return false;
+#endif
+}
+
+struct stdout_sink {
+    std::array<char, max_stdout_buffer_length> buffer = {};
+    std::size_t                                size   = 0;
+    // Chosen on first use, since it depends on where the standard output goes.
+    stdout_flush_policy policy        = stdout_flush_policy::line;
+    bool                policy_chosen = false;
+
+#if SNITCH_WITH_MULTITHREADING
+    std::mutex mutex;
+#endif
+
+    stdout_flush_policy get_policy() noexcept {
+        if (!policy_chosen) {
+            policy = is_stdout_terminal() ? stdout_flush_policy::line
+                                          : stdout_flush_policy::test_case;
+            policy_chosen = true;
+        }
+
+        return policy;
+    }
+
+    void set_policy(stdout_flush_policy p) noexcept {
+        policy        = p;
+        policy_chosen = true;
+    }
+
+    void flush() noexcept {
+        if (size > 0u) {
+            std::fwrite(buffer.data(), sizeof(char), size, stdout);
+            size = 0u;
+        }
+
+        std::fflush(stdout);
+    }
+
+    void write(std::string_view message) noexcept {
+        if (message.size() > buffer.size() - size) {
+            flush();
+
+            if (message.size() > buffer.size()) {
+                std::fwrite(message.data(), sizeof(char), message.size(), stdout);
+                return;
+            }
+        }
+
+        std::memcpy(buffer.data() + size, message.data(), message.size());
+        size += message.size();
+    }
+
+    void end_line() noexcept {
+        if (get_policy() == stdout_flush_policy::line) {
+            flush();
+        }
+    }
+
+    ~stdout_sink() {
+        // Write out what remains at exit, and stop buffering output printed afterwards (e.g., by
+        // destructors of other static objects).
+        flush();
+        set_policy(stdout_flush_policy::line);
+    }
+};
+
+// Test cases are registered from static initializers, which may print; this must be
+// constant-initialized.
+constinit stdout_sink sink;
+
+#if SNITCH_WITH_MULTITHREADING
+// Start of a line printed by a thread; it is added to the shared buffer once complete, when the
+// output is flushed, or when the thread exits. Lines are linked together, so the output of all
+// threads can be flushed; they are only accessed with the mutex of the sink locked.
+struct pending_line {
+    small_string<max_message_length> text;
+    pending_line*                    previous = nullptr;
+    pending_line*                    next     = nullptr;
+
+    pending_line() noexcept;
+    pending_line(const pending_line&)            = delete;
+    pending_line& operator=(const pending_line&) = delete;
+    ~pending_line();
+
+    // Add the pending text, followed by 'message', to the shared buffer.
+    void commit(std::string_view message) noexcept {
+        sink.write(text);
+        sink.write(message);
+        text.clear();
+    }
+};
+
+constinit pending_line* pending_lines = nullptr;
+
+pending_line::pending_line() noexcept {
+    std::scoped_lock lock(sink.mutex);
+    next = pending_lines;
+    if (next != nullptr) {
+        next->previous = this;
+    }
+    pending_lines = this;
+}
+
+pending_line::~pending_line() {
+    std::scoped_lock lock(sink.mutex);
+    commit({});
+
+    if (previous != nullptr) {
+        previous->next = next;
+    } else {
+        pending_lines = next;
+    }
+    if (next != nullptr) {
+        next->previous = previous;
+    }
+}
+
+thread_local pending_line thread_line;
+#endif
+} // namespace
+
 void stdout_print(std::string_view message) noexcept {
-    std::fwrite(message.data(), sizeof(char), message.length(), stdout);
+    const std::size_t last_new_line = message.find_last_of('\n');
+
+#if SNITCH_WITH_MULTITHREADING
+    pending_line&    line = thread_line;
+    std::scoped_lock lock(sink.mutex);
+
+    if (last_new_line != std::string_view::npos) {
+        line.commit(message.substr(0, last_new_line + 1u));
+        sink.end_line();
+        message.remove_prefix(last_new_line + 1u);
+    }
+
+    if (message.size() > line.text.available()) {
+        // Line too long to be kept whole; it may be interleaved with output of other threads.
+        line.commit(message);
+        return;
+    }
+
+    static_cast<void>(append(line.text, message));
+#else
+    sink.write(message);
+
+    if (last_new_line != std::string_view::npos) {
+        sink.end_line();
+    }
+#endif
+}
+
+void stdout_flush() noexcept {
+#if SNITCH_WITH_MULTITHREADING
+    std::scoped_lock lock(sink.mutex);
+    for (pending_line* line = pending_lines; line != nullptr; line = line->next) {
+        line->commit({});
+    }
+#endif
+    sink.flush();
+}
+
+stdout_flush_policy get_stdout_flush_policy() noexcept {
+#if SNITCH_WITH_MULTITHREADING
+    std::scoped_lock lock(sink.mutex);
+#endif
+    return sink.get_policy();
+}
+
+void set_stdout_flush_policy(stdout_flush_policy policy) noexcept {
+    stdout_flush();
+#if SNITCH_WITH_MULTITHREADING
+    std::scoped_lock lock(sink.mutex);
+#endif
+    sink.set_policy(policy);
+}
+
+void set_stdout_binary_mode() noexcept {
+    stdout_flush();
+#if defined(_WIN32)
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
 }
 } // namespace snitch::impl
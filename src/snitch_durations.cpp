@@ -0,0 +1,140 @@
+#include "snitch/snitch_durations.hpp"
+
+#include "snitch/snitch_append.hpp"
+#include "snitch/snitch_string_utility.hpp"
+
+#if SNITCH_WITH_TIMINGS
+
+#    include <algorithm> // for std::*_heap, std::all_of, std::find_if
+
+namespace snitch::impl {
+namespace {
+// Puts the fastest entry at the front of the heap, so it can be replaced by a slower one.
+bool is_slower(const timed_entry& a, const timed_entry& b) noexcept {
+    return a.duration > b.duration;
+}
+} // namespace
+
+bool duration_tracker::add(
+    std::string_view test_name, section_info sections, time_point_t duration) noexcept {
+
+    if (duration < min_duration) {
+        return false;
+    }
+
+    if (slowest.available() == 0u) {
+        if (slowest.empty() || duration <= slowest[0].duration) {
+            // Not among the slowest so far.
+            return true;
+        }
+
+        std::pop_heap(slowest.begin(), slowest.end(), &is_slower);
+        slowest.pop_back();
+    }
+
+    timed_entry& entry = slowest.push_back({.duration = duration});
+    append_or_truncate(entry.name, test_name);
+    for (const auto& s : sections) {
+        append_or_truncate(entry.name, " / ", s.id.name);
+    }
+
+    std::push_heap(slowest.begin(), slowest.end(), &is_slower);
+    return true;
+}
+
+void duration_tracker::section_exited(section_info stack, time_point_t duration) noexcept {
+    small_string<max_message_length> path;
+    for (const auto& s : stack) {
+        append_or_truncate(path, path.empty() ? "" : " / ", s.id.name);
+    }
+
+    auto* it = std::find_if(sections.begin(), sections.end(), [&](const timed_entry& e) {
+        return e.name.str() == path.str();
+    });
+
+    if (it != sections.end()) {
+        it->duration += duration;
+    } else if (sections.available() > 0u) {
+        sections.push_back({.name = path, .duration = duration});
+    }
+}
+
+void duration_tracker::test_case_ended(std::string_view test_name, time_point_t duration) noexcept {
+    last_test_case.reset();
+    if (add(test_name, {}, duration)) {
+        last_test_case = duration;
+    }
+
+    for (const auto& s : sections) {
+        if (s.duration < min_duration) {
+            continue;
+        }
+
+        small_string<max_message_length> name;
+        append_or_truncate(name, test_name, " / ", s.name);
+        static_cast<void>(add(name, {}, s.duration));
+    }
+
+    sections.clear();
+}
+
+std::optional<time_point_t> duration_tracker::get_last_test_case() const noexcept {
+    return last_test_case;
+}
+
+small_vector_span<const timed_entry> duration_tracker::sort() noexcept {
+    std::sort_heap(slowest.begin(), slowest.end(), &is_slower);
+    return slowest;
+}
+
+small_vector_span<const timed_entry> duration_tracker::get_slowest() const noexcept {
+    return slowest;
+}
+
+void duration_tracker::clear() noexcept {
+    slowest.clear();
+    sections.clear();
+    last_test_case.reset();
+}
+
+std::optional<time_point_t> parse_seconds(std::string_view value) noexcept {
+    // Nanosecond resolution; the integer part is limited so the result cannot overflow.
+    constexpr std::size_t max_integer_digits  = 9u;
+    constexpr std::size_t max_fraction_digits = 9u;
+
+    const std::size_t dot_pos  = value.find('.');
+    std::string_view  integer  = value.substr(0, dot_pos);
+    std::string_view  fraction = dot_pos == std::string_view::npos ? std::string_view{}
+                                                                   : value.substr(dot_pos + 1);
+
+    if ((integer.empty() && fraction.empty()) || integer.size() > max_integer_digits) {
+        return {};
+    }
+
+    const auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    if (!std::all_of(integer.begin(), integer.end(), is_digit) ||
+        !std::all_of(fraction.begin(), fraction.end(), is_digit)) {
+        return {};
+    }
+
+    time_point_t ns = 0;
+    for (char c : integer) {
+        ns = ns * 10u + static_cast<time_point_t>(c - '0');
+    }
+
+    for (std::size_t i = 0; i < max_fraction_digits; ++i) {
+        ns = ns * 10u + (i < fraction.size() ? static_cast<time_point_t>(fraction[i] - '0') : 0u);
+    }
+
+    return ns;
+}
+
+bool append_seconds(small_string_span ss, time_point_t duration) noexcept {
+    const std::size_t milliseconds = (duration / 1'000'000u) % 1000u;
+    return append(
+        ss, duration / 1'000'000'000u, ".", milliseconds < 100u ? "0" : "",
+        milliseconds < 10u ? "0" : "", milliseconds);
+}
+} // namespace snitch::impl
+
+#endif
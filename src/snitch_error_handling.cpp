@@ -1,6 +1,7 @@
 #include "snitch/snitch_error_handling.hpp"
 
 #include "snitch/snitch_cli.hpp"
+#include "snitch/snitch_console.hpp"
 
 #include <exception> // for std::terminate
 
@@ -9,6 +10,7 @@ namespace snitch {
     cli::console_print("terminate called with message: ");
     cli::console_print(msg);
     cli::console_print("\n");
+    impl::stdout_flush();
 
     std::terminate();
 }
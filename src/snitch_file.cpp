@@ -3,9 +3,210 @@
 #include "snitch/snitch_append.hpp"
 #include "snitch/snitch_error_handling.hpp"
 
-#include <cstdio> // for std::fwrite
+#include <cstdio> // for std::fwrite, std::fseek, std::ftell
+
+#if SNITCH_WITH_MMAP_OUTPUT && (defined(__unix__) || defined(__APPLE__))
+#    define SNITCH_MMAP_OUTPUT_AVAILABLE 1
+#    include <algorithm> // for std::min
+#    include <array> // for std::array
+#    if SNITCH_WITH_MULTITHREADING
+#        include <atomic> // for std::atomic
+#    endif
+#    include <cstring> // for std::memcpy
+#    if SNITCH_WITH_MMAP_CRASH_HANDLERS
+#        include <csignal> // for SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV, std::raise
+#        include <cstdlib> // for std::abort
+#        include <exception> // for std::set_terminate, std::get_terminate, std::terminate_handler
+#        include <signal.h> // for sigaction
+#    endif
+#    include <fcntl.h> // for open
+#    include <sys/mman.h> // for mmap, munmap
+#    include <sys/stat.h> // for stat
+#    include <unistd.h> // for ftruncate, close
+#else
+#    define SNITCH_MMAP_OUTPUT_AVAILABLE 0
+#endif
 
 namespace snitch::impl {
+#if SNITCH_MMAP_OUTPUT_AVAILABLE
+namespace {
+// The mapping starts at this size, and then doubles each time it is full, growing by at most
+// 'max_mapping_growth' at a time. Unused space is sparse until written to, and is truncated when
+// the file is closed.
+constexpr std::size_t initial_mapping_size = 4u * 1024u * 1024u;
+constexpr std::size_t max_mapping_growth   = 256u * 1024u * 1024u;
+
+// Files currently written through a mapping, so they can be truncated to the written size if the
+// application terminates or crashes before they are closed (with SNITCH_WITH_MMAP_CRASH_HANDLERS).
+// Other files use stdio.
+constexpr std::size_t max_mapped_files = 8u;
+
+struct mapped_file {
+    int file_descriptor = -1;
+#    if SNITCH_WITH_MULTITHREADING
+    std::atomic<std::size_t> written_size = 0u;
+#    else
+    std::size_t written_size = 0u;
+#    endif
+};
+
+constinit std::array<mapped_file, max_mapped_files> mapped_files = {};
+
+#    if SNITCH_WITH_MMAP_CRASH_HANDLERS
+constexpr std::array<int, 5> fatal_signals = {SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV};
+
+constinit std::array<struct sigaction, fatal_signals.size()> previous_signal_actions = {};
+constinit std::terminate_handler                             previous_terminate_handler = nullptr;
+constinit bool                                               handlers_installed         = false;
+
+// Only uses async-signal-safe functions.
+void truncate_mapped_files() noexcept {
+    for (const mapped_file& file : mapped_files) {
+        if (file.file_descriptor >= 0) {
+            static_cast<void>(
+                ::ftruncate(file.file_descriptor, static_cast<off_t>(file.written_size)));
+        }
+    }
+}
+
+void on_fatal_signal(int signal) noexcept {
+    truncate_mapped_files();
+
+    // Let the previous handler (or the default action) deal with the signal.
+    for (std::size_t i = 0; i < fatal_signals.size(); ++i) {
+        if (fatal_signals[i] == signal) {
+            ::sigaction(signal, &previous_signal_actions[i], nullptr);
+        }
+    }
+
+    std::raise(signal);
+}
+
+void on_terminate() noexcept {
+    truncate_mapped_files();
+
+    if (previous_terminate_handler != nullptr) {
+        previous_terminate_handler();
+    }
+
+    std::abort();
+}
+
+void install_handlers() noexcept {
+    if (handlers_installed) {
+        return;
+    }
+
+    handlers_installed = true;
+
+    struct sigaction action = {};
+    action.sa_handler       = &on_fatal_signal;
+    sigemptyset(&action.sa_mask);
+    for (std::size_t i = 0; i < fatal_signals.size(); ++i) {
+        ::sigaction(fatal_signals[i], &action, &previous_signal_actions[i]);
+    }
+
+    previous_terminate_handler = std::set_terminate(&on_terminate);
+}
+
+// Restore the previous handlers, unless they were replaced since.
+void uninstall_handlers() noexcept {
+    if (!handlers_installed) {
+        return;
+    }
+
+    handlers_installed = false;
+
+    for (std::size_t i = 0; i < fatal_signals.size(); ++i) {
+        struct sigaction current = {};
+        ::sigaction(fatal_signals[i], nullptr, &current);
+        if (current.sa_handler == &on_fatal_signal) {
+            ::sigaction(fatal_signals[i], &previous_signal_actions[i], nullptr);
+        }
+    }
+
+    if (std::get_terminate() == &on_terminate) {
+        std::set_terminate(previous_terminate_handler);
+    }
+}
+#    endif
+
+std::size_t register_mapped_file(int file_descriptor) noexcept {
+    for (std::size_t i = 0; i < max_mapped_files; ++i) {
+        if (mapped_files[i].file_descriptor < 0) {
+#    if SNITCH_WITH_MMAP_CRASH_HANDLERS
+            install_handlers();
+#    endif
+            mapped_files[i].written_size    = 0u;
+            mapped_files[i].file_descriptor = file_descriptor;
+            return i;
+        }
+    }
+
+    return max_mapped_files;
+}
+
+void unregister_mapped_file(std::size_t slot) noexcept {
+    if (slot >= max_mapped_files) {
+        return;
+    }
+
+    mapped_files[slot].file_descriptor = -1;
+
+#    if SNITCH_WITH_MMAP_CRASH_HANDLERS
+    for (const mapped_file& file : mapped_files) {
+        if (file.file_descriptor >= 0) {
+            return;
+        }
+    }
+
+    uninstall_handlers();
+#    endif
+}
+} // namespace
+
+bool file_writer::grow_mapping(std::size_t required_size) noexcept {
+    std::size_t new_size = mapping_size == 0u ? initial_mapping_size : mapping_size;
+    while (new_size <= mapping_size || new_size < required_size) {
+        new_size += std::min(new_size, max_mapping_growth);
+    }
+
+    if (mapping != nullptr) {
+        ::munmap(mapping, mapping_size);
+        mapping      = nullptr;
+        mapping_size = 0;
+    }
+
+    if (::ftruncate(file_descriptor, static_cast<off_t>(new_size)) != 0) {
+        return false;
+    }
+
+    void* new_mapping =
+        ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    if (new_mapping == MAP_FAILED) {
+        return false;
+    }
+
+    mapping      = static_cast<char*>(new_mapping);
+    mapping_size = new_size;
+    return true;
+}
+
+void file_writer::close_mapping() noexcept {
+    unregister_mapped_file(mapped_slot);
+    mapped_slot = max_mapped_files;
+
+    if (mapping != nullptr) {
+        ::munmap(mapping, mapping_size);
+        mapping      = nullptr;
+        mapping_size = 0;
+    }
+
+    // Remove the unused space at the end of the mapping.
+    static_cast<void>(::ftruncate(file_descriptor, static_cast<off_t>(written_size)));
+}
+#endif
+
 file_writer::file_writer(std::string_view path) {
     // Unfortunately, fopen() needs a null-terminated string, so need a copy...
     small_string<max_path_length + 1> null_terminated_path;
@@ -13,44 +214,198 @@ file_writer::file_writer(std::string_view path) {
         assertion_failed("output file path is too long");
     }
 
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    const bool compressed = is_compressed_path(path);
+#else
+    constexpr bool compressed = false;
+#endif
+
+#if SNITCH_MMAP_OUTPUT_AVAILABLE
+    // Only regular files can be mapped; other outputs (pipes, terminals, ...) go through stdio.
+    struct stat file_info = {};
+    if (!compressed &&
+        (::stat(null_terminated_path.data(), &file_info) != 0 || S_ISREG(file_info.st_mode))) {
+        file_descriptor = ::open(null_terminated_path.data(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+        if (file_descriptor >= 0) {
+            mapped_slot = register_mapped_file(file_descriptor);
+            if (mapped_slot < max_mapped_files && grow_mapping(0u)) {
+                return;
+            }
+
+            unregister_mapped_file(mapped_slot);
+            mapped_slot = max_mapped_files;
+            ::close(file_descriptor);
+            file_descriptor = -1;
+        }
+    }
+#endif
+
+    // Always in binary mode: line endings must not be translated in the output of the binary
+    // reporter, nor in compressed output, and are not in mapped files either.
 #if defined(_MSC_VER)
     // MSVC thinks std::fopen is unsafe.
     std::FILE* tmp_handle = nullptr;
-    fopen_s(&tmp_handle, null_terminated_path.data(), "w");
+    fopen_s(&tmp_handle, null_terminated_path.data(), "wb");
     file_handle = tmp_handle;
 #else
-    file_handle = std::fopen(null_terminated_path.data(), "w");
+    file_handle = std::fopen(null_terminated_path.data(), "wb");
 #endif
 
     if (file_handle == nullptr) {
         assertion_failed("output file could not be opened for writing");
     }
+
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    if (compressed) {
+        compressor = open_compressed_stream(file_handle);
+    }
+#endif
 }
 
 file_writer::file_writer(file_writer&& other) noexcept {
     std::swap(file_handle, other.file_handle);
+#if SNITCH_WITH_MMAP_OUTPUT
+    std::swap(file_descriptor, other.file_descriptor);
+    std::swap(mapping, other.mapping);
+    std::swap(mapping_size, other.mapping_size);
+    std::swap(written_size, other.written_size);
+    std::swap(mapped_slot, other.mapped_slot);
+#endif
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    std::swap(compressor, other.compressor);
+#endif
 }
 
 file_writer& file_writer::operator=(file_writer&& other) noexcept {
     std::swap(file_handle, other.file_handle);
+#if SNITCH_WITH_MMAP_OUTPUT
+    std::swap(file_descriptor, other.file_descriptor);
+    std::swap(mapping, other.mapping);
+    std::swap(mapping_size, other.mapping_size);
+    std::swap(written_size, other.written_size);
+    std::swap(mapped_slot, other.mapped_slot);
+#endif
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    std::swap(compressor, other.compressor);
+#endif
     return *this;
 }
 
 file_writer::~file_writer() {
+#if SNITCH_MMAP_OUTPUT_AVAILABLE
+    if (file_descriptor >= 0) {
+        close_mapping();
+        ::close(file_descriptor);
+        return;
+    }
+#endif
+
     if (file_handle == nullptr) {
         return;
     }
 
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    if (compressor != nullptr) {
+        impl::close(*compressor);
+    }
+#endif
+
     std::fclose(static_cast<std::FILE*>(file_handle));
 }
 
 void file_writer::write(std::string_view message) noexcept {
+#if SNITCH_MMAP_OUTPUT_AVAILABLE
+    if (file_descriptor >= 0) {
+        if (written_size + message.size() <= mapping_size ||
+            grow_mapping(written_size + message.size())) {
+            std::memcpy(mapping + written_size, message.data(), message.size());
+            written_size += message.size();
+            mapped_files[mapped_slot].written_size = written_size;
+            return;
+        }
+
+        // The mapping could not grow (e.g., address space exhausted); continue with stdio.
+        close_mapping();
+        file_handle = ::fdopen(file_descriptor, "wb");
+        if (file_handle == nullptr) {
+            ::close(file_descriptor);
+        } else {
+            std::fseek(static_cast<std::FILE*>(file_handle), 0, SEEK_END);
+        }
+
+        file_descriptor = -1;
+    }
+#endif
+
     if (file_handle == nullptr) {
         return;
     }
 
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    if (compressor != nullptr) {
+        impl::write(*compressor, message);
+        return;
+    }
+#endif
+
     std::fwrite(
         message.data(), sizeof(char), message.length(), static_cast<std::FILE*>(file_handle));
     std::fflush(static_cast<std::FILE*>(file_handle));
 }
+
+std::optional<std::size_t> file_writer::tell() const noexcept {
+#if SNITCH_MMAP_OUTPUT_AVAILABLE
+    if (file_descriptor >= 0) {
+        return written_size;
+    }
+#endif
+
+    if (file_handle == nullptr) {
+        return {};
+    }
+
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    if (compressor != nullptr) {
+        // Positions in the compressed output do not match positions in the content.
+        return {};
+    }
+#endif
+
+    const long position = std::ftell(static_cast<std::FILE*>(file_handle));
+    if (position < 0) {
+        return {};
+    }
+
+    return static_cast<std::size_t>(position);
+}
+
+void file_writer::write_at(std::size_t position, std::string_view message) const noexcept {
+#if SNITCH_MMAP_OUTPUT_AVAILABLE
+    if (file_descriptor >= 0) {
+        std::memcpy(mapping + position, message.data(), message.size());
+        return;
+    }
+#endif
+
+    if (file_handle == nullptr) {
+        return;
+    }
+
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    if (compressor != nullptr) {
+        return;
+    }
+#endif
+
+    std::FILE* handle = static_cast<std::FILE*>(file_handle);
+    if (std::fseek(handle, static_cast<long>(position), SEEK_SET) != 0) {
+        return;
+    }
+
+    std::fwrite(message.data(), sizeof(char), message.length(), handle);
+    std::fseek(handle, 0, SEEK_END);
+    std::fflush(handle);
+}
 } // namespace snitch::impl
+
+#undef SNITCH_MMAP_OUTPUT_AVAILABLE
@@ -1,5 +1,9 @@
 #include "snitch/snitch_matcher.hpp"
 
+#include <cstring> // for std::memcpy
+#include <limits> // for std::numeric_limits
+#include <type_traits> // for std::make_signed_t
+
 namespace snitch::matchers {
 contains_substring::contains_substring(std::string_view pattern) noexcept :
     substring_pattern(pattern) {}
@@ -20,3 +24,143 @@ contains_substring::describe_match(std::string_view message, match_status status
 with_what_contains::with_what_contains(std::string_view pattern) noexcept :
     contains_substring(pattern) {}
 } // namespace snitch::matchers
+
+namespace snitch::impl {
+namespace {
+// Number of elements compared without an early exit. This lets the compiler turn the inner loop
+// into vector instructions; the loop only stops at the first block with a mismatch.
+constexpr std::size_t block_size = 64u;
+
+template<typename T, typename F>
+std::size_t find_mismatch(
+    const T* values, const T* targets, std::size_t size, std::size_t start, F&& is_match) noexcept {
+    // A counter as wide as the elements vectorizes best.
+    using counter_t = typename float_traits<T>::bits_full_t;
+
+    std::size_t i = start;
+    for (; i < size && size - i >= block_size; i += block_size) {
+        counter_t num_mismatches = 0u;
+        for (std::size_t j = 0; j < block_size; ++j) {
+            num_mismatches += is_match(values[i + j], targets[i + j]) ? 0u : 1u;
+        }
+
+        if (num_mismatches != 0u) {
+            break;
+        }
+    }
+
+    for (; i < size; ++i) {
+        if (!is_match(values[i], targets[i])) {
+            return i;
+        }
+    }
+
+    return size;
+}
+
+// Same as abs_float, is_within_abs, is_within_rel and ulp_distance, but without short-circuits
+// and branches, so they can be vectorized.
+template<typename T>
+T abs_no_branch(T f) noexcept {
+    return f < T{0} ? -f : f;
+}
+
+template<typename T>
+bool is_within_abs_no_branch(T value, T target, T margin) noexcept {
+    return (value == target) | (abs_no_branch(value - target) <= margin);
+}
+
+template<typename T>
+bool is_within_rel_no_branch(T value, T target, T epsilon) noexcept {
+    const T abs_value  = abs_no_branch(value);
+    const T abs_target = abs_no_branch(target);
+    const T largest    = abs_value > abs_target ? abs_value : abs_target;
+    return (value == target) | (abs_no_branch(value - target) <= epsilon * largest);
+}
+
+// Map the sign-and-magnitude representation to a monotonic integer; the arithmetic is done with
+// integers as wide as the elements.
+template<typename T>
+std::make_signed_t<typename float_traits<T>::bits_full_t> to_ordered(T f) noexcept {
+    using bits_full_t = typename float_traits<T>::bits_full_t;
+    using ordered_t   = std::make_signed_t<bits_full_t>;
+
+    bits_full_t bits;
+    std::memcpy(&bits, &f, sizeof(f));
+
+    const ordered_t magnitude = static_cast<ordered_t>(bits & ~float_traits<T>::sign_mask);
+    return (bits & float_traits<T>::sign_mask) != 0u ? -magnitude : magnitude;
+}
+
+template<typename T>
+bool is_within_ulps_no_branch(
+    T value, T target, typename float_traits<T>::bits_full_t max_ulps) noexcept {
+    using bits_full_t = typename float_traits<T>::bits_full_t;
+
+    // The distance between two finite numbers (or infinities) fits in the unsigned type.
+    const auto        a = to_ordered(value);
+    const auto        b = to_ordered(target);
+    const bits_full_t distance =
+        a > b ? static_cast<bits_full_t>(a) - static_cast<bits_full_t>(b)
+              : static_cast<bits_full_t>(b) - static_cast<bits_full_t>(a);
+    return (value == value) & (target == target) & (distance <= max_ulps);
+}
+
+template<typename T>
+typename float_traits<T>::bits_full_t clamp_ulps(std::uint64_t max_ulps) noexcept {
+    using bits_full_t = typename float_traits<T>::bits_full_t;
+    return max_ulps < std::numeric_limits<bits_full_t>::max()
+               ? static_cast<bits_full_t>(max_ulps)
+               : std::numeric_limits<bits_full_t>::max();
+}
+} // namespace
+
+std::size_t find_mismatch_abs(
+    const float* values, const float* targets, std::size_t size, std::size_t start,
+    float margin) noexcept {
+    return find_mismatch(values, targets, size, start, [margin](float value, float target) {
+        return is_within_abs_no_branch(value, target, margin);
+    });
+}
+
+std::size_t find_mismatch_abs(
+    const double* values, const double* targets, std::size_t size, std::size_t start,
+    double margin) noexcept {
+    return find_mismatch(values, targets, size, start, [margin](double value, double target) {
+        return is_within_abs_no_branch(value, target, margin);
+    });
+}
+
+std::size_t find_mismatch_rel(
+    const float* values, const float* targets, std::size_t size, std::size_t start,
+    float epsilon) noexcept {
+    return find_mismatch(values, targets, size, start, [epsilon](float value, float target) {
+        return is_within_rel_no_branch(value, target, epsilon);
+    });
+}
+
+std::size_t find_mismatch_rel(
+    const double* values, const double* targets, std::size_t size, std::size_t start,
+    double epsilon) noexcept {
+    return find_mismatch(values, targets, size, start, [epsilon](double value, double target) {
+        return is_within_rel_no_branch(value, target, epsilon);
+    });
+}
+
+std::size_t find_mismatch_ulps(
+    const float* values, const float* targets, std::size_t size, std::size_t start,
+    std::uint64_t max_ulps) noexcept {
+    const std::uint32_t max_ulps_32 = clamp_ulps<float>(max_ulps);
+    return find_mismatch(values, targets, size, start, [max_ulps_32](float value, float target) {
+        return is_within_ulps_no_branch(value, target, max_ulps_32);
+    });
+}
+
+std::size_t find_mismatch_ulps(
+    const double* values, const double* targets, std::size_t size, std::size_t start,
+    std::uint64_t max_ulps) noexcept {
+    return find_mismatch(values, targets, size, start, [max_ulps](double value, double target) {
+        return is_within_ulps_no_branch(value, target, max_ulps);
+    });
+}
+} // namespace snitch::impl
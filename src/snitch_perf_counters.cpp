@@ -0,0 +1,128 @@
+#include "snitch/snitch_perf_counters.hpp"
+
+#if SNITCH_WITH_PERF_COUNTERS
+
+#    if defined(__linux__)
+#        include <cstring> // for std::memset
+#        include <linux/perf_event.h> // for perf_event_attr
+#        include <sys/syscall.h> // for SYS_perf_event_open
+#        include <unistd.h> // for syscall, read, close
+#    endif
+
+namespace snitch::impl {
+namespace {
+#    if defined(__linux__)
+constexpr std::size_t num_perf_counters = 4u;
+
+constexpr std::uint64_t perf_counter_configs[num_perf_counters] = {
+    PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES};
+
+// Counters are opened once per thread, and stay enabled until the thread exits. Test cases
+// record the difference between two readings, so nested runs do not disturb each other.
+struct perf_counter_files {
+    int  fds[num_perf_counters] = {-1, -1, -1, -1};
+    bool opened                 = false;
+
+    perf_counter_files() noexcept = default;
+
+    perf_counter_files(const perf_counter_files&)            = delete;
+    perf_counter_files& operator=(const perf_counter_files&) = delete;
+
+    ~perf_counter_files() {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    void open() noexcept {
+        opened = true;
+
+        for (std::size_t i = 0; i < num_perf_counters; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type   = PERF_TYPE_HARDWARE;
+            attr.size   = sizeof(attr);
+            attr.config = perf_counter_configs[i];
+            // Only count user-space events, which is allowed by the default
+            // 'perf_event_paranoid' setting of most distributions.
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            // Count events of the calling thread, on any CPU. This fails if perf is not available
+            // or not permitted, in which case the counter is simply not reported.
+            fds[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+    }
+
+    std::optional<std::uint64_t> read(std::size_t i) const noexcept {
+        if (fds[i] < 0) {
+            return {};
+        }
+
+        struct {
+            std::uint64_t value        = 0;
+            std::uint64_t time_enabled = 0;
+            std::uint64_t time_running = 0;
+        } data;
+
+        if (::read(fds[i], &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) ||
+            data.time_running == 0u) {
+            return {};
+        }
+
+        if (data.time_running < data.time_enabled) {
+            // The counter was multiplexed with others; extrapolate to the full time.
+            return static_cast<std::uint64_t>(
+                static_cast<double>(data.value) * static_cast<double>(data.time_enabled) /
+                static_cast<double>(data.time_running));
+        }
+
+        return data.value;
+    }
+};
+
+SNITCH_THREAD_LOCAL perf_counter_files thread_perf_counters;
+#    endif
+
+std::optional<std::uint64_t>
+get_delta(const std::optional<std::uint64_t>& start, const std::optional<std::uint64_t>& end) {
+    if (!start.has_value() || !end.has_value()) {
+        return {};
+    }
+
+    return end.value() >= start.value() ? end.value() - start.value() : 0u;
+}
+} // namespace
+
+perf_counters read_perf_counters() noexcept {
+#    if defined(__linux__)
+    perf_counter_files& files = thread_perf_counters;
+    if (!files.opened) {
+        files.open();
+    }
+
+    return {
+        .instructions  = files.read(0),
+        .cycles        = files.read(1),
+        .cache_misses  = files.read(2),
+        .branch_misses = files.read(3)};
+#    else
+    return {};
+#    endif
+}
+
+perf_counters
+get_perf_counters_delta(const perf_counters& start, const perf_counters& end) noexcept {
+    return {
+        .instructions  = get_delta(start.instructions, end.instructions),
+        .cycles        = get_delta(start.cycles, end.cycles),
+        .cache_misses  = get_delta(start.cache_misses, end.cache_misses),
+        .branch_misses = get_delta(start.branch_misses, end.branch_misses)};
+}
+} // namespace snitch::impl
+
+#endif
@@ -0,0 +1,209 @@
+#include "snitch/snitch_profiler.hpp"
+
+#include "snitch/snitch_append.hpp"
+#include "snitch/snitch_string_utility.hpp"
+
+#if SNITCH_WITH_TIMINGS
+
+namespace snitch::impl {
+namespace {
+using namespace std::literals;
+
+// The collapsed stack format uses ';' as a separator; make sure names do not contain any.
+void append_sanitized(small_string_span path, std::string_view name) noexcept {
+    const std::size_t start = path.size();
+    append_or_truncate(path, name);
+    for (std::size_t i = start; i < path.size(); ++i) {
+        if (path[i] == ';' || path[i] == '\n') {
+            path[i] = ':';
+        }
+    }
+}
+
+bool is_child_of(const profile_entry& child, const profile_entry& parent) noexcept {
+    const std::string_view path = child.path;
+    return child.depth == parent.depth + 1 && path.starts_with(parent.path.str()) &&
+           path.size() > parent.path.size() && path[parent.path.size()] == ';';
+}
+
+std::string_view leaf_name(const profile_entry& e) noexcept {
+    const std::string_view path = e.path;
+    const std::size_t      pos  = path.rfind(';');
+    return pos == std::string_view::npos ? path : path.substr(pos + 1);
+}
+
+// Chrome trace timestamps are in microseconds; keep the nanosecond resolution as decimals.
+bool append_microseconds(small_string_span ss, time_point_t ns) noexcept {
+    const std::size_t fraction = ns % 1000u;
+    return append(
+        ss, ns / 1000u, ".", fraction < 100u ? "0" : "", fraction < 10u ? "0" : "", fraction);
+}
+} // namespace
+
+profiler::profiler(std::string_view path) : file(path) {
+    if (path.ends_with(".json"sv)) {
+        format = profile_format::chrome_trace;
+        file.write("{\"traceEvents\":[\n");
+    }
+}
+
+profiler::~profiler() {
+    if (format == profile_format::chrome_trace) {
+        file.write("\n]}\n");
+    }
+}
+
+bool profiler::section_exited(section_info sections, time_point_t end) noexcept {
+    small_string<max_message_length> path;
+    for (const auto& s : sections) {
+        if (!path.empty()) {
+            append_or_truncate(path, ";");
+        }
+        append_sanitized(path, s.id.name);
+    }
+
+    const section& current = sections.back();
+    for (auto& e : entries) {
+        if (e.path.str() == path.str()) {
+            ++e.calls;
+            e.total_time += end - current.start_time;
+            return true;
+        }
+    }
+
+    if (entries.available() == 0u) {
+        const bool first_overflow = !overflow_seen;
+        overflow_seen             = true;
+        return !first_overflow;
+    }
+
+    entries.push_back(
+        {.path        = path,
+         .depth       = sections.size(),
+         .calls       = 1u,
+         .first_start = current.start_time,
+         .total_time  = end - current.start_time});
+
+    return true;
+}
+
+void profiler::test_ended(
+    std::string_view test_name, time_point_t start, time_point_t end) noexcept {
+
+    small_string<max_message_length> name;
+    append_sanitized(name, test_name);
+
+    switch (format) {
+    case profile_format::collapsed_stack: write_collapsed_stack(name, end - start); break;
+    case profile_format::chrome_trace: write_chrome_trace(name, start, end - start); break;
+    }
+
+    entries.clear();
+    overflow_seen = false;
+}
+
+void profiler::write_collapsed_stack(std::string_view test_name, time_point_t duration) noexcept {
+    // Each line gives the "self" time of a stack, i.e., excluding the time spent in child sections.
+    const auto self_time = [&](time_point_t total, auto&& is_child) {
+        time_point_t children = 0;
+        for (const auto& c : entries) {
+            if (is_child(c)) {
+                children += c.total_time;
+            }
+        }
+        return children < total ? total - children : time_point_t{0};
+    };
+
+    small_string<max_message_length> stack;
+    small_string<32>                 value;
+
+    const auto write_line = [&](std::string_view path, time_point_t time) noexcept {
+        stack.clear();
+        append_or_truncate(stack, test_name, path.empty() ? "" : ";", path);
+        file.write(stack);
+
+        value.clear();
+        static_cast<void>(append(value, " ", time, "\n"));
+        file.write(value);
+    };
+
+    write_line({}, self_time(duration, [](const profile_entry& c) { return c.depth == 1u; }));
+    for (const auto& e : entries) {
+        const auto is_child = [&](const profile_entry& c) { return is_child_of(c, e); };
+        write_line(e.path, self_time(e.total_time, is_child));
+    }
+}
+
+void profiler::write_chrome_event(
+    std::string_view name,
+    std::string_view category,
+    time_point_t     start,
+    time_point_t     duration,
+    std::size_t      calls) noexcept {
+
+    small_string<max_message_length> escaped_name;
+    append_or_truncate(escaped_name, name);
+    static_cast<void>(escape_json_or_truncate(escaped_name));
+
+    file.write(first_record ? "{\"name\":\"" : ",\n{\"name\":\"");
+    file.write(escaped_name);
+
+    small_string<256> line;
+    append_or_truncate(
+        line, "\",\"cat\":\"", category, "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":");
+    append_microseconds(line, start);
+    append_or_truncate(line, ",\"dur\":");
+    append_microseconds(line, duration);
+    append_or_truncate(line, ",\"args\":{\"calls\":", calls, "}}");
+
+    file.write(line);
+    first_record = false;
+}
+
+void profiler::write_chrome_trace(
+    std::string_view test_name, time_point_t start, time_point_t duration) noexcept {
+
+    write_chrome_event(test_name, "test", start, duration, 1u);
+
+    // Sections are aggregated over all the runs of the test case, so they no longer have a
+    // meaningful position in time. Lay them out one after the other within their parent,
+    // in the order they were first entered.
+    small_vector<time_point_t, max_profile_entries> offsets;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        offsets.push_back(start);
+    }
+
+    for (std::size_t depth = 1; depth <= max_nested_sections; ++depth) {
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            const auto& e = entries[i];
+            if (e.depth != depth) {
+                continue;
+            }
+
+            // Find the parent section, if any.
+            std::size_t parent = entries.size();
+            for (std::size_t p = 0; p < entries.size(); ++p) {
+                if (is_child_of(e, entries[p])) {
+                    parent = p;
+                    break;
+                }
+            }
+
+            time_point_t offset = parent == entries.size() ? start : offsets[parent];
+            for (const auto& s : entries) {
+                const bool is_sibling =
+                    s.depth == depth &&
+                    (parent == entries.size() || is_child_of(s, entries[parent]));
+                if (is_sibling && s.first_start < e.first_start) {
+                    offset += s.total_time;
+                }
+            }
+
+            offsets[i] = offset;
+            write_chrome_event(leaf_name(e), "section", offset, e.total_time, e.calls);
+        }
+    }
+}
+} // namespace snitch::impl
+
+#endif
@@ -0,0 +1,104 @@
+#include "snitch/snitch_property.hpp"
+
+#include "snitch/snitch_section.hpp"
+
+#include <array> // for std::array
+#if SNITCH_WITH_MULTITHREADING
+#    include <atomic> // for std::atomic
+#    include <thread> // for std::thread
+#endif
+
+namespace snitch::impl {
+std::size_t get_property_threads() noexcept {
+#if SNITCH_WITH_MULTITHREADING
+    const std::size_t available = std::thread::hardware_concurrency();
+    if (available == 0u) {
+        return 1u;
+    }
+
+    return available < max_property_threads ? available : max_property_threads;
+#else
+    return 1u;
+#endif
+}
+
+bool evaluate_property(test_state& parent, const function_ref<void()>& func) noexcept {
+    test_case test{
+        .id       = parent.test.id,
+        .location = parent.test.location,
+        .func     = nullptr,
+        .state    = test_case_state::success};
+
+    test_state state{.reg = parent.reg, .test = test, .muted = true};
+    state.info.locations.push_back(
+        {test.location.file, test.location.line, location_type::test_case_scope});
+
+    // Each run through the sections starts from the generator state of the parent test.
+    const auto body = [&]() {
+        state.rng = parent.rng;
+        func();
+    };
+
+    test_state* previous_run = try_get_current_test();
+    set_current_test(&state);
+
+#if SNITCH_WITH_EXCEPTIONS
+    try {
+        run_sections(state, body);
+    } catch (const abort_exception&) {
+        // Test aborted, assume its state was already set accordingly.
+    } catch (...) {
+        test.state = test_case_state::failed;
+    }
+#else
+    run_sections(state, body);
+#endif
+
+    set_current_test(previous_run);
+
+    return test.state != test_case_state::failed;
+}
+
+std::size_t find_first_failure(
+    std::size_t count, const function_ref<bool(std::size_t) noexcept>& fails) noexcept {
+#if SNITCH_WITH_MULTITHREADING
+    if (count > 1u) {
+        std::array<bool, max_property_threads> failed = {};
+        std::atomic<std::size_t>               next   = 0u;
+
+        const auto work = [&]() noexcept {
+            for (std::size_t i = next++; i < count; i = next++) {
+                failed[i] = fails(i);
+            }
+        };
+
+        std::array<std::thread, max_property_threads> workers;
+        for (std::size_t t = 1u; t < count; ++t) {
+            workers[t] = std::thread(work);
+        }
+
+        work();
+
+        for (std::size_t t = 1u; t < count; ++t) {
+            workers[t].join();
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (failed[i]) {
+                return i;
+            }
+        }
+
+        return count;
+    }
+#endif
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (fails(i)) {
+            return i;
+        }
+    }
+
+    return count;
+}
+} // namespace snitch::impl
@@ -1,9 +1,33 @@
 #include "snitch/snitch_registry.hpp"
 
+#include "snitch/snitch_allocations.hpp"
+#include "snitch/snitch_perf_counters.hpp"
+#include "snitch/snitch_section.hpp"
+#include "snitch/snitch_startup_stats.hpp"
 #include "snitch/snitch_time.hpp"
+#include "snitch/snitch_watchdog.hpp"
 
 #include <algorithm> // for std::sort
 #include <optional> // for std::optional
+#include <tuple> // for std::tie
+
+#if SNITCH_WITH_LINKER_REGISTRATION
+// Bounds of the 'snitch_tests' section, defined by the linker. Weak, so that a test application
+// without any test case still links.
+extern "C" {
+[[gnu::weak]] extern const snitch::impl::registration_entry* const __start_snitch_tests[];
+[[gnu::weak]] extern const snitch::impl::registration_entry* const __stop_snitch_tests[];
+}
+
+namespace snitch::impl {
+namespace {
+// Entries of the file being loaded (as pointers into the section), sorted by line. Entries are
+// only loaded once, into the global registry, so this is not a member; it is too large for the
+// stack.
+constinit small_vector<const registration_entry* const*, max_test_cases> linked_entries;
+} // namespace
+} // namespace snitch::impl
+#endif
 
 // Testing framework implementation.
 // ---------------------------------
@@ -44,8 +68,11 @@ namespace tags {
 struct hidden {};
 struct may_fail {};
 struct should_fail {};
+struct timeout {
+    std::uint64_t milliseconds = 0u;
+};
 
-using parsed_tag = std::variant<std::string_view, hidden, may_fail, should_fail>;
+using parsed_tag = std::variant<std::string_view, hidden, may_fail, should_fail, timeout>;
 } // namespace tags
 
 // Requires: s contains a well-formed list of tags, each of length <= max_tag_length.
@@ -81,6 +108,12 @@ void for_each_tag(std::string_view s, F&& callback) {
             callback(tags::parsed_tag{tags::should_fail{}});
         }
 
+        if (t.starts_with("[!timeout="sv) && t.ends_with("]"sv)) {
+            if (const auto ms = parse_timeout(t.substr(10u, t.size() - 11u))) {
+                callback(tags::parsed_tag{tags::timeout{*ms}});
+            }
+        }
+
         callback(tags::parsed_tag(t));
     });
 }
@@ -97,19 +130,51 @@ bool has_hidden_tag(std::string_view tags) {
     return hidden;
 }
 
+// Minimum verbosity at which each type of event is reported.
+template<typename E>
+constexpr registry::verbosity min_verbosity = registry::verbosity::quiet;
+template<>
+constexpr registry::verbosity min_verbosity<event::test_run_started> = registry::verbosity::normal;
+template<>
+constexpr registry::verbosity min_verbosity<event::test_run_ended> = registry::verbosity::normal;
+template<>
+constexpr registry::verbosity min_verbosity<event::test_case_started> = registry::verbosity::high;
+template<>
+constexpr registry::verbosity min_verbosity<event::test_case_ended> = registry::verbosity::high;
+template<>
+constexpr registry::verbosity min_verbosity<event::section_started> = registry::verbosity::high;
+template<>
+constexpr registry::verbosity min_verbosity<event::section_ended> = registry::verbosity::high;
+template<>
+constexpr registry::verbosity min_verbosity<event::assertion_succeeded> =
+    registry::verbosity::full;
+
+// Check if events of type 'E' must be sent to the reporter. If not, the event (and the data it
+// refers to) does not need to be built.
+template<typename E>
+bool is_reported(const registry& r) noexcept {
+    return r.verbose >= min_verbosity<E> && (r.report_events & event::mask_bit<E>) != 0u;
+}
+
 template<typename F>
 void list_tests(const registry& r, F&& predicate) noexcept {
-    r.report_callback(r, event::list_test_run_started{});
+    if (is_reported<event::list_test_run_started>(r)) {
+        r.report_callback(r, event::list_test_run_started{});
+    }
 
-    for (const test_case& t : r.test_cases()) {
-        if (!predicate(t.id)) {
-            continue;
-        }
+    if (is_reported<event::test_case_listed>(r)) {
+        for (const test_case& t : r.test_cases()) {
+            if (!predicate(t.id)) {
+                continue;
+            }
 
-        r.report_callback(r, event::test_case_listed{t.id, t.location});
+            r.report_callback(r, event::test_case_listed{t.id, t.location});
+        }
     }
 
-    r.report_callback(r, event::list_test_run_ended{});
+    if (is_reported<event::list_test_run_ended>(r)) {
+        r.report_callback(r, event::list_test_run_ended{});
+    }
 }
 
 void set_state(test_case& t, impl::test_case_state s) noexcept {
@@ -305,7 +370,8 @@ std::string_view registry::add_reporter(
     const std::optional<initialize_report_function>& initialize,
     const std::optional<configure_report_function>&  configure,
     const report_function&                           report,
-    const std::optional<finish_report_function>&     finish) {
+    const std::optional<finish_report_function>&     finish,
+    event::mask                                      events) {
 
     if (registered_reporters.available() == 0u) {
         using namespace snitch::impl;
@@ -329,27 +395,32 @@ std::string_view registry::add_reporter(
         name, initialize.value_or([](registry&) noexcept {}),
         configure.value_or(
             [](registry&, std::string_view, std::string_view) noexcept { return false; }),
-        report, finish.value_or([](registry&) noexcept {})});
+        report, finish.value_or([](registry&) noexcept {}), events});
 
     return name;
 }
 
 void registry::destroy_reporter(registry&) noexcept {
-    reporter_storage.reset();
+    reporter_storage[current_reporter].reset();
 }
 
 void registry::report_default(const registry&, const event::data& e) noexcept {
     using default_reporter = reporter::console::reporter;
 
-    if (reporter_storage.type() != type_id<default_reporter>()) {
-        reporter_storage.emplace<default_reporter>(*this);
+    auto& storage = reporter_storage[current_reporter];
+    if (storage.type() != type_id<default_reporter>()) {
+        storage.emplace<default_reporter>(*this);
     }
 
-    reporter_storage.get<default_reporter>().report(*this, e);
+    storage.get<default_reporter>().report(*this, e);
 }
 
 const char*
 registry::add_impl(const test_id& id, const source_location& location, impl::test_ptr func) {
+#if SNITCH_WITH_TIMINGS
+    impl::start_startup_phase(impl::startup_phase::registration);
+#endif
+
     if (test_list.available() == 0u) {
         using namespace snitch::impl;
         print(
@@ -387,8 +458,22 @@ const char* registry::add_fixture(
     return add_impl({.name = id.name, .tags = id.tags, .fixture = id.fixture}, location, func);
 }
 
+#if SNITCH_WITH_LINKER_REGISTRATION
+namespace impl {
+void add_test_entry(registry& reg, const registration_entry& entry) {
+    reg.add({entry.id.name, entry.id.tags}, entry.location, entry.func);
+}
+
+void add_fixture_entry(registry& reg, const registration_entry& entry) {
+    reg.add_fixture(entry.id, entry.location, entry.func);
+}
+} // namespace impl
+#endif
+
 namespace {
 void register_assertion(bool success, impl::test_state& state) {
+    impl::check_timeout(state);
+
     if (!success) {
         if (state.may_fail || state.should_fail) {
             ++state.asserts;
@@ -413,6 +498,12 @@ void register_assertion(bool success, impl::test_state& state) {
             ++state.asserts;
             ++state.failures;
 
+            // Failures of muted runs (e.g., when shrinking a property) are not reported, and those
+            // of runs which will be retried may not be final.
+            if (!state.muted && !state.may_retry) {
+                state.reg.count_failure();
+            }
+
             for (auto& section : state.info.sections.current_section) {
                 ++section.assertion_count;
                 ++section.assertion_failure_count;
@@ -455,6 +546,15 @@ void report_assertion_impl(
 
     register_assertion(success, state);
 
+    if (state.muted) {
+        return;
+    }
+
+    if (success ? !impl::is_reported<event::assertion_succeeded>(r)
+                : !impl::is_reported<event::assertion_failed>(r)) {
+        return;
+    }
+
 #if SNITCH_WITH_EXCEPTIONS
     const bool use_held_info = (state.unhandled_exception || std::uncaught_exceptions() > 0) &&
                                state.held_info.has_value();
@@ -481,18 +581,22 @@ void report_assertion_impl(
 #endif
 
     if (success) {
-        if (r.verbose >= registry::verbosity::full) {
-            r.report_callback(
-                r, event::assertion_succeeded{
-                       state.test.id, current_section, captures_buffer.span(), location, data});
-        }
+        r.report_callback(
+            r, event::assertion_succeeded{
+                   state.test.id, current_section, captures_buffer.span(), location, data});
     } else {
         r.report_callback(
             r, event::assertion_failed{
                    state.test.id, current_section, captures_buffer.span(), location, data,
-                   state.should_fail, state.may_fail});
+                   state.should_fail, state.may_fail, state.may_retry});
     }
 }
+
+// True if the last run of the test case failed, and it must be run again (see '--retry').
+bool must_retry(const registry& r, const impl::test_case& t, std::size_t retries) noexcept {
+    return t.state == impl::test_case_state::failed && retries < r.max_retries &&
+           !r.is_aborting();
+}
 } // namespace
 
 void registry::report_assertion(bool success, std::string_view message) noexcept {
@@ -527,6 +631,10 @@ void registry::report_skipped(std::string_view message) noexcept {
     impl::test_state& state = impl::get_current_test();
     impl::set_state(state.test, impl::test_case_state::skipped);
 
+    if (state.muted || !impl::is_reported<event::test_case_skipped>(state.reg)) {
+        return;
+    }
+
     const auto  captures_buffer = impl::make_capture_buffer(state.info.captures);
     const auto& location        = state.info.locations.back();
 
@@ -542,7 +650,7 @@ void registry::report_skipped(std::string_view message) noexcept {
 void registry::report_section_started(const section& sec) noexcept {
     const impl::test_state& state = impl::get_current_test();
 
-    if (state.reg.verbose < registry::verbosity::high) {
+    if (state.muted || !impl::is_reported<event::section_started>(state.reg)) {
         return;
     }
 
@@ -552,7 +660,7 @@ void registry::report_section_started(const section& sec) noexcept {
 void registry::report_section_ended(const section& sec) noexcept {
     const impl::test_state& state = impl::get_current_test();
 
-    if (state.reg.verbose < registry::verbosity::high) {
+    if (state.muted || !impl::is_reported<event::section_ended>(state.reg)) {
         return;
     }
 
@@ -581,64 +689,106 @@ void registry::report_section_ended(const section& sec) noexcept {
 #endif
 }
 
-impl::test_state registry::run(impl::test_case& test) noexcept {
-    if (verbose >= registry::verbosity::high) {
-        report_callback(*this, event::test_case_started{test.id, test.location});
+void registry::report_section_exited([[maybe_unused]] section_info sections) noexcept {
+#if SNITCH_WITH_TIMINGS
+    impl::test_state& state = impl::get_current_test();
+
+    if (state.muted || (!state.reg.profiler.has_value() && !state.reg.durations.has_value())) {
+        return;
+    }
+
+    const auto time_end = get_current_time();
+
+    if (state.reg.durations.has_value()) {
+        state.reg.durations->section_exited(sections, time_end - sections.back().start_time);
+    }
+
+    if (state.reg.profiler.has_value() && !state.reg.profiler->section_exited(sections, time_end)) {
+        using namespace snitch::impl;
+        state.reg.print(
+            make_colored("warning:", state.reg.with_color, color::warning),
+            " max number of profiled sections reached in test case; "
+            "please increase 'SNITCH_MAX_PROFILE_ENTRIES' (currently ",
+            max_profile_entries, ").\n");
+    }
+#endif
+}
+
+impl::test_state registry::run(impl::test_case& test, std::size_t retries) noexcept {
+    if (impl::is_reported<event::test_case_started>(*this)) {
+        report_callback(
+            *this, event::test_case_started{
+                       .id = test.id, .location = test.location, .retries = retries});
+    }
+
+    // Output printed by the test case itself is not buffered; write out what was printed so far,
+    // so it comes first.
+    if (impl::get_stdout_flush_policy() == impl::stdout_flush_policy::test_case) {
+        impl::stdout_flush();
     }
 
     test.state = impl::test_case_state::success;
 
     // Fetch special tags for this test case.
-    bool may_fail    = false;
-    bool should_fail = false;
+    bool          may_fail    = false;
+    bool          should_fail = false;
+    std::uint64_t timeout_ms  = test_timeout_ms;
     impl::for_each_tag(test.id.tags, [&](const impl::tags::parsed_tag& v) {
         if (std::holds_alternative<impl::tags::may_fail>(v)) {
             may_fail = true;
         } else if (std::holds_alternative<impl::tags::should_fail>(v)) {
             should_fail = true;
+        } else if (const auto* t = std::get_if<impl::tags::timeout>(&v)) {
+            timeout_ms = t->milliseconds;
         }
     });
 
     impl::test_state state{
-        .reg = *this, .test = test, .may_fail = may_fail, .should_fail = should_fail};
+        .reg         = *this,
+        .test        = test,
+        .may_fail    = may_fail,
+        .should_fail = should_fail,
+        .retries     = retries,
+        .may_retry   = retries < max_retries};
 
     state.info.locations.push_back(
         {test.location.file, test.location.line, location_type::test_case_scope});
 
+    // Reseed the random number generator on each run through the sections, so that every leaf
+    // section sees the same sequence of numbers.
+    const std::uint64_t seed = impl::get_test_seed(rng_seed, test.id);
+    const auto          body = [&]() {
+        state.rng.seed(seed);
+        test.func();
+    };
+
     // Store previously running test, to restore it later.
     // This should always be a null pointer, except when testing snitch itself.
     impl::test_state* previous_run = impl::try_get_current_test();
     impl::set_current_test(&state);
 
 #if SNITCH_WITH_TIMINGS
+    impl::start_startup_phase(impl::startup_phase::first_test_case);
     const auto time_start = get_current_time();
 #endif
 
-#if SNITCH_WITH_EXCEPTIONS
-    try {
+#if SNITCH_WITH_PERF_COUNTERS
+    const auto counters_start = impl::read_perf_counters();
 #endif
 
-        do {
-            // Reset section state.
-            state.info.sections.leaf_executed = false;
-            for (std::size_t i = 0; i < state.info.sections.levels.size(); ++i) {
-                state.info.sections.levels[i].current_section_id = 0;
-            }
+#if SNITCH_WITH_ALLOCATION_TRACKING
+    const impl::allocation_scope allocations;
+#endif
 
-            // Run the test case.
-            test.func();
+    if (timeout_ms > 0u) {
+        impl::watch_test(state, timeout_ms, &impl::report_timeout);
+    }
 
-            if (state.info.sections.levels.size() == 1) {
-                // This test case contained sections; check if there are any more left to evaluate.
-                auto& child = state.info.sections.levels[0];
-                if (child.previous_section_id == child.max_section_id) {
-                    // No more; clear the section state.
-                    state.info.sections.levels.clear();
-                    state.info.sections.current_section.clear();
-                }
-            }
-        } while (!state.info.sections.levels.empty() &&
-                 state.test.state != impl::test_case_state::skipped);
+#if SNITCH_WITH_EXCEPTIONS
+    try {
+#endif
+
+        impl::run_sections(state, body);
 
 #if SNITCH_WITH_EXCEPTIONS
         state.in_check = true;
@@ -662,6 +812,10 @@ impl::test_state registry::run(impl::test_case& test) noexcept {
     state.unhandled_exception = false;
 #endif
 
+    if (timeout_ms > 0u) {
+        impl::unwatch_test();
+    }
+
     if (state.should_fail) {
         state.should_fail = false;
         state.in_check    = true;
@@ -671,31 +825,58 @@ impl::test_state registry::run(impl::test_case& test) noexcept {
         state.should_fail = true;
     }
 
+#if SNITCH_WITH_ALLOCATION_TRACKING
+    state.allocations = allocations.stop();
+#endif
+
+#if SNITCH_WITH_PERF_COUNTERS
+    state.counters = impl::get_perf_counters_delta(counters_start, impl::read_perf_counters());
+#endif
+
 #if SNITCH_WITH_TIMINGS
-    state.duration = get_duration_in_seconds(time_start, get_current_time());
+    const auto time_end = get_current_time();
+    state.duration      = get_duration_in_seconds(time_start, time_end);
+    impl::end_startup_phase(impl::startup_phase::first_test_case);
+
+    if (profiler.has_value()) {
+        small_string<max_test_name_length> buffer;
+        profiler->test_ended(impl::make_full_name(buffer, test.id), time_start, time_end);
+    }
+
+    if (durations.has_value()) {
+        small_string<max_test_name_length> buffer;
+        durations->test_case_ended(impl::make_full_name(buffer, test.id), time_end - time_start);
+    }
 #endif
 
-    if (verbose >= registry::verbosity::high) {
+    if (impl::is_reported<event::test_case_ended>(*this)) {
+        event::test_case_ended e{
+            .id                              = test.id,
+            .location                        = test.location,
+            .assertion_count                 = state.asserts,
+            .assertion_failure_count         = state.failures,
+            .allowed_assertion_failure_count = state.allowed_failures,
+            .state                           = impl::convert_to_public_state(state.test.state),
+            .retries                         = retries,
+            .will_retry                      = must_retry(*this, test, retries)};
+
 #if SNITCH_WITH_TIMINGS
-        report_callback(
-            *this, event::test_case_ended{
-                       .id                              = test.id,
-                       .location                        = test.location,
-                       .assertion_count                 = state.asserts,
-                       .assertion_failure_count         = state.failures,
-                       .allowed_assertion_failure_count = state.allowed_failures,
-                       .state    = impl::convert_to_public_state(state.test.state),
-                       .duration = state.duration});
-#else
-        report_callback(
-            *this, event::test_case_ended{
-                       .id                              = test.id,
-                       .location                        = test.location,
-                       .assertion_count                 = state.asserts,
-                       .assertion_failure_count         = state.failures,
-                       .allowed_assertion_failure_count = state.allowed_failures,
-                       .state = impl::convert_to_public_state(state.test.state)});
+        e.duration = state.duration;
+#endif
+
+#if SNITCH_WITH_PERF_COUNTERS
+        e.counters = state.counters;
+#endif
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+        e.allocations = state.allocations;
 #endif
+
+        report_callback(*this, e);
+    }
+
+    if (impl::get_stdout_flush_policy() == impl::stdout_flush_policy::test_case) {
+        impl::stdout_flush();
     }
 
     impl::set_current_test(previous_run);
@@ -708,35 +889,106 @@ bool registry::run_selected_tests(
     const filter_info&                                 filter_strings,
     const function_ref<bool(const test_id&) noexcept>& predicate) noexcept {
 
-    if (verbose >= registry::verbosity::normal) {
+    if (impl::is_reported<event::test_run_started>(*this)) {
         report_callback(
-            *this, event::test_run_started{.name = run_name, .filters = filter_strings});
+            *this, event::test_run_started{
+                       .name = run_name, .filters = filter_strings, .rng_seed = rng_seed});
     }
 
-    bool        success                         = true;
-    std::size_t run_count                       = 0;
-    std::size_t fail_count                      = 0;
-    std::size_t allowed_fail_count              = 0;
-    std::size_t skip_count                      = 0;
-    std::size_t assertion_count                 = 0;
-    std::size_t assertion_failure_count         = 0;
-    std::size_t allowed_assertion_failure_count = 0;
+    run_totals   = {.name = run_name, .filters = filter_strings};
+    run_failures = 0u;
+    aborting     = false;
 
 #if SNITCH_WITH_TIMINGS
-    const auto time_start = get_current_time();
+    run_start = get_current_time();
+
+    if (durations.has_value()) {
+        durations->clear();
+    }
 #endif
 
+    // Gather the selected tests, and sort them in the requested order.
+    selected_tests.clear();
     for (impl::test_case& t : this->test_cases()) {
-        if (!predicate(t.id)) {
-            continue;
+        if (predicate(t.id)) {
+            selected_tests.push_back(
+                {&t, order == test_order::random ? impl::get_test_seed(rng_seed, t.id) : 0u});
+        }
+    }
+
+    // Skip the tests known to pass from previous runs of the same build (see '--cache').
+    if (cache.has_value() && cache->mode != impl::cache_mode::record) {
+        const auto failed_before = [&](const selected_test& s) {
+            return cache->find(s.test->id) == impl::cached_result::failed;
+        };
+
+        const bool only_failed =
+            cache->mode == impl::cache_mode::only_failed &&
+            std::any_of(selected_tests.begin(), selected_tests.end(), failed_before);
+
+        const auto end = std::remove_if(
+            selected_tests.begin(), selected_tests.end(), [&](const selected_test& s) {
+                if (only_failed) {
+                    return !failed_before(s);
+                } else {
+                    return cache->find(s.test->id) == impl::cached_result::passed;
+                }
+            });
+
+        selected_tests.resize(static_cast<std::size_t>(end - selected_tests.begin()));
+    }
+
+    // Ties are broken by declaration order (the tests are stored contiguously). The random order
+    // sorts on a hash of the seed and the test name, rather than shuffling, so the relative order
+    // of two tests only depends on the seed, and not on which other tests are selected.
+    switch (order) {
+    case test_order::declaration: {
+        break;
+    }
+    case test_order::lexical: {
+        std::sort(selected_tests.begin(), selected_tests.end(), [](const auto& a, const auto& b) {
+            return std::tie(a.test->id.name, a.test->id.type, a.test) <
+                   std::tie(b.test->id.name, b.test->id.type, b.test);
+        });
+        break;
+    }
+    case test_order::random: {
+        std::sort(selected_tests.begin(), selected_tests.end(), [](const auto& a, const auto& b) {
+            return std::tie(a.key, a.test) < std::tie(b.key, b.test);
+        });
+        break;
+    }
+    }
+
+    for (const selected_test& s : selected_tests) {
+        impl::test_case& t = *s.test;
+
+        if (is_aborting()) {
+            break;
         }
 
-        auto state = run(t);
+        // Failed test cases are run again, up to 'max_retries' times, until they pass. The
+        // assertions of all runs are counted, since they have all been reported, but only the
+        // failures of the last run count towards the abort limit.
+        std::size_t retries = 0;
+        while (true) {
+            const auto state = run(t, retries);
+
+            run_totals.assertion_count += state.asserts;
+            run_totals.assertion_failure_count += state.failures;
+            run_totals.allowed_assertion_failure_count += state.allowed_failures;
+
+            if (!must_retry(*this, t, retries)) {
+                break;
+            }
+
+            ++retries;
+        }
 
-        ++run_count;
-        assertion_count += state.asserts;
-        assertion_failure_count += state.failures;
-        allowed_assertion_failure_count += state.allowed_failures;
+        ++run_totals.run_count;
+        if (retries > 0 && t.state != impl::test_case_state::failed) {
+            ++run_totals.flaky_count;
+        }
 
         switch (t.state) {
         case impl::test_case_state::success: {
@@ -744,16 +996,16 @@ bool registry::run_selected_tests(
             break;
         }
         case impl::test_case_state::allowed_fail: {
-            ++allowed_fail_count;
+            ++run_totals.allowed_fail_count;
             break;
         }
         case impl::test_case_state::failed: {
-            ++fail_count;
-            success = false;
+            ++run_totals.fail_count;
+            run_totals.success = false;
             break;
         }
         case impl::test_case_state::skipped: {
-            ++skip_count;
+            ++run_totals.skip_count;
             break;
         }
         case impl::test_case_state::not_run: {
@@ -763,46 +1015,96 @@ bool registry::run_selected_tests(
         }
     }
 
+    if (cache.has_value() && !cache->save(std::as_const(*this).test_cases())) {
+        using namespace snitch::impl;
+        cli::print(
+            make_colored("warning:", with_color, color::warning),
+            " could not write the test result cache\n");
+    }
+
 #if SNITCH_WITH_TIMINGS
-    const float duration = get_duration_in_seconds(time_start, get_current_time());
+    run_totals.duration = get_duration_in_seconds(run_start, get_current_time());
+
+    if (durations.has_value()) {
+        // Reported by the console reporter.
+        static_cast<void>(durations->sort());
+    }
 #endif
 
-    if (verbose >= registry::verbosity::normal) {
-#if SNITCH_WITH_TIMINGS
-        report_callback(
-            *this, event::test_run_ended{
-                       .name                            = run_name,
-                       .filters                         = filter_strings,
-                       .run_count                       = run_count,
-                       .fail_count                      = fail_count,
-                       .allowed_fail_count              = allowed_fail_count,
-                       .skip_count                      = skip_count,
-                       .assertion_count                 = assertion_count,
-                       .assertion_failure_count         = assertion_failure_count,
-                       .allowed_assertion_failure_count = allowed_assertion_failure_count,
-                       .duration                        = duration,
-                       .success                         = success,
-                   });
-#else
+    run_totals.aborted = is_aborting();
+    if (impl::is_reported<event::test_run_ended>(*this)) {
+        report_callback(*this, run_totals);
+    }
+
+    return run_totals.success;
+}
+
+void registry::count_failure() noexcept {
+    if (++run_failures == abort_after) {
+        aborting = true;
+    }
+}
+
+bool registry::is_aborting() const noexcept {
+    return aborting;
+}
+
+void registry::end_timed_out_run(
+    const impl::test_state&        state,
+    [[maybe_unused]] std::uint64_t timeout_ms,
+    std::string_view               message) noexcept {
+
+    // The test case is still running on another thread, and may hold locks or be in the middle of
+    // an assertion; only read what is needed to report it.
+    const auto captures_buffer = impl::make_capture_buffer(state.info.captures);
+    const auto location        = state.info.locations.back();
+
+    if (impl::is_reported<event::assertion_failed>(*this)) {
         report_callback(
-            *this, event::test_run_ended{
-                       .name                            = run_name,
-                       .filters                         = filter_strings,
-                       .run_count                       = run_count,
-                       .fail_count                      = fail_count,
-                       .allowed_fail_count              = allowed_fail_count,
-                       .skip_count                      = skip_count,
-                       .assertion_count                 = assertion_count,
-                       .assertion_failure_count         = assertion_failure_count,
-                       .allowed_assertion_failure_count = allowed_assertion_failure_count,
-                       .success                         = success});
+            *this, event::assertion_failed{
+                       state.test.id, state.info.sections.current_section, captures_buffer.span(),
+                       location, message});
+    }
+
+    if (impl::is_reported<event::test_case_ended>(*this)) {
+        event::test_case_ended e{
+            .id                              = state.test.id,
+            .location                        = state.test.location,
+            .assertion_count                 = state.asserts + 1u,
+            .assertion_failure_count         = state.failures + 1u,
+            .allowed_assertion_failure_count = state.allowed_failures,
+            .state                           = test_case_state::failed,
+            .retries                         = state.retries};
+
+#if SNITCH_WITH_TIMINGS
+        e.duration = static_cast<float>(static_cast<double>(timeout_ms) / 1000.0);
 #endif
+
+        report_callback(*this, e);
     }
 
-    return success;
+    ++run_totals.run_count;
+    ++run_totals.fail_count;
+    run_totals.assertion_count += state.asserts + 1u;
+    run_totals.assertion_failure_count += state.failures + 1u;
+    run_totals.allowed_assertion_failure_count += state.allowed_failures;
+    run_totals.success = false;
+    run_totals.aborted = true;
+
+#if SNITCH_WITH_TIMINGS
+    run_totals.duration = get_duration_in_seconds(run_start, get_current_time());
+#endif
+
+    if (impl::is_reported<event::test_run_ended>(*this)) {
+        report_callback(*this, run_totals);
+    }
+
+    finish_run();
 }
 
 bool registry::run_tests(std::string_view run_name) noexcept {
+    load_linked_tests();
+
     // The default run simply filters out the hidden tests.
     const auto filter = [](const test_id& id) { return !impl::has_hidden_tag(id.tags); };
 
@@ -899,30 +1201,47 @@ bool run_tests_impl(registry& r, const cli::input& args) noexcept {
 } // namespace
 
 bool registry::run_tests(const cli::input& args) noexcept {
+    load_linked_tests();
+
     // Run tests.
     const bool success = run_tests_impl(*this, args);
 
+    finish_run();
+
+    return success;
+}
+
+void registry::finish_run() noexcept {
     // Tell the current reporter we are done.
     finish_callback(*this);
 
     // Close the output file, if any.
     file_writer.reset();
 
-    return success;
+    // Write out the buffered standard output.
+    impl::stdout_flush();
+
+#if SNITCH_WITH_TIMINGS
+    // Close the profile file, if any.
+    profiler.reset();
+#endif
 }
 
 namespace impl {
-void parse_reporter(
+// Returns false if the reporter could not be found. The 'out' option is not forwarded to the
+// reporter; its value is stored in 'output' instead.
+bool parse_reporter(
     registry&                                    r,
     small_vector_span<const registered_reporter> reporters,
-    std::string_view                             arg) noexcept {
+    std::string_view                             arg,
+    std::optional<std::string_view>&             output) noexcept {
 
     if (arg.empty() || arg[0] == ':') {
         using namespace snitch::impl;
         cli::print(
             make_colored("warning:", r.with_color, color::warning), " invalid reporter '", arg,
             "', using default\n");
-        return;
+        return false;
     }
 
     // Isolate reporter name and options
@@ -948,7 +1267,7 @@ void parse_reporter(
             cli::print(
                 make_colored("note:", r.with_color, color::status), "  ", reporter.name, "\n");
         }
-        return;
+        return false;
     }
 
     // Initialise reporter now, so we can configure it.
@@ -976,6 +1295,11 @@ void parse_reporter(
         std::string_view option_name  = option.substr(0, equal_pos);
         std::string_view option_value = option.substr(equal_pos + 1);
 
+        if (option_name == "out") {
+            output = option_value;
+            continue;
+        }
+
         if (!iter->configure(r, option_name, option_value)) {
             using namespace snitch::impl;
             cli::print(
@@ -987,6 +1311,8 @@ void parse_reporter(
     // Register reporter callbacks
     r.report_callback = iter->callback;
     r.finish_callback = iter->finish;
+    r.report_events   = iter->events;
+    return true;
 }
 
 bool parse_colour_mode_option(registry& reg, std::string_view color_option) noexcept {
@@ -1028,7 +1354,156 @@ bool parse_color_option(registry& reg, std::string_view color_option) noexcept {
 }
 } // namespace impl
 
+namespace {
+// Minimum verbosity at which an event is reported.
+registry::verbosity get_min_verbosity(const event::data& e) noexcept {
+    return std::visit(
+        []<typename E>(const E&) { return impl::min_verbosity<E>; }, e);
+}
+
+// Print function writing to the given file, if any, or to the default output otherwise.
+print_function
+get_output(std::optional<impl::file_writer>& file, const print_function& default_output) noexcept {
+    if (file.has_value()) {
+        return {*file, constant<&impl::file_writer::write>{}};
+    }
+
+    return default_output;
+}
+} // namespace
+
+void registry::configure_reporters(
+    small_vector_span<const std::string_view> reporters, bool color_override) noexcept {
+
+    // Close the outputs of the reporters from a previous configuration, if any.
+    for (auto& reporter : active_reporters) {
+        reporter.file_writer.reset();
+    }
+    active_reporters.clear();
+    current_reporter = 0;
+
+    if (reporters.size() == 1u) {
+        // Single reporter; it is called directly.
+        std::optional<std::string_view> output;
+        if (impl::parse_reporter(*this, registered_reporters, reporters[0], output) &&
+            output.has_value()) {
+            file_writer = impl::file_writer{output.value()};
+
+            if (!color_override) {
+                with_color = false;
+            }
+
+            print_callback = {*file_writer, snitch::constant<&impl::file_writer::write>{}};
+        }
+
+        return;
+    }
+
+    // Multiple reporters; events are sent to each of them by report_all(), which gives each
+    // reporter its own storage, verbosity, color setting, and output.
+    const verbosity requested_verbose = verbose;
+    const bool      requested_color   = with_color;
+    verbosity       max_verbose       = verbose;
+    event::mask     used_events       = 0u;
+
+    for (const auto& arg : reporters) {
+        current_reporter = active_reporters.size();
+        verbose          = requested_verbose;
+        with_color       = requested_color;
+
+        std::optional<std::string_view> output;
+        if (!impl::parse_reporter(*this, registered_reporters, arg, output)) {
+            continue;
+        }
+
+        active_reporters.grow(1);
+        active_reporter& reporter = active_reporters.back();
+        reporter.callback         = report_callback;
+        reporter.finish           = finish_callback;
+        reporter.verbose          = verbose;
+        reporter.events           = report_events;
+        reporter.with_color       = with_color;
+
+        if (output.has_value()) {
+            reporter.file_writer.emplace(output.value());
+
+            if (!color_override) {
+                reporter.with_color = false;
+            }
+        }
+
+        max_verbose = std::max(max_verbose, verbose);
+        used_events |= report_events;
+    }
+
+    current_reporter = 0;
+    with_color       = requested_color;
+
+    if (active_reporters.empty()) {
+        verbose = requested_verbose;
+        return;
+    }
+
+    verbose         = max_verbose;
+    report_events   = used_events;
+    report_callback = {*this, constant<&registry::report_all>{}};
+    finish_callback = {*this, constant<&registry::finish_all>{}};
+}
+
+void registry::report_all(const registry&, const event::data& e) noexcept {
+    const verbosity      min_verbose      = get_min_verbosity(e);
+    const event::mask    type             = event::mask_of(e);
+    const verbosity      previous_verbose = verbose;
+    const bool           previous_color   = with_color;
+    const print_function previous_print   = print_callback;
+
+    for (std::size_t i = 0; i < active_reporters.size(); ++i) {
+        active_reporter& reporter = active_reporters[i];
+        if (reporter.verbose < min_verbose || (reporter.events & type) == 0u) {
+            continue;
+        }
+
+        current_reporter = i;
+        verbose          = reporter.verbose;
+        with_color       = reporter.with_color;
+        print_callback   = get_output(reporter.file_writer, previous_print);
+
+        reporter.callback(*this, e);
+    }
+
+    current_reporter = 0;
+    verbose          = previous_verbose;
+    with_color       = previous_color;
+    print_callback   = previous_print;
+}
+
+void registry::finish_all(registry&) noexcept {
+    const bool           previous_color = with_color;
+    const print_function previous_print = print_callback;
+
+    for (std::size_t i = 0; i < active_reporters.size(); ++i) {
+        active_reporter& reporter = active_reporters[i];
+
+        current_reporter = i;
+        with_color       = reporter.with_color;
+        print_callback   = get_output(reporter.file_writer, previous_print);
+
+        reporter.finish(*this);
+        reporter.file_writer.reset();
+    }
+
+    current_reporter = 0;
+    with_color       = previous_color;
+    print_callback   = previous_print;
+}
+
 void registry::configure(const cli::input& args) {
+#if SNITCH_WITH_TIMINGS
+    impl::start_startup_phase(impl::startup_phase::configure);
+#endif
+
+    load_linked_tests();
+
     bool color_override = false;
     if (auto opt = get_option(args, "--colour-mode")) {
         color_override = impl::parse_colour_mode_option(*this, *opt->value);
@@ -1055,6 +1530,145 @@ void registry::configure(const cli::input& args) {
         }
     }
 
+    if (auto opt = get_option(args, "--flush")) {
+        if (*opt->value == "line") {
+            impl::set_stdout_flush_policy(impl::stdout_flush_policy::line);
+        } else if (*opt->value == "test-case") {
+            impl::set_stdout_flush_policy(impl::stdout_flush_policy::test_case);
+        } else if (*opt->value == "exit") {
+            impl::set_stdout_flush_policy(impl::stdout_flush_policy::exit);
+        } else {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning),
+                " unknown flush policy; please use one of line|test-case|exit\n");
+        }
+    }
+
+    if (auto opt = get_option(args, "--cache")) {
+        // The build fingerprint; results recorded with a different fingerprint are discarded.
+        std::optional<std::uint64_t> build;
+        if (auto key = get_option(args, "--cache-key")) {
+            build = impl::hash_string(*key->value);
+        } else {
+#if defined(__linux__)
+            build = impl::hash_file("/proc/self/exe");
+#endif
+            if (!build.has_value()) {
+                build = impl::hash_file(args.executable_path);
+            }
+        }
+
+        if (!build.has_value()) {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning),
+                " could not read the test application to identify the build; please use "
+                "--cache-key\n");
+        } else {
+            cache.emplace();
+            if (!cache->open(*opt->value, args.executable, *build)) {
+                using namespace snitch::impl;
+                cli::print(
+                    make_colored("warning:", with_color, color::warning),
+                    " cache path is too long (please increase 'SNITCH_MAX_PATH_LENGTH')\n");
+                cache.reset();
+            }
+        }
+
+        if (cache.has_value()) {
+            if (get_option(args, "--only-failed")) {
+                cache->mode = impl::cache_mode::only_failed;
+            } else if (get_option(args, "--skip-cached-passes")) {
+                cache->mode = impl::cache_mode::skip_passes;
+            }
+        }
+    } else if (
+        get_option(args, "--cache-key") || get_option(args, "--only-failed") ||
+        get_option(args, "--skip-cached-passes")) {
+        using namespace snitch::impl;
+        cli::print(
+            make_colored("warning:", with_color, color::warning),
+            " cached results require a cache folder; please use --cache\n");
+    }
+
+    if (auto opt = get_option(args, "--retry")) {
+        if (const auto count = parse_unsigned(*opt->value)) {
+            max_retries = static_cast<std::size_t>(*count);
+        } else {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning),
+                " invalid number of retries; please specify a positive number\n");
+        }
+    }
+
+    if (auto opt = get_option(args, "--test-timeout")) {
+#if SNITCH_WITH_MULTITHREADING
+        if (const auto timeout = impl::parse_timeout(*opt->value)) {
+            test_timeout_ms = *timeout;
+        } else {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning),
+                " invalid test timeout; please specify a number of seconds (e.g., 5 or 5s) or "
+                "milliseconds (e.g., 500ms)\n");
+        }
+#else
+        using namespace snitch::impl;
+        cli::print(
+            make_colored("warning:", with_color, color::warning),
+            " test timeouts require multithreading; please enable 'SNITCH_WITH_MULTITHREADING'\n");
+#endif
+    }
+
+    if (get_option(args, "--abort")) {
+        abort_after = 1u;
+    }
+
+    if (auto opt = get_option(args, "--abortx")) {
+        if (const auto count = parse_unsigned(*opt->value); count.has_value() && *count > 0u) {
+            abort_after = static_cast<std::size_t>(*count);
+        } else {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning),
+                " invalid number of failures for --abortx; please specify a positive number\n");
+        }
+    }
+
+    if (auto opt = get_option(args, "--order")) {
+        if (*opt->value == "decl") {
+            order = test_order::declaration;
+        } else if (*opt->value == "lex") {
+            order = test_order::lexical;
+        } else if (*opt->value == "rand") {
+            order = test_order::random;
+        } else {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning),
+                " unknown test order; please use one of decl|lex|rand\n");
+        }
+    }
+
+    if (auto opt = get_option(args, "--rng-seed")) {
+        if (*opt->value == "time" || *opt->value == "random-device") {
+            rng_seed = impl::make_random_seed();
+        } else if (const auto seed = parse_unsigned(*opt->value)) {
+            rng_seed = *seed;
+        } else {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning),
+                " invalid random seed; please use one of time|random-device|<number>\n");
+        }
+    } else if (order == test_order::random) {
+        // A random order without a seed gets a new seed for each run; it is reported by the
+        // reporters, so the order can be reproduced with '--rng-seed'.
+        rng_seed = impl::make_random_seed();
+    }
+
     if (auto opt = get_option(args, "--out")) {
         file_writer = impl::file_writer{*opt->value};
 
@@ -1065,9 +1679,89 @@ void registry::configure(const cli::input& args) {
         print_callback = {*file_writer, snitch::constant<&impl::file_writer::write>{}};
     }
 
-    if (auto opt = get_option(args, "--reporter")) {
-        impl::parse_reporter(*this, registered_reporters, *opt->value);
+    small_vector<std::string_view, max_active_reporters> reporters;
+    const auto add_reporter_string = [&](std::string_view reporter) noexcept {
+        if (reporters.available() == 0u) {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning), " too many reporters; '",
+                reporter, "' will not be used (please increase 'SNITCH_MAX_ACTIVE_REPORTERS')\n");
+            return;
+        }
+
+        reporters.push_back(reporter);
+    };
+    cli::for_each_option(args, "--reporter", add_reporter_string);
+
+    if (!reporters.empty()) {
+        configure_reporters(reporters, color_override);
+    }
+
+#if SNITCH_WITH_TIMINGS
+    if (auto opt = get_option(args, "--durations")) {
+        if (*opt->value == "yes") {
+            durations.emplace();
+        } else if (*opt->value == "no") {
+            durations.reset();
+        } else {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning),
+                " unknown durations directive; please use one of yes|no\n");
+        }
+    }
+
+    if (auto opt = get_option(args, "--min-duration")) {
+        if (const auto min_duration = impl::parse_seconds(*opt->value)) {
+            // A minimum duration implies showing durations, unless explicitly disabled.
+            const auto show = get_option(args, "--durations");
+            if (!show.has_value() || *show->value != "no") {
+                if (!durations.has_value()) {
+                    durations.emplace();
+                }
+                durations->min_duration = *min_duration;
+            }
+        } else {
+            using namespace snitch::impl;
+            cli::print(
+                make_colored("warning:", with_color, color::warning),
+                " invalid minimum duration; please specify a number of seconds\n");
+        }
+    }
+#else
+    if (get_option(args, "--durations") || get_option(args, "--min-duration")) {
+        using namespace snitch::impl;
+        cli::print(
+            make_colored("warning:", with_color, color::warning),
+            " durations require timings; please enable 'SNITCH_WITH_TIMINGS'\n");
+    }
+#endif
+
+    if (auto opt = get_option(args, "--profile")) {
+#if SNITCH_WITH_TIMINGS
+        profiler.emplace(*opt->value);
+#else
+        using namespace snitch::impl;
+        cli::print(
+            make_colored("warning:", with_color, color::warning),
+            " profiling requires timings; please enable 'SNITCH_WITH_TIMINGS'\n");
+#endif
     }
+
+    if (get_option(args, "--startup-stats")) {
+#if SNITCH_WITH_TIMINGS
+        startup_stats = true;
+#else
+        using namespace snitch::impl;
+        cli::print(
+            make_colored("warning:", with_color, color::warning),
+            " startup statistics require timings; please enable 'SNITCH_WITH_TIMINGS'\n");
+#endif
+    }
+
+#if SNITCH_WITH_TIMINGS
+    impl::end_startup_phase(impl::startup_phase::configure);
+#endif
 }
 
 void registry::list_all_tags() const {
@@ -1116,11 +1810,80 @@ void registry::list_all_reporters() const noexcept {
     }
 }
 
+#if SNITCH_WITH_TIMINGS
+const impl::duration_tracker* registry::test_durations() const noexcept {
+    return durations.has_value() ? &durations.value() : nullptr;
+}
+#endif
+
+const impl::file_writer* registry::output_file() const noexcept {
+    if (!active_reporters.empty()) {
+        // With multiple reporters, the default output may be shared; only give access to the
+        // current reporter's own file, if any.
+        const auto& reporter = active_reporters[current_reporter];
+        return reporter.file_writer.has_value() ? &reporter.file_writer.value() : nullptr;
+    }
+
+    return file_writer.has_value() ? &file_writer.value() : nullptr;
+}
+
+void registry::load_linked_tests() const noexcept {
+#if SNITCH_WITH_LINKER_REGISTRATION
+    // The section only contains the test cases of the global registry.
+    if (this != &tests || tests.linked_tests_loaded) {
+        return;
+    }
+
+    tests.linked_tests_loaded = true;
+
+    if (__start_snitch_tests == nullptr || __stop_snitch_tests == nullptr) {
+        return;
+    }
+
+#    if SNITCH_WITH_TIMINGS
+    const auto time_start = get_current_time();
+#    endif
+
+    // Entries of the same file are contiguous, but the compiler may emit them in any order.
+    // Register them by increasing line to keep the order of declaration; entries declared on the
+    // same line (e.g., by a macro) keep their order in the section.
+    using entry_ptr = const impl::registration_entry* const*;
+    for (entry_ptr first = __start_snitch_tests; first != __stop_snitch_tests;) {
+        entry_ptr last = first;
+        while (last != __stop_snitch_tests && (*last)->location.file == (*first)->location.file) {
+            ++last;
+        }
+
+        auto& entries = impl::linked_entries;
+        entries.clear();
+        for (auto entry = first; entry != last; ++entry) {
+            entries.push_back(entry);
+        }
+
+        std::sort(entries.begin(), entries.end(), [](entry_ptr a, entry_ptr b) {
+            return std::tie((*a)->location.line, a) < std::tie((*b)->location.line, b);
+        });
+
+        for (entry_ptr entry : entries) {
+            (*entry)->add(tests, **entry);
+        }
+
+        first = last;
+    }
+
+#    if SNITCH_WITH_TIMINGS
+    impl::set_startup_phase(impl::startup_phase::registration, time_start, get_current_time());
+#    endif
+#endif
+}
+
 small_vector_span<impl::test_case> registry::test_cases() noexcept {
+    load_linked_tests();
     return test_list;
 }
 
 small_vector_span<const impl::test_case> registry::test_cases() const noexcept {
+    load_linked_tests();
     return test_list;
 }
 
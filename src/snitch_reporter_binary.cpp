@@ -0,0 +1,953 @@
+#include "snitch/snitch_config.hpp"
+
+#if SNITCH_WITH_BINARY_REPORTER || SNITCH_WITH_ALL_REPORTERS
+
+#    include "snitch/snitch_cli.hpp"
+#    include "snitch/snitch_console.hpp"
+#    include "snitch/snitch_macros_reporter.hpp"
+#    include "snitch/snitch_registry.hpp"
+#    include "snitch/snitch_reporter_binary.hpp"
+#    include "snitch/snitch_string.hpp"
+#    include "snitch/snitch_test_data.hpp"
+#    include "snitch/snitch_vector.hpp"
+
+#    include <algorithm> // for std::min
+#    include <array> // for std::array
+#    include <cstdint> // for std::uint8_t, std::uint32_t, std::uint64_t
+#    include <cstring> // for std::memcpy
+#    include <initializer_list>
+
+// Format
+// ------
+// A log is a sequence of headers and records. A header is written at the start of each run; it
+// is made of a zero byte, the characters "SNTB", and the format version (varint). It also resets
+// the interned strings (see below). A record is the size of its payload in bytes (varint, never
+// zero), followed by the payload: the record type (varint, see 'record_type'), then the fields
+// of the event, in the order in which they are declared. Decoders skip trailing fields they do
+// not know about, and records of unknown types.
+//
+// Integers and enums are written as LEB128 varints, booleans as one byte, and floats as the four
+// bytes of their IEEE-754 representation, least significant byte first. Fields which are disabled
+// in the configuration (timings, performance counters, ...) are still written, with a value of
+// zero, so logs can be decoded regardless of the configuration.
+//
+// A string is written as a varint code, optionally followed by its size (varint) and bytes. The
+// code is 0 for an inline string, '2*slot+1' to store the string in an interning slot, and
+// '2*slot+2' to reuse the string stored in that slot (in which case the size and bytes are
+// omitted). Strings that repeat from one event to the next (test IDs, file paths, section names)
+// are interned; other strings (messages, expressions, captures) are written inline.
+
+namespace snitch::reporter::binary {
+namespace {
+constexpr std::string_view magic   = {"\0SNTB", 5};
+constexpr std::uint8_t     version = 1;
+
+enum class record_type : std::uint8_t {
+    test_run_started,
+    test_run_ended,
+    test_case_started,
+    test_case_ended,
+    section_started,
+    section_ended,
+    assertion_failed,
+    assertion_succeeded,
+    test_case_skipped,
+    list_test_run_started,
+    list_test_run_ended,
+    test_case_listed
+};
+
+// Bits of the mask of available performance counters.
+constexpr std::uint8_t instructions_bit  = 1u;
+constexpr std::uint8_t cycles_bit        = 2u;
+constexpr std::uint8_t cache_misses_bit  = 4u;
+constexpr std::uint8_t branch_misses_bit = 8u;
+
+// Maximum number of interned strings in a single record: four for the test ID, one for the
+// test location, one for the assertion location, one for the run name or expression type, and
+// three for each section.
+constexpr std::size_t max_interned_per_record = 7 + 3 * max_nested_sections;
+
+// Writing.
+// --------
+
+// Interning tables of the reporter instances; each instance writes its own log, so it needs its
+// own table. They are too large for the reporter storage of the registry, so instances claim one
+// of these instead.
+std::array<interned_table, max_active_reporters> interned_tables      = {};
+std::array<bool, max_active_reporters>           interned_tables_used = {};
+
+// FNV-1a hash. The slot of a string is determined by its hash, so a string that is evicted by
+// another one simply gets written again the next time it is needed.
+std::uint64_t hash(std::string_view string) noexcept {
+    std::uint64_t value = 14695981039346656037u;
+    for (const char c : string) {
+        value ^= static_cast<unsigned char>(c);
+        value *= 1099511628211u;
+    }
+
+    // Zero marks empty slots.
+    return value == 0u ? 1u : value;
+}
+
+// First pass: computes the size of the payload, and decides which strings need to be stored.
+struct size_counter {
+    interned_table*                                       hashes = nullptr;
+    std::size_t                                           size   = 0;
+    small_vector<std::uint64_t, max_interned_per_record> codes  = {};
+
+    void byte(std::uint8_t) noexcept {
+        ++size;
+    }
+
+    void bytes(std::string_view string) noexcept {
+        size += string.size();
+    }
+
+    std::uint64_t intern(std::string_view string) noexcept {
+        if (hashes == nullptr) {
+            // No table available; write the string inline.
+            codes.push_back(0u);
+            return 0u;
+        }
+
+        const std::uint64_t value = hash(string);
+        const std::size_t   slot  = static_cast<std::size_t>(value % max_interned_strings);
+
+        std::uint64_t code = 2u * slot + 2u;
+        if ((*hashes)[slot] != value) {
+            (*hashes)[slot] = value;
+            code            = 2u * slot + 1u;
+        }
+
+        codes.push_back(code);
+        return code;
+    }
+};
+
+// Second pass: writes the payload, with the string codes decided in the first pass.
+struct record_writer {
+    const registry&                        r;
+    small_vector_span<const std::uint64_t> codes;
+    std::size_t                            next_code = 0;
+    small_string<max_message_length>       buffer    = {};
+
+    void flush() noexcept {
+        r.print(std::string_view{buffer.data(), buffer.size()});
+        buffer.clear();
+    }
+
+    void byte(std::uint8_t value) noexcept {
+        if (buffer.available() == 0u) {
+            flush();
+        }
+
+        buffer.push_back(static_cast<char>(value));
+    }
+
+    void bytes(std::string_view string) noexcept {
+        while (!string.empty()) {
+            if (buffer.available() == 0u) {
+                flush();
+            }
+
+            const std::size_t chunk = std::min(buffer.available(), string.size());
+            const std::size_t start = buffer.size();
+            buffer.grow(chunk);
+            std::memcpy(buffer.data() + start, string.data(), chunk);
+            string.remove_prefix(chunk);
+        }
+    }
+
+    std::uint64_t intern(std::string_view) noexcept {
+        return codes[next_code++];
+    }
+};
+
+template<typename Sink>
+void write_varint(Sink& out, std::uint64_t value) noexcept {
+    while (value >= 0x80u) {
+        out.byte(static_cast<std::uint8_t>(value | 0x80u));
+        value >>= 7u;
+    }
+
+    out.byte(static_cast<std::uint8_t>(value));
+}
+
+template<typename Sink, typename Enum>
+void write_enum(Sink& out, Enum value) noexcept {
+    write_varint(out, static_cast<std::uint64_t>(value));
+}
+
+template<typename Sink>
+void write_bool(Sink& out, bool value) noexcept {
+    out.byte(value ? 1u : 0u);
+}
+
+template<typename Sink>
+void write_float(Sink& out, float value) noexcept {
+    static_assert(sizeof(float) == sizeof(std::uint32_t));
+
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (std::size_t i = 0; i < sizeof(bits); ++i) {
+        out.byte(static_cast<std::uint8_t>(bits >> (8u * i)));
+    }
+}
+
+template<typename Sink>
+void write_string(Sink& out, std::string_view string, bool interned) noexcept {
+    const std::uint64_t code = interned ? out.intern(string) : 0u;
+    write_varint(out, code);
+
+    // Even non-zero codes refer to a string already stored.
+    if (code == 0u || code % 2u == 1u) {
+        write_varint(out, string.size());
+        out.bytes(string);
+    }
+}
+
+template<typename Sink>
+void write_inline(Sink& out, std::string_view string) noexcept {
+    write_string(out, string, false);
+}
+
+template<typename Sink>
+void write_interned(Sink& out, std::string_view string) noexcept {
+    write_string(out, string, true);
+}
+
+template<typename Sink>
+void write_strings(Sink& out, small_vector_span<const std::string_view> strings) noexcept {
+    write_varint(out, strings.size());
+    for (const auto& string : strings) {
+        write_inline(out, string);
+    }
+}
+
+template<typename Sink>
+void write_test_id(Sink& out, const test_id& id) noexcept {
+    write_interned(out, id.name);
+    write_interned(out, id.tags);
+    write_interned(out, id.type);
+    write_interned(out, id.fixture);
+}
+
+template<typename Sink>
+void write_location(Sink& out, const source_location& location) noexcept {
+    write_interned(out, location.file);
+    write_varint(out, location.line);
+}
+
+template<typename Sink>
+void write_location(Sink& out, const assertion_location& location) noexcept {
+    write_interned(out, location.file);
+    write_varint(out, location.line);
+    write_enum(out, location.type);
+}
+
+template<typename Sink>
+void write_section_id(Sink& out, const section_id& id) noexcept {
+    write_interned(out, id.name);
+    write_interned(out, id.description);
+}
+
+template<typename Sink>
+void write_counts(
+    Sink&       out,
+    std::size_t assertion_count,
+    std::size_t assertion_failure_count,
+    std::size_t allowed_assertion_failure_count) noexcept {
+
+    write_varint(out, assertion_count);
+    write_varint(out, assertion_failure_count);
+    write_varint(out, allowed_assertion_failure_count);
+}
+
+template<typename Sink>
+void write_sections(Sink& out, const section_info& sections) noexcept {
+    write_varint(out, sections.size());
+    for (const auto& s : sections) {
+        write_section_id(out, s.id);
+        write_location(out, s.location);
+        write_counts(
+            out, s.assertion_count, s.assertion_failure_count, s.allowed_assertion_failure_count);
+#    if SNITCH_WITH_TIMINGS
+        write_varint(out, s.start_time);
+#    else
+        write_varint(out, 0u);
+#    endif
+    }
+}
+
+template<typename Sink>
+void write_assertion_data(Sink& out, const assertion_data& data) noexcept {
+    std::visit(
+        overload{
+            [&](std::string_view message) {
+                out.byte(0u);
+                write_inline(out, message);
+            },
+            [&](const expression_info& exp) {
+                out.byte(1u);
+                write_interned(out, exp.type);
+                write_inline(out, exp.expected);
+                write_inline(out, exp.actual);
+            }},
+        data);
+}
+
+template<typename Sink>
+void write_duration([[maybe_unused]] Sink& out, [[maybe_unused]] const auto& e) noexcept {
+#    if SNITCH_WITH_TIMINGS
+    write_float(out, e.duration);
+#    else
+    write_float(out, 0.0f);
+#    endif
+}
+
+template<typename Sink>
+void write_measurements(Sink& out, [[maybe_unused]] const event::test_case_ended& e) noexcept {
+#    if SNITCH_WITH_PERF_COUNTERS
+    const perf_counters& counters = e.counters;
+    const std::uint8_t   mask     = static_cast<std::uint8_t>(
+        (counters.instructions.has_value() ? instructions_bit : 0u) |
+        (counters.cycles.has_value() ? cycles_bit : 0u) |
+        (counters.cache_misses.has_value() ? cache_misses_bit : 0u) |
+        (counters.branch_misses.has_value() ? branch_misses_bit : 0u));
+
+    out.byte(mask);
+    for (const auto& value :
+         {counters.instructions, counters.cycles, counters.cache_misses, counters.branch_misses}) {
+        if (value.has_value()) {
+            write_varint(out, value.value());
+        }
+    }
+#    else
+    out.byte(0u);
+#    endif
+
+#    if SNITCH_WITH_ALLOCATION_TRACKING
+    write_bool(out, true);
+    write_varint(out, e.allocations.count);
+    write_varint(out, e.allocations.bytes);
+    write_varint(out, e.allocations.peak);
+#    else
+    write_bool(out, false);
+#    endif
+}
+
+template<typename Sink>
+void write_event(Sink& out, const event::data& event) noexcept {
+    std::visit(
+        overload{
+            [&](const event::test_run_started& e) {
+                write_enum(out, record_type::test_run_started);
+                write_interned(out, e.name);
+                write_strings(out, e.filters);
+                write_varint(out, e.rng_seed);
+            },
+            [&](const event::test_run_ended& e) {
+                write_enum(out, record_type::test_run_ended);
+                write_interned(out, e.name);
+                write_strings(out, e.filters);
+                write_varint(out, e.run_count);
+                write_varint(out, e.fail_count);
+                write_varint(out, e.allowed_fail_count);
+                write_varint(out, e.skip_count);
+                write_counts(
+                    out, e.assertion_count, e.assertion_failure_count,
+                    e.allowed_assertion_failure_count);
+                write_duration(out, e);
+                write_bool(out, e.success);
+                write_varint(out, e.flaky_count);
+                write_bool(out, e.aborted);
+            },
+            [&](const event::test_case_started& e) {
+                write_enum(out, record_type::test_case_started);
+                write_test_id(out, e.id);
+                write_location(out, e.location);
+                write_varint(out, e.retries);
+            },
+            [&](const event::test_case_ended& e) {
+                write_enum(out, record_type::test_case_ended);
+                write_test_id(out, e.id);
+                write_location(out, e.location);
+                write_counts(
+                    out, e.assertion_count, e.assertion_failure_count,
+                    e.allowed_assertion_failure_count);
+                write_enum(out, e.state);
+                write_duration(out, e);
+                write_measurements(out, e);
+                write_bool(out, e.failure_expected);
+                write_bool(out, e.failure_allowed);
+                write_varint(out, e.retries);
+                write_bool(out, e.will_retry);
+            },
+            [&](const event::section_started& e) {
+                write_enum(out, record_type::section_started);
+                write_section_id(out, e.id);
+                write_location(out, e.location);
+            },
+            [&](const event::section_ended& e) {
+                write_enum(out, record_type::section_ended);
+                write_section_id(out, e.id);
+                write_location(out, e.location);
+                write_bool(out, e.skipped);
+                write_counts(
+                    out, e.assertion_count, e.assertion_failure_count,
+                    e.allowed_assertion_failure_count);
+                write_duration(out, e);
+            },
+            [&](const event::assertion_failed& e) {
+                write_enum(out, record_type::assertion_failed);
+                write_test_id(out, e.id);
+                write_sections(out, e.sections);
+                write_strings(out, e.captures);
+                write_location(out, e.location);
+                write_assertion_data(out, e.data);
+                write_bool(out, e.expected);
+                write_bool(out, e.allowed);
+                write_bool(out, e.may_retry);
+            },
+            [&](const event::assertion_succeeded& e) {
+                write_enum(out, record_type::assertion_succeeded);
+                write_test_id(out, e.id);
+                write_sections(out, e.sections);
+                write_strings(out, e.captures);
+                write_location(out, e.location);
+                write_assertion_data(out, e.data);
+            },
+            [&](const event::test_case_skipped& e) {
+                write_enum(out, record_type::test_case_skipped);
+                write_test_id(out, e.id);
+                write_sections(out, e.sections);
+                write_strings(out, e.captures);
+                write_location(out, e.location);
+                write_inline(out, e.message);
+            },
+            [&](const event::list_test_run_started& e) {
+                write_enum(out, record_type::list_test_run_started);
+                write_interned(out, e.name);
+                write_strings(out, e.filters);
+            },
+            [&](const event::list_test_run_ended& e) {
+                write_enum(out, record_type::list_test_run_ended);
+                write_interned(out, e.name);
+                write_strings(out, e.filters);
+            },
+            [&](const event::test_case_listed& e) {
+                write_enum(out, record_type::test_case_listed);
+                write_test_id(out, e.id);
+                write_location(out, e.location);
+            }},
+        event);
+}
+
+// Reading.
+// --------
+
+struct reader {
+    std::string_view log;
+    std::size_t      position = 0;
+    std::size_t      end      = 0;
+    bool             valid    = true;
+
+    // Strings stored in each interning slot; a null data pointer marks empty slots.
+    std::array<std::string_view, max_interned_strings> interned = {};
+
+    void fail() noexcept {
+        valid    = false;
+        position = end;
+    }
+
+    // Fields appended to a record after the first release of the format are missing from older
+    // logs; check before reading them.
+    bool has_more() const noexcept {
+        return position < end;
+    }
+
+    std::uint8_t byte() noexcept {
+        if (position >= end) {
+            fail();
+            return 0u;
+        }
+
+        return static_cast<std::uint8_t>(log[position++]);
+    }
+
+    std::string_view bytes(std::uint64_t size) noexcept {
+        if (size > end - position) {
+            fail();
+            return {};
+        }
+
+        const std::string_view string = log.substr(position, static_cast<std::size_t>(size));
+        position += static_cast<std::size_t>(size);
+        return string;
+    }
+
+    std::uint64_t varint() noexcept {
+        std::uint64_t value = 0u;
+        for (std::size_t shift = 0; shift < 64u; shift += 7u) {
+            const std::uint8_t b = byte();
+            value |= static_cast<std::uint64_t>(b & 0x7fu) << shift;
+            if ((b & 0x80u) == 0u) {
+                return value;
+            }
+        }
+
+        fail();
+        return 0u;
+    }
+
+    std::size_t size() noexcept {
+        return static_cast<std::size_t>(varint());
+    }
+
+    template<typename Enum>
+    Enum enumeration(Enum last) noexcept {
+        const std::uint64_t value = varint();
+        if (value > static_cast<std::uint64_t>(last)) {
+            fail();
+            return Enum{};
+        }
+
+        return static_cast<Enum>(value);
+    }
+
+    bool boolean() noexcept {
+        return byte() != 0u;
+    }
+
+    float real() noexcept {
+        std::uint32_t bits = 0u;
+        for (std::size_t i = 0; i < sizeof(bits); ++i) {
+            bits |= static_cast<std::uint32_t>(byte()) << (8u * i);
+        }
+
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string_view string() noexcept {
+        const std::uint64_t code = varint();
+        if (code == 0u) {
+            return bytes(varint());
+        }
+
+        const std::uint64_t slot = (code - 1u) / 2u;
+        if (slot >= max_interned_strings) {
+            fail();
+            return {};
+        }
+
+        std::string_view& stored = interned[static_cast<std::size_t>(slot)];
+        if (code % 2u == 1u) {
+            stored = bytes(varint());
+        } else if (stored.data() == nullptr) {
+            fail();
+        }
+
+        return stored;
+    }
+};
+
+template<std::size_t N>
+void read_strings(reader& in, small_vector<std::string_view, N>& strings) noexcept {
+    const std::size_t count = in.size();
+    if (count > strings.capacity()) {
+        in.fail();
+        return;
+    }
+
+    for (std::size_t i = 0; i < count && in.valid; ++i) {
+        strings.push_back(in.string());
+    }
+}
+
+void read_test_id(reader& in, test_id& id) noexcept {
+    id.name    = in.string();
+    id.tags    = in.string();
+    id.type    = in.string();
+    id.fixture = in.string();
+}
+
+void read_location(reader& in, source_location& location) noexcept {
+    location.file = in.string();
+    location.line = in.size();
+}
+
+void read_location(reader& in, assertion_location& location) noexcept {
+    location.file = in.string();
+    location.line = in.size();
+    location.type = in.enumeration(location_type::in_check);
+}
+
+void read_section_id(reader& in, section_id& id) noexcept {
+    id.name        = in.string();
+    id.description = in.string();
+}
+
+void read_sections(reader& in, small_vector<section, max_nested_sections>& sections) noexcept {
+    const std::size_t count = in.size();
+    if (count > sections.capacity()) {
+        in.fail();
+        return;
+    }
+
+    for (std::size_t i = 0; i < count && in.valid; ++i) {
+        section& s = sections.push_back({});
+        read_section_id(in, s.id);
+        read_location(in, s.location);
+        s.assertion_count                 = in.size();
+        s.assertion_failure_count         = in.size();
+        s.allowed_assertion_failure_count = in.size();
+#    if SNITCH_WITH_TIMINGS
+        s.start_time = static_cast<time_point_t>(in.varint());
+#    else
+        static_cast<void>(in.varint());
+#    endif
+    }
+}
+
+assertion_data read_assertion_data(reader& in) noexcept {
+    if (in.boolean()) {
+        expression_info exp;
+        exp.type     = in.string();
+        exp.expected = in.string();
+        exp.actual   = in.string();
+        return exp;
+    } else {
+        return in.string();
+    }
+}
+
+void read_measurements(reader& in, [[maybe_unused]] event::test_case_ended& e) noexcept {
+    const std::uint8_t mask = in.byte();
+    for (const std::uint8_t bit :
+         {instructions_bit, cycles_bit, cache_misses_bit, branch_misses_bit}) {
+        if ((mask & bit) == 0u) {
+            continue;
+        }
+
+        [[maybe_unused]] const std::uint64_t value = in.varint();
+#    if SNITCH_WITH_PERF_COUNTERS
+        if (bit == instructions_bit) {
+            e.counters.instructions = value;
+        } else if (bit == cycles_bit) {
+            e.counters.cycles = value;
+        } else if (bit == cache_misses_bit) {
+            e.counters.cache_misses = value;
+        } else {
+            e.counters.branch_misses = value;
+        }
+#    endif
+    }
+
+    if (in.boolean()) {
+        [[maybe_unused]] const std::size_t count = in.size();
+        [[maybe_unused]] const std::size_t bytes = in.size();
+        [[maybe_unused]] const std::size_t peak  = in.size();
+#    if SNITCH_WITH_ALLOCATION_TRACKING
+        e.allocations = {.count = count, .bytes = bytes, .peak = peak};
+#    endif
+    }
+}
+
+// Decode the payload of a record and report the event, if the verbosity and the event types of the
+// reporter allow it. Records of unknown type are ignored.
+void read_event(const registry& r, reader& in) noexcept {
+    const std::uint64_t type = in.varint();
+
+    test_id                                                 id;
+    source_location                                         location;
+    assertion_location                                      assert_location;
+    small_vector<std::string_view, max_command_line_args> filters;
+    small_vector<section, max_nested_sections>              sections;
+    small_vector<std::string_view, max_captures>            captures;
+
+    const bool normal = r.verbose >= registry::verbosity::normal;
+    const bool high   = r.verbose >= registry::verbosity::high;
+    const bool full   = r.verbose >= registry::verbosity::full;
+
+    const auto report = [&](const event::data& e) {
+        if ((r.report_events & event::mask_of(e)) != 0u) {
+            r.report_callback(r, e);
+        }
+    };
+
+    switch (type) {
+    case static_cast<std::uint64_t>(record_type::test_run_started): {
+        event::test_run_started e;
+        e.name = in.string();
+        read_strings(in, filters);
+        e.filters = filters;
+        if (in.has_more()) {
+            e.rng_seed = in.varint();
+        }
+        if (in.valid && normal) {
+            report(e);
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::test_run_ended): {
+        event::test_run_ended e;
+        e.name = in.string();
+        read_strings(in, filters);
+        e.filters                         = filters;
+        e.run_count                       = in.size();
+        e.fail_count                      = in.size();
+        e.allowed_fail_count              = in.size();
+        e.skip_count                      = in.size();
+        e.assertion_count                 = in.size();
+        e.assertion_failure_count         = in.size();
+        e.allowed_assertion_failure_count = in.size();
+#    if SNITCH_WITH_TIMINGS
+        e.duration = in.real();
+#    else
+        static_cast<void>(in.real());
+#    endif
+        e.success = in.boolean();
+        if (in.has_more()) {
+            e.flaky_count = in.size();
+            e.aborted     = in.boolean();
+        }
+        if (in.valid && normal) {
+            report(e);
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::test_case_started): {
+        read_test_id(in, id);
+        read_location(in, location);
+        event::test_case_started e{.id = id, .location = location};
+        if (in.has_more()) {
+            e.retries = in.size();
+        }
+        if (in.valid && high) {
+            report(e);
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::test_case_ended): {
+        read_test_id(in, id);
+        read_location(in, location);
+        event::test_case_ended e{.id = id, .location = location};
+        e.assertion_count                 = in.size();
+        e.assertion_failure_count         = in.size();
+        e.allowed_assertion_failure_count = in.size();
+        e.state                           = in.enumeration(test_case_state::skipped);
+#    if SNITCH_WITH_TIMINGS
+        e.duration = in.real();
+#    else
+        static_cast<void>(in.real());
+#    endif
+        read_measurements(in, e);
+        e.failure_expected = in.boolean();
+        e.failure_allowed  = in.boolean();
+        if (in.has_more()) {
+            e.retries = in.size();
+        }
+        if (in.has_more()) {
+            e.will_retry = in.boolean();
+        }
+        if (in.valid && high) {
+            report(e);
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::section_started): {
+        event::section_started e;
+        read_section_id(in, e.id);
+        read_location(in, e.location);
+        if (in.valid && high) {
+            report(e);
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::section_ended): {
+        event::section_ended e;
+        read_section_id(in, e.id);
+        read_location(in, e.location);
+        e.skipped                         = in.boolean();
+        e.assertion_count                 = in.size();
+        e.assertion_failure_count         = in.size();
+        e.allowed_assertion_failure_count = in.size();
+#    if SNITCH_WITH_TIMINGS
+        e.duration = in.real();
+#    else
+        static_cast<void>(in.real());
+#    endif
+        if (in.valid && high) {
+            report(e);
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::assertion_failed): {
+        read_test_id(in, id);
+        read_sections(in, sections);
+        read_strings(in, captures);
+        read_location(in, assert_location);
+        const assertion_data data     = read_assertion_data(in);
+        const bool           expected  = in.boolean();
+        const bool           allowed   = in.boolean();
+        const bool           may_retry = in.has_more() && in.boolean();
+        if (in.valid) {
+            report(event::assertion_failed{
+                id, sections, captures, assert_location, data, expected, allowed, may_retry});
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::assertion_succeeded): {
+        read_test_id(in, id);
+        read_sections(in, sections);
+        read_strings(in, captures);
+        read_location(in, assert_location);
+        const assertion_data data = read_assertion_data(in);
+        if (in.valid && full) {
+            report(event::assertion_succeeded{id, sections, captures, assert_location, data});
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::test_case_skipped): {
+        read_test_id(in, id);
+        read_sections(in, sections);
+        read_strings(in, captures);
+        read_location(in, assert_location);
+        const std::string_view message = in.string();
+        if (in.valid) {
+            report(event::test_case_skipped{id, sections, captures, assert_location, message});
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::list_test_run_started): {
+        event::list_test_run_started e;
+        e.name = in.string();
+        read_strings(in, filters);
+        e.filters = filters;
+        if (in.valid) {
+            report(e);
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::list_test_run_ended): {
+        event::list_test_run_ended e;
+        e.name = in.string();
+        read_strings(in, filters);
+        e.filters = filters;
+        if (in.valid) {
+            report(e);
+        }
+        break;
+    }
+    case static_cast<std::uint64_t>(record_type::test_case_listed): {
+        read_test_id(in, id);
+        read_location(in, location);
+        if (in.valid) {
+            report(event::test_case_listed{id, location});
+        }
+        break;
+    }
+    default: break;
+    }
+}
+} // namespace
+
+reporter::reporter(registry& r) noexcept {
+    // Record everything; the verbosity is applied when the log is replayed.
+    r.verbose = registry::verbosity::full;
+
+    for (std::size_t i = 0; i < max_active_reporters; ++i) {
+        if (!interned_tables_used[i]) {
+            interned_tables_used[i] = true;
+            interned_hashes         = &interned_tables[i];
+            break;
+        }
+    }
+}
+
+reporter::~reporter() noexcept {
+    if (interned_hashes != nullptr) {
+        interned_tables_used[static_cast<std::size_t>(interned_hashes - interned_tables.data())] =
+            false;
+    }
+}
+
+bool reporter::configure(registry&, std::string_view, std::string_view) noexcept {
+    return false;
+}
+
+void reporter::report(const registry& r, const snitch::event::data& event) noexcept {
+    if (std::holds_alternative<event::test_run_started>(event) ||
+        std::holds_alternative<event::list_test_run_started>(event)) {
+        if (interned_hashes != nullptr) {
+            interned_hashes->fill(0u);
+        }
+
+        if (r.output_file() == nullptr) {
+            // The log may go to the standard output, where line endings must not be translated.
+            impl::set_stdout_binary_mode();
+        }
+
+        r.print(magic);
+
+        record_writer writer{.r = r, .codes = {}};
+        write_varint(writer, version);
+        writer.flush();
+    }
+
+    size_counter counter{.hashes = interned_hashes};
+    write_event(counter, event);
+
+    record_writer writer{.r = r, .codes = counter.codes};
+    write_varint(writer, counter.size);
+    write_event(writer, event);
+    writer.flush();
+}
+
+bool replay(const registry& r, std::string_view log) noexcept {
+    reader in{.log = log, .end = log.size()};
+    bool   has_header = false;
+
+    while (in.position < log.size()) {
+        if (log[in.position] == '\0') {
+            // Header.
+            if (log.substr(in.position, magic.size()) != magic) {
+                return false;
+            }
+
+            in.position += magic.size();
+            if (in.varint() != version || !in.valid) {
+                return false;
+            }
+
+            in.interned.fill({});
+            has_header = true;
+            continue;
+        }
+
+        const std::size_t size = in.size();
+        if (!in.valid || !has_header || size > log.size() - in.position) {
+            return false;
+        }
+
+        // Decode the payload; any fields left over are from a newer format, and are skipped.
+        in.end = in.position + size;
+        read_event(r, in);
+        if (!in.valid) {
+            return false;
+        }
+
+        in.position = in.end;
+        in.end      = log.size();
+    }
+
+    return true;
+}
+} // namespace snitch::reporter::binary
+
+SNITCH_REGISTER_REPORTER("binary", snitch::reporter::binary::reporter);
+
+#endif
@@ -2,7 +2,9 @@
 
 #if SNITCH_WITH_CATCH2_XML_REPORTER || SNITCH_WITH_ALL_REPORTERS
 
+#    include "snitch/snitch_allocations.hpp"
 #    include "snitch/snitch_macros_reporter.hpp"
+#    include "snitch/snitch_perf_counters.hpp"
 #    include "snitch/snitch_registry.hpp"
 #    include "snitch/snitch_reporter_catch2_xml.hpp"
 #    include "snitch/snitch_string.hpp"
@@ -177,11 +179,10 @@ void reporter::report(const registry& r, const snitch::event::data& event) noexc
         snitch::overload{
             [&](const snitch::event::test_run_started& e) {
                 print(*this, r, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
-                // TODO: missing rng-seed
                 open(
                     *this, r, "Catch2TestRun",
                     {{"name", make_escaped(e.name)},
-                     {"rng-seed", "0"},
+                     {"rng-seed", make_string(e.rng_seed)},
                      {"xml-format-version", "3"},
                      {"catch2-version", SNITCH_FULL_VERSION ".snitch"},
                      {"filters", make_filters(e.filters)}});
@@ -214,6 +215,31 @@ void reporter::report(const registry& r, const snitch::event::data& event) noexc
                      {"line", make_string(e.location.line)}});
             },
             [&](const snitch::event::test_case_ended& e) {
+#    if SNITCH_WITH_PERF_COUNTERS
+                // Not part of the Catch2 format; only written if any counter is available.
+                bool first_counter = true;
+                snitch::impl::for_each_perf_counter(
+                    e.counters, [&](std::string_view name, std::uint64_t value) {
+                        if (first_counter) {
+                            r.print(get_indent(*this), "<PerfCounters");
+                            first_counter = false;
+                        }
+                        r.print(" ", name, "=\"", value, "\"");
+                    });
+                if (!first_counter) {
+                    r.print("/>\n");
+                }
+#    endif
+
+#    if SNITCH_WITH_ALLOCATION_TRACKING
+                // Not part of the Catch2 format.
+                node(
+                    *this, r, "Allocations",
+                    {{"count", make_string(e.allocations.count)},
+                     {"bytes", make_string(e.allocations.bytes)},
+                     {"peak", make_string(e.allocations.peak)}});
+#    endif
+
 #    if SNITCH_WITH_TIMINGS
                 node(
                     *this, r, "OverallResult",
@@ -0,0 +1,236 @@
+#include "snitch/snitch_config.hpp"
+
+#if (SNITCH_WITH_CHROME_TRACE_REPORTER || SNITCH_WITH_ALL_REPORTERS) && SNITCH_WITH_TIMINGS
+
+#    include "snitch/snitch_allocations.hpp"
+#    include "snitch/snitch_macros_reporter.hpp"
+#    include "snitch/snitch_perf_counters.hpp"
+#    include "snitch/snitch_registry.hpp"
+#    include "snitch/snitch_reporter_chrome_trace.hpp"
+#    include "snitch/snitch_string.hpp"
+#    include "snitch/snitch_string_utility.hpp"
+#    include "snitch/snitch_test_data.hpp"
+#    include "snitch/snitch_time.hpp"
+#    include "snitch/snitch_vector.hpp"
+
+#    include <cstdint>
+#    include <initializer_list>
+#    if SNITCH_WITH_MULTITHREADING
+#        include <atomic>
+#    endif
+
+namespace snitch::reporter::chrome_trace {
+namespace {
+struct key_value {
+    std::string_view key;
+    std::string_view value;
+};
+
+struct numeric_key_value {
+    std::string_view key;
+    std::uint64_t    value = 0;
+};
+
+constexpr std::size_t max_numeric_args = 8;
+
+small_string<max_message_length> make_escaped(std::string_view string) noexcept {
+    small_string<max_message_length> escaped_string;
+    append_or_truncate(escaped_string, string);
+    static_cast<void>(escape_json_or_truncate(escaped_string));
+    return escaped_string;
+}
+
+small_string<max_test_name_length> make_full_name(const test_id& id) noexcept {
+    small_string<max_test_name_length> name;
+    snitch::impl::make_full_name(name, id);
+    static_cast<void>(escape_json_or_truncate(name));
+    return name;
+}
+
+constexpr std::size_t max_number_length = 32;
+
+template<typename T>
+small_string<max_number_length> make_string(T number) noexcept {
+    small_string<max_number_length> string;
+    append_or_truncate(string, number);
+    return string;
+}
+
+// Trace timestamps are in microseconds; keep the nanosecond resolution as decimals.
+small_string<max_number_length> make_timestamp() noexcept {
+    const time_point_t              ns       = get_current_time();
+    const std::size_t               fraction = ns % 1000u;
+    small_string<max_number_length> string;
+    append_or_truncate(
+        string, ns / 1000u, ".", fraction < 100u ? "0" : "", fraction < 10u ? "0" : "", fraction);
+    return string;
+}
+
+// Each thread reporting events gets its own track in the trace.
+std::size_t get_thread_index() noexcept {
+#    if SNITCH_WITH_MULTITHREADING
+    static std::atomic<std::size_t> thread_count = 0;
+    thread_local const std::size_t  index        = thread_count++;
+    return index;
+#    else
+    return 0;
+#    endif
+}
+
+std::string_view make_state(test_case_state state) noexcept {
+    switch (state) {
+    case test_case_state::success: return "success";
+    case test_case_state::failed: return "failed";
+    case test_case_state::allowed_fail: return "allowed_fail";
+    case test_case_state::skipped: return "skipped";
+    }
+
+    return {};
+}
+
+void print_event(
+    reporter&                                  rep,
+    const registry&                            r,
+    std::string_view                           name,
+    std::string_view                           category,
+    std::string_view                           phase,
+    std::initializer_list<key_value>           args         = {},
+    small_vector_span<const numeric_key_value> numeric_args = {}) noexcept {
+    r.print(
+        rep.first_event ? "" : ",\n", "{\"name\":\"", name, "\",\"cat\":\"", category,
+        "\",\"ph\":\"", phase, "\",\"pid\":0,\"tid\":", get_thread_index(), ",\"ts\":",
+        make_timestamp());
+
+    if (phase == "i") {
+        // Instant events are scoped to the thread.
+        r.print(",\"s\":\"t\"");
+    }
+
+    bool first_arg = true;
+    for (const auto& arg : args) {
+        r.print(first_arg ? ",\"args\":{\"" : ",\"", arg.key, "\":\"", arg.value, "\"");
+        first_arg = false;
+    }
+
+    for (const auto& arg : numeric_args) {
+        r.print(first_arg ? ",\"args\":{\"" : ",\"", arg.key, "\":", arg.value);
+        first_arg = false;
+    }
+
+    r.print(first_arg ? "}" : "}}");
+    rep.first_event = false;
+}
+
+template<typename T>
+small_string<max_message_length> make_location(const T& e) noexcept {
+    small_string<max_message_length> string;
+    append_or_truncate(string, e.location.file, ":", e.location.line);
+    static_cast<void>(escape_json_or_truncate(string));
+    return string;
+}
+
+small_string<max_message_length> make_message(const assertion_data& data) noexcept {
+    small_string<max_message_length> string;
+    std::visit(
+        overload{
+            [&](std::string_view message) { append_or_truncate(string, message); },
+            [&](const snitch::expression_info& exp) {
+                append_or_truncate(string, exp.type, "(", exp.expected, ")");
+                if (!exp.actual.empty()) {
+                    append_or_truncate(string, ", got: ", exp.actual);
+                }
+            }},
+        data);
+    static_cast<void>(escape_json_or_truncate(string));
+    return string;
+}
+} // namespace
+
+reporter::reporter(registry& r) noexcept {
+    // The trace needs test_case_started and test_case_ended events, which are only printed on
+    // verbosity 'high', so ensure the requested verbosity is at least as much.
+    r.verbose = r.verbose < registry::verbosity::high ? registry::verbosity::high : r.verbose;
+}
+
+bool reporter::configure(registry&, std::string_view, std::string_view) noexcept {
+    return false;
+}
+
+void reporter::report(const registry& r, const snitch::event::data& event) noexcept {
+    std::visit(
+        snitch::overload{
+            [&](const snitch::event::test_run_started& e) {
+                r.print(
+                    "{\"traceEvents\":[\n",
+                    "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"",
+                    make_escaped(e.name), "\"}}");
+                first_event = false;
+            },
+            [&](const snitch::event::test_run_ended& e) {
+                print_event(
+                    *this, r, make_escaped(e.name), "run", "i",
+                    {{"success", e.success ? "true" : "false"},
+                     {"test_cases", make_string(e.run_count)},
+                     {"failed_test_cases", make_string(e.fail_count)},
+                     {"assertions", make_string(e.assertion_count)},
+                     {"failed_assertions", make_string(e.assertion_failure_count)}});
+                r.print("\n]}\n");
+            },
+            [&](const snitch::event::test_case_started& e) {
+                print_event(*this, r, make_full_name(e.id), "test", "B");
+            },
+            [&](const snitch::event::test_case_ended& e) {
+                small_vector<numeric_key_value, max_numeric_args> numbers;
+#    if SNITCH_WITH_PERF_COUNTERS
+                snitch::impl::for_each_perf_counter(
+                    e.counters, [&](std::string_view key, std::uint64_t value) {
+                        numbers.push_back({key, value});
+                    });
+#    endif
+#    if SNITCH_WITH_ALLOCATION_TRACKING
+                snitch::impl::for_each_allocation_stat(
+                    e.allocations, [&](std::string_view key, std::uint64_t value) {
+                        numbers.push_back({key, value});
+                    });
+#    endif
+                print_event(
+                    *this, r, make_full_name(e.id), "test", "E",
+                    {{"state", make_state(e.state)},
+                     {"assertions", make_string(e.assertion_count)},
+                     {"failed_assertions", make_string(e.assertion_failure_count)}},
+                    numbers);
+            },
+            [&](const snitch::event::section_started& e) {
+                print_event(*this, r, make_escaped(e.id.name), "section", "B");
+            },
+            [&](const snitch::event::section_ended& e) {
+                print_event(*this, r, make_escaped(e.id.name), "section", "E");
+            },
+            [&](const snitch::event::test_case_skipped& e) {
+                print_event(
+                    *this, r, "skipped", "assertion", "i",
+                    {{"location", make_location(e)}, {"message", make_escaped(e.message)}});
+            },
+            [&](const snitch::event::assertion_failed& e) {
+                const std::string_view name = e.expected  ? "expected failure"
+                                              : e.allowed ? "allowed failure"
+                                                          : "failure";
+                print_event(
+                    *this, r, name, "assertion", "i",
+                    {{"location", make_location(e)}, {"message", make_message(e.data)}});
+            },
+            [&](const snitch::event::assertion_succeeded&) {},
+            [&](const snitch::event::list_test_run_started&) {},
+            [&](const snitch::event::list_test_run_ended&) {},
+            [&](const snitch::event::test_case_listed& e) {
+                small_string<max_test_name_length> name;
+                snitch::impl::make_full_name(name, e.id);
+                r.print(name, "\n");
+            }},
+        event);
+}
+} // namespace snitch::reporter::chrome_trace
+
+SNITCH_REGISTER_REPORTER("chrome-trace", snitch::reporter::chrome_trace::reporter);
+
+#endif
@@ -1,9 +1,13 @@
 #include "snitch/snitch_reporter_console.hpp"
 
+#include "snitch/snitch_allocations.hpp"
 #include "snitch/snitch_config.hpp"
 #include "snitch/snitch_console.hpp"
+#include "snitch/snitch_durations.hpp"
 #include "snitch/snitch_macros_reporter.hpp"
+#include "snitch/snitch_perf_counters.hpp"
 #include "snitch/snitch_registry.hpp"
+#include "snitch/snitch_startup_stats.hpp"
 #include "snitch/snitch_string.hpp"
 #include "snitch/snitch_string_utility.hpp"
 #include "snitch/snitch_test_data.hpp"
@@ -84,6 +88,45 @@ void print_message(const registry& r, const assertion_data& data) {
             }},
         data);
 }
+
+#if SNITCH_WITH_TIMINGS
+void print_startup_stats(const registry& r) noexcept {
+    struct named_phase {
+        startup_phase    phase;
+        std::string_view name;
+    };
+
+    constexpr named_phase phases[] = {
+        {startup_phase::registration, "registration"},
+        {startup_phase::parse_arguments, "command-line parsing"},
+        {startup_phase::configure, "configuration"},
+        {startup_phase::first_test_case, "first test case"}};
+
+    r.print(make_colored("startup statistics:", r.with_color, color::status), "\n");
+
+    std::optional<time_point_t> first_start;
+    for (const auto& [phase, name] : phases) {
+        const startup_timing timing = get_startup_phase(phase);
+        if (!timing.start.has_value() || !timing.end.has_value()) {
+            continue;
+        }
+
+        if (!first_start.has_value() || *timing.start < *first_start) {
+            first_start = timing.start;
+        }
+
+        r.print(
+            "  ", name, ": ", get_duration_in_seconds(*timing.start, *timing.end), " seconds\n");
+    }
+
+    // From the earliest recorded phase until the end of the first test case.
+    const startup_timing first_test = get_startup_phase(startup_phase::first_test_case);
+    if (first_start.has_value() && first_test.end.has_value()) {
+        r.print(
+            "  total: ", get_duration_in_seconds(*first_start, *first_test.end), " seconds\n");
+    }
+}
+#endif
 } // namespace
 
 reporter::reporter(registry&) noexcept {}
@@ -111,9 +154,33 @@ void reporter::report(const registry& r, const event::data& event) noexcept {
                     make_colored(" with ", r.with_color, color::highlight2),
                     make_colored(
                         "snitch v" SNITCH_FULL_VERSION "\n", r.with_color, color::highlight1));
+                if (e.rng_seed != 0u) {
+                    r.print(
+                        make_colored("random seed: ", r.with_color, color::highlight2),
+                        make_colored(e.rng_seed, r.with_color, color::highlight1), "\n");
+                }
                 r.print("==========================================\n");
             },
             [&](const snitch::event::test_run_ended& e) {
+#if SNITCH_WITH_TIMINGS
+                const auto* durations = r.test_durations();
+                if (durations != nullptr && !durations->get_slowest().empty()) {
+                    r.print(
+                        make_colored(
+                            "slowest test cases and sections:", r.with_color, color::status),
+                        "\n");
+                    for (const auto& entry : durations->get_slowest()) {
+                        small_string<max_message_length> seconds;
+                        static_cast<void>(append_seconds(seconds, entry.duration));
+                        r.print("  ", seconds, " s: ", entry.name, "\n");
+                    }
+                }
+
+                if (r.startup_stats) {
+                    print_startup_stats(r);
+                }
+#endif
+
                 r.print("==========================================\n");
 
                 if (e.success) {
@@ -132,6 +199,14 @@ void reporter::report(const registry& r, const event::data& event) noexcept {
                     r.print(", ", e.skip_count, " test cases skipped");
                 }
 
+                if (e.flaky_count > 0) {
+                    r.print(", ", e.flaky_count, " flaky test cases");
+                }
+
+                if (e.aborted) {
+                    r.print(", aborted");
+                }
+
 #if SNITCH_WITH_TIMINGS
                 r.print(", ", e.duration, " seconds");
 #endif
@@ -155,11 +230,46 @@ void reporter::report(const registry& r, const event::data& event) noexcept {
                 r.print(
                     make_colored("finished:", r.with_color, color::status), " ",
                     make_colored(full_name, r.with_color, color::highlight1), " (", e.duration,
-                    "s)\n");
+                    "s)");
 #else
                 r.print(
                     make_colored("finished:", r.with_color, color::status), " ",
-                    make_colored(full_name, r.with_color, color::highlight1), "\n");
+                    make_colored(full_name, r.with_color, color::highlight1));
+#endif
+                if (e.retries > 0) {
+                    r.print(" (retry ", e.retries, ")");
+                }
+                r.print("\n");
+
+#if SNITCH_WITH_TIMINGS
+                if (const auto* durations = r.test_durations()) {
+                    if (const auto duration = durations->get_last_test_case()) {
+                        small_string<max_message_length> seconds;
+                        static_cast<void>(append_seconds(seconds, *duration));
+                        r.print(seconds, " s: ", full_name, "\n");
+                    }
+                }
+#endif
+
+#if SNITCH_WITH_PERF_COUNTERS
+                bool first_counter = true;
+                for_each_perf_counter(e.counters, [&](std::string_view name, std::uint64_t value) {
+                    r.print(first_counter ? "          " : ", ", name, ": ", value);
+                    first_counter = false;
+                });
+                if (!first_counter) {
+                    r.print("\n");
+                }
+#endif
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+                bool first_stat = true;
+                for_each_allocation_stat(
+                    e.allocations, [&](std::string_view name, std::size_t value) {
+                        r.print(first_stat ? "          " : ", ", name, ": ", value);
+                        first_stat = false;
+                    });
+                r.print("\n");
 #endif
             },
             [&](const snitch::event::section_started& e) {
@@ -0,0 +1,256 @@
+#include "snitch/snitch_config.hpp"
+
+#if SNITCH_WITH_JUNIT_REPORTER || SNITCH_WITH_ALL_REPORTERS
+
+#    include "snitch/snitch_durations.hpp"
+#    include "snitch/snitch_file.hpp"
+#    include "snitch/snitch_macros_reporter.hpp"
+#    include "snitch/snitch_registry.hpp"
+#    include "snitch/snitch_reporter_junit.hpp"
+#    include "snitch/snitch_string.hpp"
+#    include "snitch/snitch_string_utility.hpp"
+#    include "snitch/snitch_test_data.hpp"
+
+#    include <algorithm> // for std::min
+
+namespace snitch::reporter::junit {
+namespace {
+bool escape(small_string_span string) noexcept {
+    return escape_all_or_truncate(string, "&", "&amp;") &&
+           escape_all_or_truncate(string, "\"", "&quot;") &&
+           escape_all_or_truncate(string, "'", "&apos;") &&
+           escape_all_or_truncate(string, "<", "&lt;") &&
+           escape_all_or_truncate(string, ">", "&gt;") &&
+           escape_all_or_truncate(string, "\n", "&#10;");
+}
+
+small_string<max_message_length> make_escaped(std::string_view string) noexcept {
+    small_string<max_message_length> escaped_string;
+    append_or_truncate(escaped_string, string);
+    escape(escaped_string);
+    return escaped_string;
+}
+
+small_string<max_test_name_length> make_full_name(const test_id& id) noexcept {
+    small_string<max_test_name_length> name;
+    snitch::impl::make_full_name(name, id);
+    escape(name);
+    return name;
+}
+
+small_string<max_message_length> make_class_name(const test_id& id) noexcept {
+    return make_escaped(id.fixture.empty() ? "global" : id.fixture);
+}
+
+small_string<max_message_length> make_message(const assertion_data& data) noexcept {
+    small_string<max_message_length> string;
+    std::visit(
+        overload{
+            [&](std::string_view message) { append_or_truncate(string, message); },
+            [&](const snitch::expression_info& exp) {
+                append_or_truncate(string, exp.type, "(", exp.expected, ")");
+                if (!exp.actual.empty()) {
+                    append_or_truncate(string, ", got: ", exp.actual);
+                }
+            }},
+        data);
+    escape(string);
+    return string;
+}
+
+constexpr std::size_t max_number_length = 32;
+
+template<typename T>
+small_string<max_number_length> make_string(T number) noexcept {
+    small_string<max_number_length> string;
+    append_or_truncate(string, number);
+    return string;
+}
+
+#    if SNITCH_WITH_TIMINGS
+small_string<max_number_length> make_time(float seconds) noexcept {
+    small_string<max_number_length> string;
+    snitch::impl::append_seconds(
+        string, static_cast<time_point_t>(static_cast<double>(seconds) * 1e9));
+    return string;
+}
+#    endif
+
+// Space reserved in the output file for the test suite totals, and for the test case duration.
+constexpr std::size_t max_totals_length = 160;
+constexpr std::size_t max_time_length   = 24;
+
+// Write blank space to the output, to be overwritten later with patch(). Returns the position of
+// the blank space, or zero if the output is not a seekable file.
+std::size_t reserve(const registry& r, std::size_t length) noexcept {
+    const snitch::impl::file_writer* file = r.output_file();
+    if (file == nullptr) {
+        return 0;
+    }
+
+    const auto position = file->tell();
+    if (!position.has_value()) {
+        return 0;
+    }
+
+    constexpr std::string_view spaces = "                                ";
+    for (std::size_t i = 0; i < length; i += spaces.size()) {
+        r.print(spaces.substr(0, std::min(spaces.size(), length - i)));
+    }
+
+    return position.value();
+}
+
+// Overwrite the blank space created with reserve(). Content that does not fit is not written.
+void patch(
+    const registry&  r,
+    std::size_t      position,
+    std::size_t      length,
+    std::string_view content) noexcept {
+
+    const snitch::impl::file_writer* file = r.output_file();
+    if (file == nullptr || content.size() > length) {
+        return;
+    }
+
+    file->write_at(position, content);
+}
+
+void print_property(const registry& r, std::string_view name, std::string_view value) noexcept {
+    r.print("      <property name=\"", name, "\" value=\"", value, "\"/>\n");
+}
+
+void print_details(
+    const registry&           r,
+    const assertion_location& location,
+    const section_info&       sections,
+    const capture_info&       captures) noexcept {
+
+    for (const auto& section : sections) {
+        r.print("        section: ", make_escaped(section.id.name), "\n");
+    }
+    for (const auto& capture : captures) {
+        r.print("        with ", make_escaped(capture), "\n");
+    }
+    r.print("        at ", make_escaped(location.file), ":", location.line, "\n");
+}
+} // namespace
+
+reporter::reporter(registry& r) noexcept {
+    // The JUnit reporter needs test_case_started and test_case_ended events, which are only
+    // printed on verbosity 'high', so ensure the requested verbosity is at least as much.
+    r.verbose = r.verbose < registry::verbosity::high ? registry::verbosity::high : r.verbose;
+}
+
+bool reporter::configure(registry&, std::string_view, std::string_view) noexcept {
+    // No configuration
+    return false;
+}
+
+void reporter::report(const registry& r, const snitch::event::data& event) noexcept {
+    std::visit(
+        snitch::overload{
+            [&](const snitch::event::test_run_started& e) {
+                r.print("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n");
+                r.print("  <testsuite name=\"", make_escaped(e.name), "\"");
+                suite_totals_position = reserve(r, max_totals_length);
+                r.print(">\n");
+            },
+            [&](const snitch::event::test_run_ended& e) {
+                small_string<max_totals_length> totals;
+
+                bool fits = append(
+                    totals, " tests=\"", e.run_count, "\" failures=\"", e.fail_count,
+                    "\" errors=\"0\" skipped=\"", e.skip_count, "\"");
+#    if SNITCH_WITH_TIMINGS
+                fits = fits && append(totals, " time=\"", make_time(e.duration), "\"");
+#    endif
+
+                if (suite_totals_position != 0u) {
+                    if (fits) {
+                        patch(r, suite_totals_position, max_totals_length, totals);
+                    }
+                } else {
+                    // The output cannot be patched; write the totals as trailing properties.
+                    r.print("    <properties>\n");
+                    print_property(r, "tests", make_string(e.run_count));
+                    print_property(r, "failures", make_string(e.fail_count));
+                    print_property(r, "errors", "0");
+                    print_property(r, "skipped", make_string(e.skip_count));
+#    if SNITCH_WITH_TIMINGS
+                    print_property(r, "time", make_time(e.duration));
+#    endif
+                    r.print("    </properties>\n");
+                }
+
+                r.print("  </testsuite>\n</testsuites>\n");
+            },
+            [&](const snitch::event::test_case_started& e) {
+                if (e.retries > 0u) {
+                    // All the runs of a retried test case are written in the same element.
+                    return;
+                }
+
+                r.print(
+                    "    <testcase classname=\"", make_class_name(e.id), "\" name=\"",
+                    make_full_name(e.id), "\"");
+#    if SNITCH_WITH_TIMINGS
+                test_case_time_position = reserve(r, max_time_length);
+#    endif
+                r.print(">\n");
+            },
+            [&](const snitch::event::test_case_ended& e) {
+                if (e.will_retry) {
+                    return;
+                }
+
+#    if SNITCH_WITH_TIMINGS
+                // The time is that of the last run, if the test case was retried.
+                if (test_case_time_position != 0u) {
+                    small_string<max_time_length> time;
+                    if (append(time, " time=\"", make_time(e.duration), "\"")) {
+                        patch(r, test_case_time_position, max_time_length, time);
+                    }
+                } else {
+                    // The output cannot be patched; write the time as a trailing property.
+                    r.print(
+                        "      <properties>\n        <property name=\"time\" value=\"",
+                        make_time(e.duration), "\"/>\n      </properties>\n");
+                }
+#    endif
+                r.print("    </testcase>\n");
+            },
+            [&](const snitch::event::section_started&) {},
+            [&](const snitch::event::section_ended&) {},
+            [&](const snitch::event::test_case_skipped& e) {
+                r.print("      <skipped message=\"", make_escaped(e.message), "\">\n");
+                print_details(r, e.location, e.sections, e.captures);
+                r.print("      </skipped>\n");
+            },
+            [&](const snitch::event::assertion_failed& e) {
+                if (e.expected || e.allowed) {
+                    // Not a failure of the test case.
+                    return;
+                }
+
+                // Failures of a run which may be retried do not fail the test case on their own.
+                const std::string_view element = e.may_retry ? "rerunFailure" : "failure";
+                r.print("      <", element, " message=\"", make_message(e.data), "\">\n");
+                print_details(r, e.location, e.sections, e.captures);
+                r.print("      </", element, ">\n");
+            },
+            [&](const snitch::event::assertion_succeeded&) {},
+            [&](const snitch::event::list_test_run_started&) {},
+            [&](const snitch::event::list_test_run_ended&) {},
+            [&](const snitch::event::test_case_listed& e) {
+                small_string<max_test_name_length> name;
+                snitch::impl::make_full_name(name, e.id);
+                r.print(name, "\n");
+            }},
+        event);
+}
+} // namespace snitch::reporter::junit
+
+SNITCH_REGISTER_REPORTER("junit", snitch::reporter::junit::reporter);
+
+#endif
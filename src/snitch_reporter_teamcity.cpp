@@ -2,7 +2,9 @@
 
 #if SNITCH_WITH_TEAMCITY_REPORTER || SNITCH_WITH_ALL_REPORTERS
 
+#    include "snitch/snitch_allocations.hpp"
 #    include "snitch/snitch_macros_reporter.hpp"
+#    include "snitch/snitch_perf_counters.hpp"
 #    include "snitch/snitch_registry.hpp"
 #    include "snitch/snitch_reporter_teamcity.hpp"
 #    include "snitch/snitch_string.hpp"
@@ -108,6 +110,14 @@ small_string<max_test_name_length> make_full_name(const test_id& id) noexcept {
 
 constexpr std::size_t max_duration_length = 32;
 
+#    if SNITCH_WITH_PERF_COUNTERS || SNITCH_WITH_ALLOCATION_TRACKING
+small_string<max_duration_length> make_number(std::uint64_t value) noexcept {
+    small_string<max_duration_length> string;
+    append_or_truncate(string, value);
+    return string;
+}
+#    endif
+
 #    if SNITCH_WITH_TIMINGS
 small_string<max_duration_length> make_duration(float duration) noexcept {
     small_string<max_duration_length> string;
@@ -137,6 +147,30 @@ void report(const registry& r, const snitch::event::data& event) noexcept {
                 send_message(r, "testStarted", {{"name", make_full_name(e.id)}});
             },
             [&](const snitch::event::test_case_ended& e) {
+#    if SNITCH_WITH_PERF_COUNTERS
+                snitch::impl::for_each_perf_counter(
+                    e.counters, [&](std::string_view name, std::uint64_t value) {
+                        send_message(
+                            r, "testMetadata",
+                            {{"testName", make_full_name(e.id)},
+                             {"name", name},
+                             {"type", "number"},
+                             {"value", make_number(value)}});
+                    });
+#    endif
+
+#    if SNITCH_WITH_ALLOCATION_TRACKING
+                snitch::impl::for_each_allocation_stat(
+                    e.allocations, [&](std::string_view name, std::size_t value) {
+                        send_message(
+                            r, "testMetadata",
+                            {{"testName", make_full_name(e.id)},
+                             {"name", name},
+                             {"type", "number"},
+                             {"value", make_number(value)}});
+                    });
+#    endif
+
 #    if SNITCH_WITH_TIMINGS
                 send_message(
                     r, "testFinished",
@@ -183,6 +217,7 @@ SNITCH_REGISTER_REPORTER_CALLBACKS(
     &snitch::reporter::teamcity::initialize,
     {},
     &snitch::reporter::teamcity::report,
-    {});
+    {},
+    snitch::reporter::teamcity::event_mask);
 
 #endif
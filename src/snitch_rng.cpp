@@ -0,0 +1,42 @@
+#include "snitch/snitch_rng.hpp"
+
+#include "snitch/snitch_test_data.hpp"
+
+#include <chrono> // for std::chrono
+
+namespace snitch {
+rng_engine& rng() noexcept {
+    return impl::get_current_test().rng;
+}
+} // namespace snitch
+
+namespace snitch::impl {
+std::uint64_t get_test_seed(std::uint64_t run_seed, const test_id& id) noexcept {
+    // FNV-1a hash of the full test name, mixed with the run seed.
+    std::uint64_t hash   = 0xcbf29ce484222325u;
+    const auto    update = [&](std::string_view str) noexcept {
+        for (const char c : str) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3u;
+        }
+    };
+
+    update(id.name);
+    update(id.type);
+
+    std::uint64_t state = run_seed ^ hash;
+    const auto    seed  = splitmix64(state);
+    return seed != 0u ? seed : 1u;
+}
+
+std::uint64_t make_random_seed() noexcept {
+    // Mix the current time with the address of a stack variable, which changes from one run to
+    // the next when the address space layout is randomized.
+    const auto now   = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    const int  local = 0;
+
+    std::uint64_t state = static_cast<std::uint64_t>(now) ^
+                          static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(&local));
+    const auto    seed  = splitmix64(state);
+    return seed != 0u ? seed : 1u;
+}
+} // namespace snitch::impl
@@ -4,6 +4,7 @@
 #include "snitch/snitch_registry.hpp"
 #include "snitch/snitch_test_data.hpp"
 #include "snitch/snitch_time.hpp"
+#include "snitch/snitch_watchdog.hpp"
 
 #if SNITCH_WITH_EXCEPTIONS
 #    include <exception>
@@ -63,6 +64,8 @@ section_entry_checker::~section_entry_checker() {
             registry::report_section_ended(sections.current_section.back());
         }
 
+        registry::report_section_exited(sections.current_section);
+
         sections.current_section.pop_back();
     }
 
@@ -70,6 +73,8 @@ section_entry_checker::~section_entry_checker() {
 }
 
 section_entry_checker::operator bool() {
+    check_timeout(state);
+
 #if SNITCH_WITH_EXCEPTIONS
     if (std::uncaught_exceptions() == 0) {
         notify_exception_handled();
@@ -141,4 +146,27 @@ section_entry_checker::operator bool() {
 
     return true;
 }
+
+void run_sections(test_state& state, const function_ref<void()>& func) {
+    do {
+        // Reset section state.
+        state.info.sections.leaf_executed = false;
+        for (std::size_t i = 0; i < state.info.sections.levels.size(); ++i) {
+            state.info.sections.levels[i].current_section_id = 0;
+        }
+
+        func();
+
+        if (state.info.sections.levels.size() == 1) {
+            // The function contained sections; check if there are any more left to evaluate.
+            auto& child = state.info.sections.levels[0];
+            if (child.previous_section_id == child.max_section_id) {
+                // No more; clear the section state.
+                state.info.sections.levels.clear();
+                state.info.sections.current_section.clear();
+            }
+        }
+    } while (!state.info.sections.levels.empty() &&
+             state.test.state != test_case_state::skipped && !state.reg.is_aborting());
+}
 } // namespace snitch::impl
@@ -0,0 +1,38 @@
+#include "snitch/snitch_startup_stats.hpp"
+
+#if SNITCH_WITH_TIMINGS
+#    include <array> // for std::array
+
+namespace snitch::impl {
+namespace {
+// Test cases are registered from static initializers, so this must be constant-initialized.
+constinit std::array<startup_timing, static_cast<std::size_t>(startup_phase::count)> timings = {};
+
+startup_timing& get_timing(startup_phase phase) noexcept {
+    return timings[static_cast<std::size_t>(phase)];
+}
+} // namespace
+
+void start_startup_phase(startup_phase phase) noexcept {
+    startup_timing& timing = get_timing(phase);
+    if (!timing.start.has_value()) {
+        timing.start = get_current_time();
+    }
+}
+
+void end_startup_phase(startup_phase phase) noexcept {
+    startup_timing& timing = get_timing(phase);
+    if (timing.start.has_value() && !timing.end.has_value()) {
+        timing.end = get_current_time();
+    }
+}
+
+void set_startup_phase(startup_phase phase, time_point_t start, time_point_t end) noexcept {
+    get_timing(phase) = {.start = start, .end = end};
+}
+
+startup_timing get_startup_phase(startup_phase phase) noexcept {
+    return get_timing(phase);
+}
+} // namespace snitch::impl
+#endif
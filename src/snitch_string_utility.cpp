@@ -4,6 +4,7 @@
 
 #include <algorithm> // for std::rotate
 #include <cstring> // for std::memcpy
+#include <limits> // for std::numeric_limits
 
 namespace snitch {
 namespace {
@@ -155,6 +156,33 @@ bool escape_all_or_truncate(
     return !overflow;
 }
 
+bool escape_json_or_truncate(small_string_span string) {
+    if (!escape_all_or_truncate(string, "\\", "\\\\") ||
+        !escape_all_or_truncate(string, "\"", "\\\"") ||
+        !escape_all_or_truncate(string, "\n", "\\n") ||
+        !escape_all_or_truncate(string, "\r", "\\r") ||
+        !escape_all_or_truncate(string, "\t", "\\t")) {
+        return false;
+    }
+
+    // Other control characters have no short escape sequence.
+    constexpr std::string_view hex_digits = "0123456789abcdef";
+    for (std::size_t c = 0u; c < 0x20u; ++c) {
+        const char             pattern = static_cast<char>(c);
+        const std::string_view sv(string.begin(), string.size());
+        if (sv.find(pattern) == std::string_view::npos) {
+            continue;
+        }
+
+        const char replacement[] = {'\\', 'u', '0', '0', hex_digits[c / 16u], hex_digits[c % 16u]};
+        if (!escape_all_or_truncate(string, {&pattern, 1u}, {replacement, sizeof(replacement)})) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 std::size_t find_first_not_escaped(std::string_view str, char c) noexcept {
     for (std::size_t i = 0; i < str.size(); ++i) {
         bool escaped = false;
@@ -239,4 +267,28 @@ bool is_match(std::string_view string, std::string_view regex) noexcept {
     // an exact match. Therefore, only match if the string size is the same as the regex.
     return js == string_size;
 }
+
+std::optional<std::uint64_t> parse_unsigned(std::string_view str) noexcept {
+    if (str.empty()) {
+        return {};
+    }
+
+    constexpr std::uint64_t max_value = std::numeric_limits<std::uint64_t>::max();
+
+    std::uint64_t value = 0u;
+    for (const char c : str) {
+        if (c < '0' || c > '9') {
+            return {};
+        }
+
+        const auto digit = static_cast<std::uint64_t>(c - '0');
+        if (value > (max_value - digit) / 10u) {
+            return {};
+        }
+
+        value = value * 10u + digit;
+    }
+
+    return value;
+}
 } // namespace snitch
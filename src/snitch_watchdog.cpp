@@ -0,0 +1,227 @@
+#include "snitch/snitch_watchdog.hpp"
+
+#include "snitch/snitch_append.hpp"
+#include "snitch/snitch_error_handling.hpp"
+#include "snitch/snitch_registry.hpp"
+#include "snitch/snitch_string_utility.hpp"
+
+#include <cstdio> // for std::fwrite, std::fflush
+#include <exception> // for std::terminate
+
+#if SNITCH_WITH_MULTITHREADING
+#    include <atomic> // for std::atomic
+#    include <chrono> // for std::chrono
+#    include <condition_variable> // for std::condition_variable
+#    include <mutex> // for std::mutex, std::unique_lock
+#    include <thread> // for std::thread
+#endif
+
+namespace snitch::impl {
+namespace {
+#if SNITCH_WITH_MULTITHREADING
+using clock = std::chrono::steady_clock;
+
+// Time left to a timed out test case to stop itself, before the watchdog gives up on it.
+constexpr auto grace_period = std::chrono::seconds(1);
+
+// A single thread, started on first use, which sleeps until the deadline of the watched test case.
+// Test cases are run one at a time, so one slot is enough. When the deadline expires, the test case
+// is flagged as timed out, and stops itself from its own thread at its next assertion or section
+// (see 'check_timeout()'). The watchdog never reads the test state, which the test case may be
+// modifying; if the test case is still running after the grace period, it is presumed stuck and
+// 'handler' is called.
+struct watchdog {
+    std::mutex              mutex;
+    std::condition_variable wake_up;
+    std::thread             thread;
+
+    const test_state* state       = nullptr;
+    std::uint64_t     timeout_ms  = 0u;
+    timeout_handler   handler     = nullptr;
+    clock::time_point deadline    = {};
+    std::thread::id   test_thread = {};
+    bool              stop        = false;
+
+    // Set to 'state' once its deadline expired; read without locking by 'check_timeout()'.
+    std::atomic<const test_state*> expired = nullptr;
+
+    void run() noexcept {
+        std::unique_lock lock(mutex);
+        while (!stop) {
+            if (state == nullptr) {
+                wake_up.wait(lock);
+            } else if (clock::now() < deadline) {
+                wake_up.wait_until(lock, deadline);
+            } else if (expired == nullptr) {
+                expired = state;
+                deadline += grace_period;
+            } else {
+                const test_state&     s = *state;
+                const std::uint64_t   t = timeout_ms;
+                const timeout_handler h = handler;
+                state                   = nullptr;
+
+                // The handler may block or terminate; do not hold the lock meanwhile.
+                lock.unlock();
+                h(s, t);
+                lock.lock();
+            }
+        }
+    }
+
+    ~watchdog() {
+        {
+            std::unique_lock lock(mutex);
+            stop = true;
+        }
+
+        wake_up.notify_one();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+};
+
+watchdog& get_watchdog() noexcept {
+    static watchdog w;
+    return w;
+}
+#endif
+
+// Start the message shared by both ways of reporting a timeout.
+bool append_timeout(
+    small_string_span message, const test_state& state, std::uint64_t timeout_ms) noexcept {
+    small_string<max_test_name_length> name_buffer;
+    const std::string_view             full_name = make_full_name(name_buffer, state.test.id);
+
+    bool success = append(message, "test case \"", full_name, "\" timed out after ");
+    if (timeout_ms % 1000u == 0u) {
+        success = success && append(message, timeout_ms / 1000u, "s");
+    } else {
+        success = success && append(message, timeout_ms, "ms");
+    }
+
+    return success;
+}
+
+#if SNITCH_WITH_MULTITHREADING
+// Full message, with the innermost location: the check being evaluated, or else the current
+// section, or else the test case itself. Only called from the thread running the test case.
+void make_timeout_message(
+    small_string_span message, const test_state& state, std::uint64_t timeout_ms) noexcept {
+    bool success = append_timeout(message, state, timeout_ms);
+    if (!state.info.locations.empty()) {
+        const assertion_location& location = state.info.locations.back();
+        success = success && append(message, "; last seen at ", location.file, ":", location.line);
+    }
+
+    if (!success) {
+        truncate_end(message);
+    }
+}
+#endif
+} // namespace
+
+void watch_test(
+    [[maybe_unused]] const test_state& state,
+    [[maybe_unused]] std::uint64_t     timeout_ms,
+    [[maybe_unused]] timeout_handler   handler) noexcept {
+#if SNITCH_WITH_MULTITHREADING
+    watchdog& w = get_watchdog();
+
+    {
+        std::unique_lock lock(w.mutex);
+        w.state       = &state;
+        w.timeout_ms  = timeout_ms;
+        w.handler     = handler;
+        w.deadline    = clock::now() + std::chrono::milliseconds(timeout_ms);
+        w.test_thread = std::this_thread::get_id();
+        w.expired     = nullptr;
+
+        if (!w.thread.joinable()) {
+            w.thread = std::thread([&w]() noexcept { w.run(); });
+        }
+    }
+
+    w.wake_up.notify_one();
+#endif
+}
+
+void unwatch_test() noexcept {
+#if SNITCH_WITH_MULTITHREADING
+    watchdog& w = get_watchdog();
+
+    std::unique_lock lock(w.mutex);
+    w.state   = nullptr;
+    w.expired = nullptr;
+#endif
+}
+
+void check_timeout([[maybe_unused]] const test_state& state) noexcept {
+#if SNITCH_WITH_MULTITHREADING
+    watchdog& w = get_watchdog();
+    if (w.expired.load() != &state || std::this_thread::get_id() != w.test_thread) {
+        return;
+    }
+
+    std::uint64_t timeout_ms = 0u;
+    {
+        // Stop watching, so the watchdog does not terminate the application while the run is
+        // ended. If it already gave up on the test case, it is terminating the application.
+        std::unique_lock lock(w.mutex);
+        if (w.state != &state) {
+            return;
+        }
+
+        timeout_ms = w.timeout_ms;
+        w.state    = nullptr;
+        w.expired  = nullptr;
+    }
+
+    small_string<max_message_length> message;
+    make_timeout_message(message, state, timeout_ms);
+
+    // Report the test case as failed and complete the output of the reporters, since the test
+    // application cannot carry on.
+    state.reg.end_timed_out_run(state, timeout_ms, message);
+
+    terminate_with(message);
+#endif
+}
+
+[[noreturn]] void report_timeout(const test_state& state, std::uint64_t timeout_ms) noexcept {
+    // The test case is still running on another thread, and may hold locks (including that of
+    // the console output), so only its immutable ID is read, and the message goes straight to the
+    // standard error.
+    small_string<max_message_length> message;
+    bool success = append_timeout(message, state, timeout_ms) &&
+                   append(message, " and did not stop; terminating\n");
+    if (!success) {
+        truncate_end(message);
+    }
+
+    std::fwrite(message.data(), 1u, message.size(), stderr);
+    std::fflush(stderr);
+    std::terminate();
+}
+
+std::optional<std::uint64_t> parse_timeout(std::string_view value) noexcept {
+    std::uint64_t multiplier = 1000u;
+    if (value.ends_with("ms")) {
+        value.remove_suffix(2u);
+        multiplier = 1u;
+    } else if (value.ends_with("s")) {
+        value.remove_suffix(1u);
+    }
+
+    // About 30 years; large enough to never expire, small enough to never overflow the clock.
+    constexpr std::uint64_t max_timeout_ms = 1'000'000'000'000u;
+
+    const auto count = parse_unsigned(value);
+    if (!count.has_value() || *count == 0u || *count > max_timeout_ms / multiplier) {
+        return {};
+    }
+
+    return *count * multiplier;
+}
+} // namespace snitch::impl
@@ -0,0 +1,166 @@
+#include "testing.hpp"
+#include "testing_assertions.hpp"
+#include "testing_event.hpp"
+#include "testing_reporters.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if (SNITCH_WITH_BINARY_REPORTER && SNITCH_WITH_CATCH2_XML_REPORTER) || SNITCH_WITH_ALL_REPORTERS
+
+using namespace std::literals;
+
+namespace {
+struct print_to_string {
+    std::string string;
+
+    explicit print_to_string(snitch::registry& r) {
+        r.print_callback = {*this, snitch::constant<&print_to_string::print>{}};
+    }
+
+    void print(std::string_view msg) noexcept {
+        string.append(msg);
+    }
+};
+
+std::string record(snitch::registry& r, const arg_vector& args) {
+    print_to_string output{r};
+    auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+    r.configure(input.value());
+    r.run_tests(input.value());
+    return std::move(output.string);
+}
+
+bool replay(
+    snitch::registry& r, std::string_view log, const arg_vector& args, std::string_view filename) {
+    print_to_file file_override{r, filename};
+    auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+    // Undo the verbosity set by the binary reporter.
+    r.verbose = snitch::registry::verbosity::normal;
+    r.configure(input.value());
+    const bool success = snitch::reporter::binary::replay(r, log);
+    r.finish_callback(r);
+    return success;
+}
+} // namespace
+
+TEST_CASE("binary reporter", "[reporters]") {
+    mock_framework framework;
+    register_tests_for_reporters(framework.registry);
+    framework.registry.add({"test escape <>&\"'"}, SNITCH_CURRENT_LOCATION, [] {
+        SNITCH_FAIL("escape <>&\"' in messages");
+    });
+    framework.registry.add({"test escape very long"}, SNITCH_CURRENT_LOCATION, [] {
+        SNITCH_FAIL(std::string(2 * snitch::max_message_length, '&'));
+    });
+
+    framework.registry.add_reporter<snitch::reporter::binary::reporter>("binary");
+
+    std::optional<snitch::reporter::catch2_xml::reporter> reporter;
+    auto init      = [&](snitch::registry& r) { reporter.emplace(r); };
+    auto configure = [&](snitch::registry& r, std::string_view k, std::string_view v) noexcept {
+        return reporter.value().configure(r, k, v);
+    };
+    auto report = [&](const snitch::registry& r, const snitch::event::data& e) noexcept {
+        return reporter.value().report(r, e);
+    };
+    auto finish = [&](snitch::registry&) noexcept { reporter.reset(); };
+
+    framework.registry.add_reporter("xml", init, configure, report, finish);
+
+    // The log is replayed into the XML reporter; the output must be the same as if the XML
+    // reporter had been used directly (see reporter_catch2_xml.cpp).
+#    define REPORTER_PREFIX "reporter_binary_xml_"
+
+    const std::vector<std::regex> ignores = {
+        std::regex{R"|(durationInSeconds="([0-9.e+\-]{12})")|"},
+        std::regex{R"(catch2-version="([0-9]+\.[0-9]+\.[0-9]+\.[0-9a-z]+).snitch)"},
+        std::regex{R"(filename="(.+/snitch/tests/approval_tests/))"},
+        std::regex{R"(filename="(.+/snitch/tests/))"},
+        std::regex{R"(<File>(.+/snitch/tests/approval_tests/))"},
+        std::regex{R"(<File>(.+/snitch/tests/))"},
+        std::regex{R"(filename="(.+\\snitch\\tests\\approval_tests\\))"},
+        std::regex{R"(filename="(.+\\snitch\\tests\\))"},
+        std::regex{R"(<File>(.+\\snitch\\tests\\approval_tests\\))"},
+        std::regex{R"(<File>(.+\\snitch\\tests\\))"},
+        std::regex{R"|(line="([0-9]+)")|"},
+        std::regex{R"(<Line>([0-9]+))"}};
+
+    SECTION("default") {
+        const auto log = record(framework.registry, {"test", "--reporter", "binary"});
+        CHECK(replay(
+            framework.registry, log, {"test", "--reporter", "xml"}, REPORTER_PREFIX "default"));
+        CHECK_FILE_FOR_DIFFERENCES(ignores, REPORTER_PREFIX "default", REPORTER_PREFIX "default");
+    }
+
+    SECTION("two reporters") {
+        // Each reporter writes its own log, and must intern strings independently.
+        record(
+            framework.registry, {"test", "--reporter", "binary::out=test_output_1.bin",
+                                 "--reporter", "binary::out=test_output_2.bin"});
+
+        const auto read_log = [](const char* path) {
+            std::string log;
+            {
+                std::ifstream file(path, std::ios::binary);
+                log.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+            std::filesystem::remove(path);
+            return log;
+        };
+
+        const auto log1 = read_log("test_output_1.bin");
+        const auto log2 = read_log("test_output_2.bin");
+
+        CHECK(replay(
+            framework.registry, log1, {"test", "--reporter", "xml"},
+            REPORTER_PREFIX "two_reporters_1"));
+        CHECK_FILE_FOR_DIFFERENCES(
+            ignores, REPORTER_PREFIX "two_reporters_1", REPORTER_PREFIX "default");
+        CHECK(replay(
+            framework.registry, log2, {"test", "--reporter", "xml"},
+            REPORTER_PREFIX "two_reporters_2"));
+        CHECK_FILE_FOR_DIFFERENCES(
+            ignores, REPORTER_PREFIX "two_reporters_2", REPORTER_PREFIX "default");
+    }
+
+    SECTION("all fail") {
+        const auto log = record(framework.registry, {"test", "--reporter", "binary", "* fail*"});
+        CHECK(replay(
+            framework.registry, log, {"test", "--reporter", "xml"}, REPORTER_PREFIX "allfail"));
+        CHECK_FILE_FOR_DIFFERENCES(ignores, REPORTER_PREFIX "allfail", REPORTER_PREFIX "allfail");
+    }
+
+    SECTION("full output") {
+        const auto log = record(framework.registry, {"test", "--reporter", "binary"});
+        CHECK(replay(
+            framework.registry, log, {"test", "--reporter", "xml", "--verbosity", "full"},
+            REPORTER_PREFIX "full"));
+        CHECK_FILE_FOR_DIFFERENCES(ignores, REPORTER_PREFIX "full", REPORTER_PREFIX "full");
+    }
+
+    SECTION("list tests") {
+        const auto log =
+            record(framework.registry, {"test", "--reporter", "binary", "--list-tests"});
+        CHECK(replay(
+            framework.registry, log, {"test", "--reporter", "xml"}, REPORTER_PREFIX "list_tests"));
+        CHECK_FILE_FOR_DIFFERENCES(
+            ignores, REPORTER_PREFIX "list_tests", REPORTER_PREFIX "list_tests");
+    }
+
+    SECTION("malformed log") {
+        const auto log = record(framework.registry, {"test", "--reporter", "binary"});
+        CHECK(replay(
+            framework.registry, "", {"test", "--reporter", "xml"}, REPORTER_PREFIX "empty"));
+        CHECK(!replay(
+            framework.registry, std::string_view{log}.substr(1), {"test", "--reporter", "xml"},
+            REPORTER_PREFIX "no_header"));
+        CHECK(!replay(
+            framework.registry, std::string_view{log}.substr(0, log.size() - 1),
+            {"test", "--reporter", "xml"}, REPORTER_PREFIX "truncated"));
+    }
+}
+
+#endif
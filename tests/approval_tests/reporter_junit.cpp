@@ -0,0 +1,98 @@
+#include "testing.hpp"
+#include "testing_assertions.hpp"
+#include "testing_event.hpp"
+#include "testing_reporters.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#if SNITCH_WITH_JUNIT_REPORTER || SNITCH_WITH_ALL_REPORTERS
+
+using namespace std::literals;
+using snitch::matchers::contains_substring;
+
+TEST_CASE("junit reporter", "[reporters]") {
+    mock_framework framework;
+    register_tests_for_reporters(framework.registry);
+    framework.registry.add({"test escape <>&\"'"}, SNITCH_CURRENT_LOCATION, [] {
+        SNITCH_FAIL("escape <>&\"' in messages");
+    });
+    framework.registry.add({"test escape very long"}, SNITCH_CURRENT_LOCATION, [] {
+        SNITCH_FAIL(std::string(2 * snitch::max_message_length, '&'));
+    });
+
+    std::optional<snitch::reporter::junit::reporter> reporter;
+    auto init      = [&](snitch::registry& r) { reporter.emplace(r); };
+    auto configure = [&](snitch::registry& r, std::string_view k, std::string_view v) noexcept {
+        return reporter.value().configure(r, k, v);
+    };
+    auto report = [&](const snitch::registry& r, const snitch::event::data& e) noexcept {
+        return reporter.value().report(r, e);
+    };
+    auto finish = [&](snitch::registry&) noexcept { reporter.reset(); };
+
+    framework.registry.add_reporter("junit", init, configure, report, finish);
+
+    constexpr const char* reporter_name = "junit";
+#    define REPORTER_PREFIX "reporter_junit_"
+
+    const std::vector<std::regex> ignores = {
+        std::regex{R"|(time="([0-9]+\.[0-9]{3})")|"},
+        std::regex{R"|(name="time" value="([0-9]+\.[0-9]{3})")|"},
+        std::regex{R"(at (.+/snitch/tests/approval_tests/).+:([0-9]+))"},
+        std::regex{R"(at (.+/snitch/tests/).+:([0-9]+))"},
+        std::regex{R"(at (.+\\snitch\\tests\\approval_tests\\).+:([0-9]+))"},
+        std::regex{R"(at (.+\\snitch\\tests\\).+:([0-9]+))"}};
+
+    SECTION("default") {
+        const arg_vector args{"test", "--reporter", reporter_name};
+        CHECK_FOR_DIFFERENCES(args, ignores, REPORTER_PREFIX "default");
+    }
+
+    SECTION("no test") {
+        const arg_vector args{"test", "--reporter", reporter_name, "bad_filter"};
+        CHECK_FOR_DIFFERENCES(args, ignores, REPORTER_PREFIX "notest");
+    }
+
+    SECTION("all pass") {
+        const arg_vector args{"test", "--reporter", reporter_name, "* pass*"};
+        CHECK_FOR_DIFFERENCES(args, ignores, REPORTER_PREFIX "allpass");
+    }
+
+    SECTION("all fail") {
+        const arg_vector args{"test", "--reporter", reporter_name, "* fail*"};
+        CHECK_FOR_DIFFERENCES(args, ignores, REPORTER_PREFIX "allfail");
+    }
+
+    SECTION("full output") {
+        const arg_vector args{"test", "--reporter", reporter_name, "--verbosity", "full"};
+        CHECK_FOR_DIFFERENCES(args, ignores, REPORTER_PREFIX "full");
+    }
+
+    SECTION("output file") {
+        // Writing to a file allows the totals to be patched in the header.
+        const arg_vector args{
+            "test", "--reporter", reporter_name, "--out", "data/actual/" REPORTER_PREFIX "file"};
+        CHECK_FOR_DIFFERENCES(args, ignores, REPORTER_PREFIX "file");
+    }
+
+    SECTION("retry") {
+        // All the runs of a retried test case are written in the same element.
+        framework.registry.add({"retry flaky"}, SNITCH_CURRENT_LOCATION, [] {
+            static bool failed = false;
+            SNITCH_CHECK(std::exchange(failed, true));
+        });
+        framework.registry.add(
+            {"retry fail"}, SNITCH_CURRENT_LOCATION, [] { SNITCH_FAIL_CHECK("always"); });
+
+        const arg_vector args{"test", "--reporter", reporter_name, "--retry", "1", "retry *"};
+        CHECK_FOR_DIFFERENCES(args, ignores, REPORTER_PREFIX "retry");
+    }
+
+        SECTION("list tests") {
+        const arg_vector args{"test", "--reporter", reporter_name, "--list-tests"};
+        CHECK_FOR_DIFFERENCES(args, ignores, REPORTER_PREFIX "list_tests");
+    }
+}
+
+#endif
@@ -3,6 +3,9 @@
 
 #include <algorithm>
 #include <compare>
+#include <limits>
+#include <new>
+#include <vector>
 
 #if SNITCH_WITH_EXCEPTIONS
 #    include <stdexcept>
@@ -910,6 +913,52 @@ TEST_CASE("check that", "[test macros]") {
     }
 }
 
+TEST_CASE("check range equal", "[test macros]") {
+    event_catcher<2> catcher;
+
+    SECTION("pass") {
+        // Large enough to be counted as many assertions, if it was done element by element.
+        const std::vector<int> expected(10000u, 42);
+        const std::vector<int> values = expected;
+
+        {
+            test_override override(catcher);
+            SNITCH_CHECK_RANGE_EQUAL(values, expected);
+        }
+
+        CHECK_EXPR_SUCCESS(catcher);
+    }
+
+    SECTION("fail") {
+        const std::vector<int> expected = {1, 2, 3, 4};
+        const std::vector<int> values   = {1, 5, 3, 6};
+
+        std::size_t failure_line = 0u;
+
+        {
+            test_override override(catcher);
+            // clang-format off
+            SNITCH_CHECK_RANGE_EQUAL(values, expected); failure_line = __LINE__;
+            // clang-format on
+        }
+
+        CHECK_EXPR_FAILURE(
+            catcher, failure_line, "CHECK_RANGE_EQUAL"sv, "values, expected"sv,
+            "2 of 4 elements differ; mismatches: [1] '5' vs '2', [3] '6' vs '4'"sv);
+    }
+
+    SECTION("braced expected") {
+        const std::vector<int> values = {1, 2, 3};
+
+        {
+            test_override override(catcher);
+            SNITCH_CHECK_RANGE_EQUAL(values, std::vector<int>{1, 2, 3});
+        }
+
+        CHECK_EXPR_SUCCESS(catcher);
+    }
+}
+
 TEST_CASE("check misc", "[test macros]") {
     event_catcher<1> catcher;
 
@@ -1480,6 +1529,79 @@ TEST_CASE("constexpr check that", "[test macros]") {
     }
 }
 
+#if SNITCH_WITH_ALLOCATION_TRACKING
+TEST_CASE("check no allocations", "[test macros]") {
+    event_catcher<2> catcher;
+
+    SECTION("pass") {
+        {
+            test_override override(catcher);
+            SNITCH_CHECK_NO_ALLOCATIONS {
+                int i = 0;
+                static_cast<void>(i);
+            }
+        }
+
+        CHECK_EXPR_SUCCESS(catcher);
+    }
+
+    SECTION("nested") {
+        {
+            test_override override(catcher);
+            SNITCH_CHECK_NO_ALLOCATIONS {
+                SNITCH_CHECK_NO_ALLOCATIONS {
+                    int i = 0;
+                    static_cast<void>(i);
+                }
+            }
+        }
+
+        CHECK(catcher.mock_test.asserts == 2u);
+        REQUIRE(catcher.events.size() == 2u);
+        CHECK(catcher.is_event<owning_event::assertion_succeeded>(0u));
+        CHECK(catcher.is_event<owning_event::assertion_succeeded>(1u));
+    }
+
+    SECTION("fail") {
+        std::size_t failure_line = 0u;
+
+        {
+            test_override override(catcher);
+            // clang-format off
+            SNITCH_CHECK_NO_ALLOCATIONS { ::operator delete(::operator new(16u)); } failure_line = __LINE__;
+            // clang-format on
+        }
+
+        CHECK_EXPR_FAILURE(
+            catcher, failure_line,
+            "expected no allocation, got 1 allocation(s) for a total of 16 bytes"sv);
+    }
+
+    SECTION("fail with break") {
+        std::size_t failure_line = 0u;
+
+        {
+            test_override override(catcher);
+            // clang-format off
+            SNITCH_REQUIRE_NO_ALLOCATIONS { ::operator delete(::operator new(16u)); break; } failure_line = __LINE__;
+            // clang-format on
+        }
+
+        CHECK_EXPR_FAILURE(
+            catcher, failure_line,
+            "expected no allocation, got 1 allocation(s) for a total of 16 bytes"sv);
+    }
+
+#    if SNITCH_WITH_EXCEPTIONS
+    SECTION("too large") {
+        CHECK_THROWS_AS(
+            static_cast<void>(::operator new(std::numeric_limits<std::size_t>::max() - 8u)),
+            std::bad_alloc);
+    }
+#    endif
+}
+#endif
+
 #if SNITCH_WITH_EXCEPTIONS
 struct my_exception : public std::exception {
     const char* what() const noexcept override {
@@ -0,0 +1,215 @@
+#include "testing.hpp"
+
+#include <csignal>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+
+#if SNITCH_WITH_MMAP_OUTPUT && SNITCH_WITH_MMAP_CRASH_HANDLERS &&                                 \
+    (defined(__unix__) || defined(__APPLE__))
+#    include <fcntl.h>
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
+
+namespace {
+std::string read_file(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+} // namespace
+
+TEST_CASE("file writer", "[utility]") {
+    constexpr const char* path = "test_file_writer.txt";
+
+    SECTION("write") {
+        {
+            snitch::impl::file_writer file{path};
+            CHECK(file.tell().value() == 0u);
+            file.write("hello");
+            file.write(", world");
+            CHECK(file.tell().value() == 12u);
+        }
+
+        CHECK(read_file(path) == "hello, world");
+    }
+
+    SECTION("write at") {
+        {
+            snitch::impl::file_writer file{path};
+            file.write("hello, world");
+            file.write_at(7u, "earth");
+            file.write("!");
+            CHECK(file.tell().value() == 13u);
+        }
+
+        CHECK(read_file(path) == "hello, earth!");
+    }
+
+    SECTION("move") {
+        {
+            snitch::impl::file_writer file{path};
+            file.write("hello");
+            snitch::impl::file_writer other{std::move(file)};
+            other.write(", world");
+            file.write("ignored");
+        }
+
+        CHECK(read_file(path) == "hello, world");
+    }
+
+    SECTION("large output") {
+        // Larger than the initial size of the memory mapping, if used.
+        const std::string line(1023u, 'a');
+        constexpr std::size_t num_lines = 5u * 1024u;
+
+        {
+            snitch::impl::file_writer file{path};
+            for (std::size_t i = 0; i < num_lines; ++i) {
+                file.write(line);
+                file.write("\n");
+            }
+            file.write_at(0u, "b");
+            CHECK(file.tell().value() == num_lines * 1024u);
+        }
+
+        const std::string content = read_file(path);
+        CHECK(content.size() == num_lines * 1024u);
+        CHECK(content.starts_with("baa"));
+        CHECK(content.ends_with("aa\n"));
+    }
+
+#if SNITCH_WITH_MMAP_OUTPUT && SNITCH_WITH_MMAP_CRASH_HANDLERS &&                                 \
+    (defined(__unix__) || defined(__APPLE__))
+    SECTION("abnormal exit") {
+        // A mapped file must not end with the unused space of the mapping.
+        const auto run_child = [&](void (*exit)()) {
+            const pid_t pid = ::fork();
+            if (pid == 0) {
+                // Silence the message of the default terminate handler.
+                ::dup2(::open("/dev/null", O_WRONLY), STDERR_FILENO);
+                snitch::impl::file_writer file{path};
+                file.write("hello");
+                exit();
+            }
+
+            int status = 0;
+            ::waitpid(pid, &status, 0);
+            return WIFSIGNALED(status);
+        };
+
+        CHECK(run_child([]() { std::terminate(); }));
+        CHECK(read_file(path) == "hello");
+        CHECK(run_child([]() { std::raise(SIGSEGV); }));
+        CHECK(read_file(path) == "hello");
+    }
+
+    SECTION("handlers restored") {
+        const std::terminate_handler previous = std::get_terminate();
+        {
+            snitch::impl::file_writer file{path};
+            CHECK(std::get_terminate() != previous);
+        }
+        CHECK(std::get_terminate() == previous);
+    }
+#endif
+
+    std::filesystem::remove(path);
+}
+
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+namespace {
+std::optional<std::string> decompress(const std::string& data) {
+    std::string output;
+    auto        append = [&](std::string_view block) noexcept { output.append(block); };
+    if (!snitch::impl::decompress(data, append)) {
+        return {};
+    }
+
+    return output;
+}
+} // namespace
+
+TEST_CASE("compressed file writer", "[utility]") {
+    constexpr const char* path = "test_file_writer.txt.z";
+
+    CHECK(snitch::impl::is_compressed_path(path));
+    CHECK(!snitch::impl::is_compressed_path("test_file_writer.txt"));
+    CHECK(!snitch::impl::is_compressed_path(".z"));
+
+    SECTION("empty") {
+        { snitch::impl::file_writer file{path}; }
+
+        const std::string content = read_file(path);
+        CHECK(content.size() == 11u);
+        CHECK(decompress(content) == "");
+    }
+
+    SECTION("write") {
+        {
+            snitch::impl::file_writer file{path};
+            file.write("hello");
+            file.write(", world");
+            CHECK(!file.tell().has_value());
+        }
+
+        CHECK(decompress(read_file(path)) == "hello, world");
+    }
+
+    SECTION("repetitive output") {
+        // Spans several blocks, and compresses well.
+        std::string expected;
+        {
+            snitch::impl::file_writer file{path};
+            for (std::size_t i = 0; i < 10000u; ++i) {
+                const std::string line =
+                    "<testcase name=\"test " + std::to_string(i) + "\" status=\"run\"/>\n";
+                file.write(line);
+                expected += line;
+            }
+        }
+
+        const std::string content = read_file(path);
+        CHECK(content.size() * 4u < expected.size());
+        CHECK(decompress(content) == expected);
+    }
+
+    SECTION("incompressible output") {
+        // Pseudo-random bytes; blocks are stored uncompressed.
+        std::string   expected;
+        std::uint32_t state = 12345u;
+        for (std::size_t i = 0; i < 3u * snitch::impl::compression_block_size / 2u; ++i) {
+            state = state * 1664525u + 1013904223u;
+            expected.push_back(static_cast<char>(state >> 24u));
+        }
+
+        {
+            snitch::impl::file_writer file{path};
+            file.write(expected);
+        }
+
+        const std::string content = read_file(path);
+        CHECK(content.size() == expected.size() + 19u);
+        CHECK(decompress(content) == expected);
+    }
+
+    SECTION("malformed data") {
+        {
+            snitch::impl::file_writer file{path};
+            file.write("hello, world, hello, world, hello, world");
+        }
+
+        const std::string content = read_file(path);
+        CHECK(decompress(content).has_value());
+        CHECK(!decompress("").has_value());
+        CHECK(!decompress(content.substr(1u)).has_value());
+        CHECK(!decompress(content.substr(0u, content.size() - 1u)).has_value());
+    }
+
+    std::filesystem::remove(path);
+}
+#endif
@@ -1,6 +1,12 @@
 #include "testing.hpp"
 
+#include <cmath>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <list>
 #include <stdexcept>
+#include <vector>
 
 using namespace std::literals;
 
@@ -109,3 +115,309 @@ TEST_CASE("matcher is_any_of", "[utility]") {
         m.describe_match(5u, snitch::matchers::match_status::failed) ==
         "'5' was not found in {'1', '2', '3'}"sv);
 }
+
+namespace {
+// Build the expected description, so floating point numbers are formatted as in the matchers.
+template<typename... Args>
+snitch::small_string<snitch::max_message_length> make_description(const Args&... args) {
+    snitch::small_string<snitch::max_message_length> description;
+    append_or_truncate(description, args...);
+    return description;
+}
+} // namespace
+
+TEST_CASE("matcher within_abs", "[utility]") {
+    using snitch::matchers::within_abs;
+
+    CHECK(1.0f == within_abs(1.0f, 0.0f));
+    CHECK(1.0f == within_abs(1.25f, 0.5f));
+    CHECK(1.0f != within_abs(2.0f, 0.5f));
+    CHECK(1.0 == within_abs(0.75, 0.25));
+    CHECK(-1.0 != within_abs(1.0, 1.0));
+    CHECK(within_abs(1.25, 0.5) == 1.0);
+
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    CHECK(inf == within_abs(inf, 0.0));
+    CHECK(inf != within_abs(-inf, 0.0));
+    CHECK(nan != within_abs(0.0, 1.0));
+    CHECK(nan != within_abs(nan, 1.0));
+
+    CHECK(
+        within_abs(1.25f, 0.5f).describe_match(1.0f, snitch::matchers::match_status::matched) ==
+        std::string_view{make_description("'", 1.0f, "' is within ", 0.5f, " of '", 1.25f, "'")});
+    CHECK(
+        within_abs(2.0f, 0.5f).describe_match(1.0f, snitch::matchers::match_status::failed) ==
+        std::string_view{
+            make_description("'", 1.0f, "' is not within ", 0.5f, " of '", 2.0f, "'")});
+}
+
+TEST_CASE("matcher within_rel", "[utility]") {
+    using snitch::matchers::within_rel;
+
+    CHECK(100.0 == within_rel(101.0, 0.01));
+    CHECK(100.0 != within_rel(102.0, 0.01));
+    CHECK(-100.0 == within_rel(-101.0, 0.01));
+    CHECK(0.0 == within_rel(0.0, 0.0));
+    CHECK(0.0 != within_rel(1e-300, 0.5));
+    CHECK(1.0f == within_rel(1.0f + 1e-7f, 1e-6f));
+
+    CHECK(
+        within_rel(102.0f, 0.01f).describe_match(100.0f, snitch::matchers::match_status::failed) ==
+        std::string_view{make_description(
+            "'", 100.0f, "' is not within ", 0.01f, " (relative) of '", 102.0f, "'")});
+}
+
+TEST_CASE("matcher within_ulps", "[utility]") {
+    using snitch::matchers::within_ulps;
+
+    const float one_f      = 1.0f;
+    const float one_f_next = std::nextafter(one_f, 2.0f);
+    const float one_f_prev = std::nextafter(one_f, 0.0f);
+
+    CHECK_THAT(one_f, within_ulps(one_f, 0u));
+    CHECK(one_f == within_ulps(one_f, 0u));
+    CHECK(one_f_next != within_ulps(one_f, 0u));
+    CHECK(one_f_next == within_ulps(one_f, 1u));
+    CHECK(one_f_prev == within_ulps(one_f, 1u));
+    CHECK(one_f_prev != within_ulps(one_f_next, 1u));
+    CHECK(one_f_prev == within_ulps(one_f_next, 2u));
+
+    constexpr double        tiny      = std::numeric_limits<double>::denorm_min();
+    constexpr double        huge      = std::numeric_limits<double>::max();
+    constexpr double        inf       = std::numeric_limits<double>::infinity();
+    constexpr double        nan       = std::numeric_limits<double>::quiet_NaN();
+    constexpr std::uint64_t max_ulps  = std::numeric_limits<std::uint64_t>::max() - 1u;
+    constexpr std::uint64_t huge_ulps = 2u * 0x7fef'ffff'ffff'ffffu;
+    CHECK(0.0 == within_ulps(-0.0, 0u));
+    CHECK(tiny == within_ulps(-tiny, 2u));
+    CHECK(tiny != within_ulps(-tiny, 1u));
+    CHECK(huge == within_ulps(inf, 1u));
+    CHECK(-huge == within_ulps(huge, huge_ulps));
+    CHECK(-huge != within_ulps(huge, huge_ulps - 1u));
+    CHECK(nan != within_ulps(nan, max_ulps));
+
+    CONSTEXPR_CHECK(snitch::impl::ulp_distance(1.0, 1.0) == 0u);
+    CONSTEXPR_CHECK(snitch::impl::ulp_distance(1.0, 1.0000000000000002) == 1u);
+    CONSTEXPR_CHECK(snitch::impl::ulp_distance(1.0f, 1.0000001f) == 1u);
+    CONSTEXPR_CHECK(snitch::impl::ulp_distance(1.0f, 1.0000004f) == 3u);
+
+    CHECK(
+        within_ulps(one_f, 2u).describe_match(
+            one_f_next, snitch::matchers::match_status::matched) ==
+        std::string_view{make_description(
+            "'", one_f_next, "' is within 2 ULPs of '", one_f, "' (distance: 1 ULPs)")});
+    CHECK(
+        within_ulps(one_f, 1u).describe_match(
+            std::numeric_limits<float>::quiet_NaN(), snitch::matchers::match_status::failed) ==
+        std::string_view{make_description(
+            "'", std::numeric_limits<float>::quiet_NaN(), "' is not within 1 ULPs of '", one_f,
+            "'")});
+}
+
+TEST_CASE("matcher all_within", "[utility]") {
+    using snitch::matchers::all_within_abs;
+    using snitch::matchers::all_within_rel;
+    using snitch::matchers::all_within_ulps;
+
+    // Large enough to use the block comparison, and not a multiple of the block size.
+    constexpr std::size_t size = 1000u;
+
+    std::vector<float> expected(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        expected[i] = static_cast<float>(i + 1u) * 0.5f;
+    }
+
+    std::vector<float> values = expected;
+
+    SECTION("equal") {
+        CHECK_THAT(values, all_within_abs(expected, 0.0f));
+        CHECK(values == all_within_abs(expected, 0.0f));
+        CHECK(values == all_within_rel(expected, 0.0f));
+        CHECK(values == all_within_ulps(expected, 0u));
+
+        CHECK(
+            all_within_ulps(expected, 0u).describe_match(
+                values, snitch::matchers::match_status::matched) ==
+            "all 1000 elements are within 0 ULPs"sv);
+    }
+
+    SECTION("within tolerance") {
+        for (auto& v : values) {
+            v = std::nextafter(v, 1e6f);
+        }
+
+        CHECK(values != all_within_ulps(expected, 0u));
+        CHECK(values == all_within_ulps(expected, 1u));
+        CHECK(values == all_within_abs(expected, 1e-3f));
+        CHECK(values == all_within_rel(expected, 1e-6f));
+    }
+
+    SECTION("different sizes") {
+        values.pop_back();
+
+        CHECK(values != all_within_abs(expected, 1.0f));
+        CHECK(
+            all_within_abs(expected, 1.0f).describe_match(
+                values, snitch::matchers::match_status::failed) ==
+            "range has 999 elements, expected 1000"sv);
+    }
+
+    SECTION("mismatches") {
+        for (std::size_t i : {3u, 64u, 127u, 128u, 500u, 998u, 999u}) {
+            values[i] += 1.0f;
+        }
+
+        CHECK(values != all_within_abs(expected, 0.5f));
+        CHECK(values == all_within_abs(expected, 1.0f));
+        CHECK(values != all_within_ulps(expected, 4u));
+
+        CHECK(
+            all_within_abs(expected, 0.5f).describe_match(
+                values, snitch::matchers::match_status::failed) ==
+            std::string_view{make_description(
+                "7 of 1000 elements are not within ", 0.5f, "; first 5 mismatches: [3] '",
+                values[3], "' vs '", expected[3], "', [64] '", values[64], "' vs '", expected[64],
+                "', [127] '", values[127], "' vs '", expected[127], "', [128] '", values[128],
+                "' vs '", expected[128], "', [500] '", values[500], "' vs '", expected[500], "'")});
+
+        CHECK(
+            all_within_abs(expected, 0.5f, 1u).describe_match(
+                values, snitch::matchers::match_status::failed) ==
+            std::string_view{make_description(
+                "7 of 1000 elements are not within ", 0.5f, "; first 1 mismatches: [3] '",
+                values[3], "' vs '", expected[3], "'")});
+
+        CHECK(
+            all_within_abs(expected, 0.5f, 0u).describe_match(
+                values, snitch::matchers::match_status::failed) ==
+            std::string_view{make_description("7 of 1000 elements are not within ", 0.5f)});
+    }
+
+    SECTION("nan") {
+        values[700] = std::numeric_limits<float>::quiet_NaN();
+
+        CHECK(values != all_within_abs(expected, 1e6f));
+        CHECK(values != all_within_rel(expected, 1e6f));
+        CHECK(values != all_within_ulps(expected, 1'000'000'000u));
+    }
+
+    SECTION("doubles") {
+        std::vector<double> expected_double(expected.begin(), expected.end());
+        std::vector<double> values_double = expected_double;
+        values_double[10] += 1e-12;
+
+        CHECK(values_double != all_within_abs(expected_double, 0.0));
+        CHECK(values_double == all_within_abs(expected_double, 1e-9));
+        CHECK(values_double == all_within_rel(expected_double, 1e-9));
+        CHECK(values_double != all_within_ulps(expected_double, 4u));
+        CHECK(values_double == all_within_ulps(expected_double, 1'000'000u));
+    }
+}
+
+namespace {
+enum class color { red, green, blue };
+
+struct point {
+    int x = 0;
+    int y = 0;
+
+    bool operator==(const point&) const = default;
+};
+} // namespace
+
+TEST_CASE("matcher range_equals", "[utility]") {
+    using snitch::matchers::range_equals;
+    using snitch::matchers::match_status;
+
+    SECTION("integers") {
+        // Large enough to use the block comparison, and not a multiple of the block size.
+        std::vector<int> expected(1000u);
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            expected[i] = static_cast<int>(i);
+        }
+
+        std::vector<int> values = expected;
+        CHECK(values == range_equals(expected));
+        CHECK(
+            range_equals(expected).describe_match(values, match_status::matched) ==
+            "all 1000 elements are equal"sv);
+
+        for (std::size_t i : {0u, 63u, 64u, 200u, 500u, 700u, 999u}) {
+            values[i] = -1;
+        }
+
+        CHECK(values != range_equals(expected));
+        CHECK(
+            range_equals(expected, 2u).describe_match(values, match_status::failed) ==
+            "7 of 1000 elements differ; first 2 mismatches: [0] '-1' vs '0', [63] '-1' vs '63'"sv);
+        CHECK(
+            range_equals(expected, 0u).describe_match(values, match_status::failed) ==
+            "7 of 1000 elements differ"sv);
+    }
+
+    SECTION("different sizes") {
+        const std::vector<int> expected = {1, 2, 3};
+        const std::vector<int> values   = {1, 2};
+
+        CHECK(values != range_equals(expected));
+        CHECK(
+            range_equals(expected).describe_match(values, match_status::failed) ==
+            "range has 2 elements, expected 3"sv);
+    }
+
+    SECTION("empty") {
+        const std::vector<int> expected;
+        const std::vector<int> values;
+
+        CHECK(values == range_equals(expected));
+    }
+
+    SECTION("different types") {
+        const std::array<long long, 3> expected = {1, 2, 3};
+        const std::vector<int>         values   = {1, 2, 3};
+        const std::list<int>           list     = {1, 2, 4};
+
+        CHECK(values == range_equals(expected));
+        CHECK(list != range_equals(expected));
+        CHECK(list != range_equals(values));
+        CHECK(
+            range_equals(values).describe_match(list, match_status::failed) ==
+            "1 of 3 elements differ; mismatches: [2] '4' vs '3'"sv);
+    }
+
+    SECTION("enums") {
+        const std::vector<color> expected = {color::red, color::green, color::blue};
+        std::vector<color>       values   = expected;
+
+        CHECK(values == range_equals(expected));
+        values[1] = color::red;
+        CHECK(values != range_equals(expected));
+    }
+
+    SECTION("floating point") {
+        // Not compared bitwise: +0 equals -0, and NaN is never equal.
+        const std::vector<double> expected = {0.0, 1.0, std::numeric_limits<double>::quiet_NaN()};
+        const std::vector<double> values   = {-0.0, 1.0, std::numeric_limits<double>::quiet_NaN()};
+
+        CHECK(values != range_equals(expected));
+        CHECK(std::vector<double>{-0.0, 1.0} == range_equals(std::vector<double>{0.0, 1.0}));
+    }
+
+    SECTION("not appendable") {
+        const std::vector<point> expected = {{1, 2}, {3, 4}};
+        const std::vector<point> values   = {{1, 2}, {3, 5}};
+
+        CHECK(values != range_equals(expected));
+        CHECK(
+            range_equals(expected).describe_match(values, match_status::failed) ==
+            "1 of 2 elements differ; mismatches: [1]"sv);
+    }
+
+    SECTION("constexpr") {
+        constexpr std::array<int, 3> expected = {1, 2, 3};
+        constexpr std::array<int, 3> values   = {1, 2, 3};
+        static_assert(range_equals(expected).match(values));
+        CHECK(values == range_equals(expected));
+    }
+}
@@ -0,0 +1,307 @@
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#if SNITCH_WITH_EXCEPTIONS
+#    include <stdexcept>
+#endif
+
+using namespace std::literals;
+
+namespace {
+std::string_view get_message(const snitch::assertion_data& data) {
+    if (const auto* message = std::get_if<std::string_view>(&data)) {
+        return *message;
+    }
+
+    return {};
+}
+
+std::size_t section_a_runs = 0u;
+std::size_t section_b_runs = 0u;
+} // namespace
+
+TEST_CASE("property rng", "[property]") {
+    SECTION("deterministic") {
+        snitch::property_rng rng1{42u};
+        snitch::property_rng rng2{42u};
+        for (std::size_t i = 0; i < 100u; ++i) {
+            CHECK(rng1.next() == rng2.next());
+        }
+    }
+
+    SECTION("below") {
+        snitch::property_rng rng{1u};
+        for (std::size_t i = 0; i < 1000u; ++i) {
+            CHECK(rng.below(7u) < 7u);
+        }
+    }
+
+    SECTION("unit") {
+        snitch::property_rng rng{1u};
+        for (std::size_t i = 0; i < 1000u; ++i) {
+            const double u = rng.unit();
+            CHECK(u >= 0.0);
+            CHECK(u < 1.0);
+        }
+    }
+}
+
+TEST_CASE("property generators", "[property]") {
+    snitch::property_rng rng{1u};
+
+    SECTION("int in range") {
+        const auto g = snitch::gen<int>(-5, 10);
+        for (std::size_t i = 0; i < 1000u; ++i) {
+            const int v = g.generate(rng, 100u);
+            CHECK(v >= -5);
+            CHECK(v <= 10);
+        }
+    }
+
+    SECTION("int shrink") {
+        const auto g = snitch::gen<int>();
+        CHECK(g.shrink(100, 0u) == 0);
+        CHECK(g.shrink(100, 1u) == 50);
+        CHECK(g.shrink(100, 2u) == 75);
+        CHECK(g.shrink(-100, 1u) == -50);
+        CHECK(g.shrink(1, 0u) == 0);
+        CHECK(!g.shrink(1, 1u).has_value());
+        CHECK(!g.shrink(0, 0u).has_value());
+    }
+
+    SECTION("int shrink positive range") {
+        const auto g = snitch::gen<int>(10, 20);
+        CHECK(g.shrink(15, 0u) == 10);
+        CHECK(!g.shrink(10, 0u).has_value());
+    }
+
+    SECTION("unsigned shrink") {
+        const auto g = snitch::gen<std::uint64_t>();
+        CHECK(g.shrink(std::numeric_limits<std::uint64_t>::max(), 0u) == 0u);
+        CHECK(g.shrink(4u, 1u) == 2u);
+    }
+
+    SECTION("float in range") {
+        const auto g = snitch::gen<float>(-1.0f, 1.0f);
+        for (std::size_t i = 0; i < 1000u; ++i) {
+            const float v = g.generate(rng, 100u);
+            CHECK(v >= -1.0f);
+            CHECK(v <= 1.0f);
+        }
+    }
+
+    SECTION("double shrink") {
+        const auto g = snitch::gen<double>();
+        CHECK(g.shrink(2.5, 0u) == 0.0);
+        CHECK(g.shrink(2.5, 1u) == 2.0);
+        CHECK(g.shrink(2.5, 2u) == 1.25);
+        CHECK(g.shrink(2.5, 3u) == 1.875);
+        CHECK(!g.shrink(2.5, 10u).has_value());
+        CHECK(g.shrink(2.0, 1u) == 1.0);
+        CHECK(!g.shrink(0.0, 0u).has_value());
+    }
+
+    SECTION("bool shrink") {
+        const auto g = snitch::gen<bool>();
+        CHECK(g.shrink(true, 0u) == false);
+        CHECK(!g.shrink(true, 1u).has_value());
+        CHECK(!g.shrink(false, 0u).has_value());
+    }
+
+    SECTION("vector length") {
+        const auto g = snitch::gen<std::vector<int>>(snitch::gen<int>(), 2u, 5u);
+        for (std::size_t i = 0; i < 1000u; ++i) {
+            const auto v = g.generate(rng, 100u);
+            CHECK(v.size() >= 2u);
+            CHECK(v.size() <= 5u);
+        }
+    }
+
+    SECTION("vector shrink") {
+        const auto             g     = snitch::gen<std::vector<int>>();
+        const std::vector<int> value = {1, 2, 3, 4};
+        // Remove all, then halves, then single elements.
+        CHECK(g.shrink(value, 0u) == std::vector<int>{});
+        CHECK(g.shrink(value, 1u) == std::vector<int>{3, 4});
+        CHECK(g.shrink(value, 2u) == std::vector<int>{1, 2});
+        CHECK(g.shrink(value, 3u) == std::vector<int>{2, 3, 4});
+        CHECK(g.shrink(value, 6u) == std::vector<int>{1, 2, 3});
+        // Then shrink elements.
+        CHECK(g.shrink(value, 7u) == std::vector<int>{0, 2, 3, 4});
+        CHECK(g.shrink(value, 8u) == std::vector<int>{1, 0, 3, 4});
+        CHECK(!g.shrink(std::vector<int>{}, 0u).has_value());
+    }
+
+    SECTION("vector shrink min size") {
+        const auto             g     = snitch::gen<std::vector<int>>(snitch::gen<int>(), 3u);
+        const std::vector<int> value = {1, 2, 3, 4};
+        CHECK(g.shrink(value, 0u) == std::vector<int>{2, 3, 4});
+        CHECK(g.shrink(value, 4u) == std::vector<int>{0, 2, 3, 4});
+    }
+}
+
+TEST_CASE("check property", "[property]") {
+    mock_framework framework;
+    framework.setup_reporter();
+    framework.catch_success = true;
+
+    SECTION("holds") {
+        framework.test_case.func = []() {
+            snitch::check_property(
+                [](int x) { SNITCH_CHECK(x + 1 > x - 1); }, snitch::gen<int>(-10, 10));
+        };
+
+        framework.run_test();
+        CHECK(framework.get_num_failures() == 0u);
+        auto success = framework.get_success_event();
+        REQUIRE(success.has_value());
+        CHECK(get_message(success->data).starts_with("property held for 100 run(s); seed: "sv));
+    }
+
+    SECTION("holds with config") {
+        framework.test_case.func = []() {
+            snitch::check_property(
+                {.runs = 10u, .seed = 42u}, [](bool) {}, snitch::gen<bool>());
+        };
+
+        framework.run_test();
+        CHECK(framework.get_num_failures() == 0u);
+        auto success = framework.get_success_event();
+        REQUIRE(success.has_value());
+        CHECK(get_message(success->data) == "property held for 10 run(s); seed: 42"sv);
+    }
+
+    SECTION("falsified int") {
+        framework.test_case.func = []() {
+            snitch::check_property([](int x) { SNITCH_CHECK(x < 10); }, snitch::gen<int>());
+        };
+
+        framework.run_test();
+        REQUIRE(framework.get_num_failures() == 2u);
+        auto failure = framework.get_failure_event(0u);
+        REQUIRE(failure.has_value());
+        CHECK(get_message(failure->data).starts_with("property falsified after "sv));
+        CHECK_CAPTURES_FOR_FAILURE(0u, "inputs := (10)");
+        CHECK_CAPTURES_FOR_FAILURE(1u, "inputs := (10)");
+    }
+
+    SECTION("falsified vector") {
+        framework.test_case.func = []() {
+            snitch::check_property(
+                [](int, const std::vector<int>& v) { SNITCH_CHECK(v.size() < 3u); },
+                snitch::gen<int>(), snitch::gen<std::vector<int>>());
+        };
+
+        framework.run_test();
+        REQUIRE(framework.get_num_failures() == 2u);
+        CHECK_CAPTURES_FOR_FAILURE(0u, "inputs := (0, {0, 0, 0})");
+    }
+
+    SECTION("falsified string") {
+        framework.test_case.func = []() {
+            snitch::check_property(
+                [](const std::string& s) { SNITCH_CHECK(s.find('a') == std::string::npos); },
+                snitch::gen<std::string>(snitch::gen<char>('a', 'z')));
+        };
+
+        framework.run_test();
+        REQUIRE(framework.get_num_failures() == 2u);
+        CHECK_CAPTURES_FOR_FAILURE(0u, "inputs := (a)");
+    }
+
+    SECTION("deterministic") {
+        framework.test_case.func = []() {
+            snitch::check_property([](int x) { SNITCH_CHECK(x % 7 != 3); }, snitch::gen<int>());
+        };
+
+        framework.run_test();
+        auto failure1 = framework.get_failure_event(0u);
+        REQUIRE(failure1.has_value());
+        const std::string message1{get_message(failure1->data)};
+
+        framework.events.clear();
+        framework.string_pool.clear();
+        framework.run_test();
+        auto failure2 = framework.get_failure_event(0u);
+        REQUIRE(failure2.has_value());
+        CHECK(get_message(failure2->data) == message1);
+    }
+
+    SECTION("sections") {
+        section_a_runs           = 0u;
+        section_b_runs           = 0u;
+        framework.test_case.func = []() {
+            snitch::check_property(
+                {.runs = 10u},
+                [](int) {
+                    SNITCH_SECTION("a") {
+                        ++section_a_runs;
+                    }
+                    SNITCH_SECTION("b") {
+                        ++section_b_runs;
+                    }
+                },
+                snitch::gen<int>());
+        };
+
+        framework.run_test();
+        CHECK(framework.get_num_failures() == 0u);
+        CHECK(section_a_runs == 10u);
+        CHECK(section_b_runs == 10u);
+        CHECK(framework.check_balanced_section_events());
+    }
+
+#if SNITCH_WITH_EXCEPTIONS
+    SECTION("require") {
+        framework.test_case.func = []() {
+            snitch::check_property([](int x) { SNITCH_REQUIRE(x < 5); }, snitch::gen<int>());
+        };
+
+        framework.run_test();
+        REQUIRE(framework.get_num_failures() == 2u);
+        CHECK_CAPTURES_FOR_FAILURE(0u, "inputs := (5)");
+    }
+
+    SECTION("exception") {
+        framework.test_case.func = []() {
+            snitch::check_property(
+                [](int x) {
+                    if (x > 3) {
+                        throw std::runtime_error("too large");
+                    }
+                },
+                snitch::gen<int>());
+        };
+
+        framework.run_test();
+        REQUIRE(framework.get_num_failures() == 2u);
+        CHECK_CAPTURES_FOR_FAILURE(0u, "inputs := (4)");
+    }
+#endif
+}
+
+TEST_CASE("add property", "[property]") {
+    mock_framework framework;
+
+    snitch::impl::property_registrar{
+        framework.registry, {"how many lights", "[tag]"}, SNITCH_CURRENT_LOCATION,
+        snitch::gen<int>(0, 3)} = [](int lights) { SNITCH_CHECK(lights != 4); };
+
+    REQUIRE(framework.get_num_registered_tests() == 1u);
+
+    auto& test = framework.registry.test_cases()[0];
+    CHECK(test.id.name == "how many lights"sv);
+    CHECK(test.id.tags == "[tag]"sv);
+
+    framework.setup_reporter();
+    framework.catch_success = true;
+    framework.registry.run(test);
+    CHECK(framework.get_num_failures() == 0u);
+    auto success = framework.get_success_event();
+    REQUIRE(success.has_value());
+    CHECK(get_message(success->data).starts_with("property held for 100 run(s)"sv));
+}
@@ -2,9 +2,13 @@
 #include "testing_assertions.hpp"
 #include "testing_event.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 using namespace std::literals;
 using snitch::matchers::contains_substring;
@@ -17,6 +21,8 @@ bool test_called_int       = false;
 bool test_called_float     = false;
 bool test_called_hidden1   = false;
 bool test_called_hidden2   = false;
+
+std::vector<std::string> run_order;
 } // namespace
 
 TEST_CASE("add regular test", "[registry]") {
@@ -735,6 +741,411 @@ TEST_CASE("configure verbosity", "[registry]") {
     }
 }
 
+TEST_CASE("configure flush", "[registry]") {
+    mock_framework framework;
+    register_tests(framework);
+    console_output_catcher console;
+
+    const auto previous_policy = snitch::impl::get_stdout_flush_policy();
+
+    SECTION("flush = line") {
+        const arg_vector args = {"test", "--flush", "line"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(snitch::impl::get_stdout_flush_policy() == snitch::impl::stdout_flush_policy::line);
+    }
+
+    SECTION("flush = test-case") {
+        const arg_vector args = {"test", "--flush", "test-case"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(
+            snitch::impl::get_stdout_flush_policy() ==
+            snitch::impl::stdout_flush_policy::test_case);
+    }
+
+    SECTION("flush = exit") {
+        const arg_vector args = {"test", "--flush", "exit"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(snitch::impl::get_stdout_flush_policy() == snitch::impl::stdout_flush_policy::exit);
+    }
+
+    SECTION("flush = bad") {
+        const arg_vector args = {"test", "--flush", "bad"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(snitch::impl::get_stdout_flush_policy() == previous_policy);
+        CHECK(console.messages == contains_substring("unknown flush policy"));
+    }
+
+    snitch::impl::set_stdout_flush_policy(previous_policy);
+}
+
+TEST_CASE("configure order", "[registry]") {
+    mock_framework framework;
+    for (std::string_view name : {"c", "a", "d", "b", "e", "f"}) {
+        framework.registry.add(
+            {name}, SNITCH_CURRENT_LOCATION,
+            []() { run_order.emplace_back(snitch::impl::get_current_test().test.id.name); });
+    }
+    console_output_catcher console;
+
+    const auto run = [&](std::initializer_list<const char*> options) {
+        arg_vector args = {"test"};
+        for (const char* option : options) {
+            args.push_back(option);
+        }
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        run_order.clear();
+        framework.registry.run_tests(*input);
+        return run_order;
+    };
+
+    SECTION("order = decl") {
+        CHECK(run({"--order", "decl"}) == std::vector<std::string>{"c", "a", "d", "b", "e", "f"});
+        CHECK(framework.registry.rng_seed == 0u);
+    }
+
+    SECTION("order = lex") {
+        CHECK(run({"--order", "lex"}) == std::vector<std::string>{"a", "b", "c", "d", "e", "f"});
+    }
+
+    SECTION("order = rand") {
+        const auto order1 = run({"--order", "rand", "--rng-seed", "42"});
+        CHECK(framework.registry.rng_seed == 42u);
+        CHECK(std::is_permutation(order1.begin(), order1.end(), run({}).begin()));
+        CHECK(run({"--order", "rand", "--rng-seed", "42"}) == order1);
+        CHECK(run({"--order", "rand", "--rng-seed", "43"}) != order1);
+    }
+
+    SECTION("order = rand filtered") {
+        // The relative order of the remaining tests does not change when some are filtered out.
+        auto order = run({"--order", "rand", "--rng-seed", "42"});
+        std::erase_if(order, [](const std::string& name) { return name == "a" || name == "b"; });
+        CHECK(run({"--order", "rand", "--rng-seed", "42", "c,d,e,f"}) == order);
+    }
+
+    SECTION("order = rand without seed") {
+        run({"--order", "rand"});
+        CHECK(framework.registry.rng_seed != 0u);
+        CHECK(console.messages == contains_substring("random seed: "));
+    }
+
+    SECTION("order = bad") {
+        run({"--order", "bad"});
+        CHECK(framework.registry.order == snitch::registry::test_order::declaration);
+        CHECK(console.messages == contains_substring("unknown test order"));
+    }
+
+    SECTION("rng seed = time") {
+        run({"--rng-seed", "time"});
+        CHECK(framework.registry.rng_seed != 0u);
+    }
+
+    SECTION("rng seed = bad") {
+        run({"--rng-seed", "18446744073709551616"});
+        CHECK(framework.registry.rng_seed == 0u);
+        CHECK(console.messages == contains_substring("invalid random seed"));
+    }
+}
+
+TEST_CASE("configure cache", "[registry]") {
+    mock_framework framework;
+    for (std::string_view name : {"pass 1", "fail 1", "pass 2", "fail 2"}) {
+        framework.registry.add({name}, SNITCH_CURRENT_LOCATION, []() {
+            const std::string_view test_name = snitch::impl::get_current_test().test.id.name;
+            run_order.emplace_back(test_name);
+            SNITCH_CHECK(test_name.starts_with("pass"));
+        });
+    }
+    console_output_catcher console;
+
+    const auto run = [&](std::initializer_list<const char*> options) {
+        arg_vector args = {"test", "--cache", "test_cache"};
+        for (const char* option : options) {
+            args.push_back(option);
+        }
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        run_order.clear();
+        framework.registry.run_tests(*input);
+        return run_order;
+    };
+
+    const auto all_tests = std::vector<std::string>{"pass 1", "fail 1", "pass 2", "fail 2"};
+
+    SECTION("record") {
+        CHECK(run({}) == all_tests);
+        CHECK(run({}) == all_tests);
+
+        std::vector<std::string> lines;
+        {
+            std::ifstream file("test_cache/test.snitch-cache");
+            for (std::string line; std::getline(file, line);) {
+                lines.push_back(line);
+            }
+        }
+
+        REQUIRE(lines.size() == 5u);
+        CHECK(lines[0].starts_with("snitch-cache 1 "));
+        CHECK(lines[1].starts_with("pass "));
+        CHECK(lines[1].ends_with(" pass 1"));
+        CHECK(lines[2].starts_with("fail "));
+        CHECK(lines[2].ends_with(" fail 1"));
+    }
+
+    SECTION("skip cached passes") {
+        CHECK(run({"pass 1"}) == std::vector<std::string>{"pass 1"});
+        CHECK(
+            run({"--skip-cached-passes"}) ==
+            std::vector<std::string>{"fail 1", "pass 2", "fail 2"});
+        CHECK(run({"--skip-cached-passes"}) == std::vector<std::string>{"fail 1", "fail 2"});
+    }
+
+    SECTION("only failed") {
+        CHECK(run({"fail 1,pass 1"}) == std::vector<std::string>{"pass 1", "fail 1"});
+        CHECK(run({"--only-failed"}) == std::vector<std::string>{"fail 1"});
+        // The results of the tests that were not run are kept.
+        CHECK(run({"--only-failed"}) == std::vector<std::string>{"fail 1"});
+    }
+
+    SECTION("only failed without failures") {
+        CHECK(run({"pass 1"}) == std::vector<std::string>{"pass 1"});
+        CHECK(run({"--only-failed"}) == std::vector<std::string>{"fail 1", "pass 2", "fail 2"});
+    }
+
+    SECTION("different build") {
+        CHECK(run({"--cache-key", "build 1"}) == all_tests);
+        CHECK(run({"--cache-key", "build 2", "--skip-cached-passes"}) == all_tests);
+        CHECK(
+            run({"--cache-key", "build 2", "--skip-cached-passes"}) ==
+            std::vector<std::string>{"fail 1", "fail 2"});
+    }
+
+    SECTION("without cache folder") {
+        const arg_vector args = {"test", "--skip-cached-passes"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(console.messages == contains_substring("please use --cache"));
+    }
+
+    std::filesystem::remove_all("test_cache");
+}
+
+TEST_CASE("configure retry", "[registry]") {
+    mock_framework framework;
+    for (std::string_view name : {"pass", "flaky", "fail"}) {
+        framework.registry.add({name}, SNITCH_CURRENT_LOCATION, []() {
+            const std::string_view test_name = snitch::impl::get_current_test().test.id.name;
+            const auto runs = std::count(run_order.begin(), run_order.end(), test_name);
+            run_order.emplace_back(test_name);
+            SNITCH_CHECK((test_name == "pass" || (test_name == "flaky" && runs >= 2)));
+        });
+    }
+    console_output_catcher console;
+
+    const auto run = [&](std::initializer_list<const char*> options) {
+        arg_vector args = {"test"};
+        for (const char* option : options) {
+            args.push_back(option);
+        }
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.setup_reporter();
+        run_order.clear();
+        framework.registry.run_tests(*input);
+        return run_order;
+    };
+
+    SECTION("no retry") {
+        CHECK(run({}) == std::vector<std::string>{"pass", "flaky", "fail"});
+#if SNITCH_WITH_EXCEPTIONS
+        CHECK_RUN(false, 3u, 2u, 0u, 0u, 6u, 2u, 0u);
+#else
+        CHECK_RUN(false, 3u, 2u, 0u, 0u, 3u, 2u, 0u);
+#endif
+    }
+
+    SECTION("retry = 1") {
+        CHECK(
+            run({"--retry", "1"}) ==
+            std::vector<std::string>{"pass", "flaky", "flaky", "fail", "fail"});
+#if SNITCH_WITH_EXCEPTIONS
+        CHECK_RUN(false, 3u, 2u, 0u, 0u, 10u, 4u, 0u);
+#else
+        CHECK_RUN(false, 3u, 2u, 0u, 0u, 5u, 4u, 0u);
+#endif
+    }
+
+    SECTION("retry = 3") {
+        CHECK(
+            run({"--retry", "3"}) ==
+            std::vector<std::string>{
+                "pass", "flaky", "flaky", "flaky", "fail", "fail", "fail", "fail"});
+#if SNITCH_WITH_EXCEPTIONS
+        CHECK_RUN(false, 3u, 1u, 0u, 0u, 16u, 6u, 0u);
+#else
+        CHECK_RUN(false, 3u, 1u, 0u, 0u, 8u, 6u, 0u);
+#endif
+
+        auto end = framework.get_event<owning_event::test_run_ended>(-1);
+        REQUIRE(end.has_value());
+        CHECK(end->flaky_count == 1u);
+
+        std::vector<std::size_t> retries;
+        for (const auto& e : framework.events) {
+            if (const auto* c = std::get_if<owning_event::test_case_ended>(&e)) {
+                retries.push_back(c->retries);
+            }
+        }
+        CHECK(retries == std::vector<std::size_t>{0u, 0u, 1u, 2u, 0u, 1u, 2u, 3u});
+
+        std::vector<bool> will_retry;
+        for (const auto& e : framework.events) {
+            if (const auto* c = std::get_if<owning_event::test_case_ended>(&e)) {
+                will_retry.push_back(c->will_retry);
+            }
+        }
+        CHECK(will_retry == std::vector<bool>{false, true, true, false, true, true, true, false});
+    }
+
+    SECTION("retry = bad") {
+        run({"--retry", "bad"});
+        CHECK(framework.registry.max_retries == 0u);
+        CHECK(console.messages == contains_substring("invalid number of retries"));
+    }
+}
+
+TEST_CASE("configure abort", "[registry]") {
+    mock_framework framework;
+    for (std::string_view name : {"fail 1", "pass 1", "fail 2", "sections"}) {
+        framework.registry.add({name}, SNITCH_CURRENT_LOCATION, []() {
+            const std::string_view test_name = snitch::impl::get_current_test().test.id.name;
+            if (test_name == "sections") {
+                SNITCH_SECTION("a") {
+                    run_order.emplace_back("sections a");
+                    SNITCH_FAIL_CHECK("fail");
+                }
+                SNITCH_SECTION("b") {
+                    run_order.emplace_back("sections b");
+                }
+                return;
+            }
+
+            run_order.emplace_back(test_name);
+            SNITCH_CHECK(test_name.starts_with("pass"));
+            SNITCH_CHECK(test_name.starts_with("pass"));
+        });
+    }
+    console_output_catcher console;
+
+    const auto run = [&](std::initializer_list<const char*> options) {
+        arg_vector args = {"test"};
+        for (const char* option : options) {
+            args.push_back(option);
+        }
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.setup_reporter();
+        run_order.clear();
+        framework.registry.run_tests(*input);
+        return run_order;
+    };
+
+    const auto is_aborted = [&]() {
+        auto end = framework.get_event<owning_event::test_run_ended>(-1);
+        return end.has_value() && end->aborted;
+    };
+
+    SECTION("no abort") {
+        CHECK(
+            run({}) ==
+            std::vector<std::string>{"fail 1", "pass 1", "fail 2", "sections a", "sections b"});
+        CHECK(!is_aborted());
+    }
+
+    SECTION("abort") {
+        // The test case with the first failure is run to completion.
+        CHECK(run({"--abort"}) == std::vector<std::string>{"fail 1"});
+        CHECK(framework.registry.abort_after == 1u);
+        CHECK(is_aborted());
+    }
+
+    SECTION("abortx") {
+        CHECK(run({"--abortx", "3"}) == std::vector<std::string>{"fail 1", "pass 1", "fail 2"});
+        CHECK(is_aborted());
+    }
+
+    SECTION("abortx between sections") {
+        CHECK(
+            run({"--abortx", "3", "sections,fail 1"}) ==
+            std::vector<std::string>{"fail 1", "sections a"});
+        CHECK(is_aborted());
+    }
+
+    SECTION("abortx not reached") {
+        CHECK(run({"--abortx", "6"}).size() == 5u);
+        CHECK(!is_aborted());
+    }
+
+    SECTION("abort with retry") {
+        // Only the failures of the last run of a test case are counted.
+        CHECK(
+            run({"--abort", "--retry", "2"}) ==
+            std::vector<std::string>{"fail 1", "fail 1", "fail 1"});
+        CHECK(is_aborted());
+    }
+
+    SECTION("abortx with retry") {
+        CHECK(
+            run({"--abortx", "4", "--retry", "1"}) ==
+            std::vector<std::string>{"fail 1", "fail 1", "pass 1", "fail 2", "fail 2"});
+        CHECK(is_aborted());
+    }
+
+    SECTION("abortx = bad") {
+        run({"--abortx", "0"});
+        CHECK(framework.registry.abort_after == 0u);
+        CHECK(console.messages == contains_substring("invalid number of failures"));
+    }
+}
+
+TEST_CASE("configure startup stats", "[registry]") {
+    mock_framework framework;
+    framework.registry.add({"test"}, SNITCH_CURRENT_LOCATION, []() {});
+    console_output_catcher console;
+
+    const arg_vector args = {"test", "--startup-stats"};
+    auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+    framework.registry.configure(*input);
+
+#if SNITCH_WITH_TIMINGS
+    CHECK(framework.registry.startup_stats);
+
+    framework.registry.run_tests(*input);
+    CHECK(console.messages == contains_substring("startup statistics:"));
+    CHECK(console.messages == contains_substring("configuration: "));
+    CHECK(console.messages == contains_substring("first test case: "));
+    CHECK(console.messages == contains_substring("total: "));
+
+    // Only printed by the console reporter.
+    console.messages.clear();
+    framework.setup_reporter();
+    framework.registry.run_tests(*input);
+    CHECK(console.messages != contains_substring("startup statistics:"));
+#else
+    CHECK(!framework.registry.startup_stats);
+    CHECK(console.messages == contains_substring("startup statistics require timings"));
+#endif
+}
+
 TEST_CASE("configure reporter", "[registry]") {
     mock_framework framework;
     register_tests(framework);
@@ -868,6 +1279,509 @@ TEST_CASE("configure output", "[registry]") {
 #endif
 }
 
+namespace {
+// Reporter counting the events it receives; 'verbose' reporters ask for test case events.
+template<bool Verbose>
+struct counting_reporter {
+    static inline std::size_t runs_started       = 0;
+    static inline std::size_t test_cases_started = 0;
+    static inline std::size_t finished           = 0;
+
+    std::size_t events = 0;
+
+    explicit counting_reporter(snitch::registry& r) noexcept {
+        if constexpr (Verbose) {
+            r.verbose = snitch::registry::verbosity::high;
+        }
+    }
+
+    bool configure(snitch::registry&, std::string_view, std::string_view) noexcept {
+        return false;
+    }
+
+    void report(const snitch::registry& r, const snitch::event::data& e) noexcept {
+        ++events;
+        if (std::holds_alternative<snitch::event::test_run_started>(e)) {
+            ++runs_started;
+        } else if (std::holds_alternative<snitch::event::test_case_started>(e)) {
+            ++test_cases_started;
+        } else if (std::holds_alternative<snitch::event::test_run_ended>(e)) {
+            r.print(Verbose ? "verbose" : "quiet", " reporter: ", events, " events\n");
+        }
+    }
+
+    ~counting_reporter() {
+        ++finished;
+    }
+
+    static void reset() noexcept {
+        runs_started       = 0;
+        test_cases_started = 0;
+        finished           = 0;
+    }
+};
+} // namespace
+
+TEST_CASE("configure multiple reporters", "[registry]") {
+    mock_framework framework;
+    register_tests(framework);
+    console_output_catcher console;
+
+    using quiet_reporter   = counting_reporter<false>;
+    using verbose_reporter = counting_reporter<true>;
+    framework.registry.add_reporter<quiet_reporter>("quiet");
+    framework.registry.add_reporter<verbose_reporter>("verbose");
+    quiet_reporter::reset();
+    verbose_reporter::reset();
+
+    SECTION("same output") {
+        const arg_vector args = {"test", "--reporter", "quiet", "--reporter", "verbose"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+
+        CHECK(quiet_reporter::runs_started == 1u);
+        CHECK(verbose_reporter::runs_started == 1u);
+        CHECK(quiet_reporter::test_cases_started == 0u);
+        CHECK(verbose_reporter::test_cases_started > 0u);
+        CHECK(quiet_reporter::finished == 1u);
+        CHECK(verbose_reporter::finished == 1u);
+
+        CHECK(console.messages == contains_substring("quiet reporter: "));
+        CHECK(console.messages == contains_substring("verbose reporter: "));
+    }
+
+    SECTION("separate outputs") {
+        const arg_vector args = {
+            "test", "--reporter", "quiet::out=test_output_quiet.txt", "--reporter", "verbose"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+
+        CHECK(console.messages != contains_substring("quiet reporter"));
+        CHECK(console.messages == contains_substring("verbose reporter: "));
+
+        std::string line;
+        {
+            std::ifstream file("test_output_quiet.txt");
+            std::getline(file, line);
+        }
+
+        CHECK(line == snitch::matchers::contains_substring{"quiet reporter: "});
+
+        std::filesystem::remove("test_output_quiet.txt");
+    }
+
+    SECTION("single reporter with output") {
+        const arg_vector args = {"test", "--reporter", "console::out=test_output.txt"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+
+        CHECK(console.messages.empty());
+
+        std::string line;
+        {
+            std::ifstream file("test_output.txt");
+            std::getline(file, line);
+        }
+
+        CHECK(line == snitch::matchers::contains_substring{"starting test with snitch"});
+
+        std::filesystem::remove("test_output.txt");
+    }
+
+    SECTION("too many reporters") {
+        arg_vector args = {"test"};
+        for (std::size_t i = 0; i <= snitch::max_active_reporters; ++i) {
+            args.push_back("--reporter");
+            args.push_back("quiet");
+        }
+
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(console.messages == contains_substring("too many reporters"));
+
+        framework.registry.run_tests(*input);
+
+        CHECK(quiet_reporter::runs_started == snitch::max_active_reporters);
+    }
+}
+
+namespace {
+// Reporter asking for test case events with high verbosity, but only interested in some of them.
+struct masked_reporter {
+    static constexpr snitch::event::mask event_mask =
+        snitch::event::mask_for<snitch::event::test_case_ended, snitch::event::assertion_failed>;
+
+    static inline std::size_t test_cases_ended = 0;
+    static inline std::size_t failures         = 0;
+    static inline std::size_t other_events     = 0;
+
+    explicit masked_reporter(snitch::registry& r) noexcept {
+        r.verbose = snitch::registry::verbosity::full;
+    }
+
+    bool configure(snitch::registry&, std::string_view, std::string_view) noexcept {
+        return false;
+    }
+
+    void report(const snitch::registry&, const snitch::event::data& e) noexcept {
+        if (std::holds_alternative<snitch::event::test_case_ended>(e)) {
+            ++test_cases_ended;
+        } else if (std::holds_alternative<snitch::event::assertion_failed>(e)) {
+            ++failures;
+        } else {
+            ++other_events;
+        }
+    }
+};
+} // namespace
+
+TEST_CASE("reporter event mask", "[registry]") {
+    mock_framework framework;
+    register_tests(framework);
+    console_output_catcher console;
+
+    masked_reporter::test_cases_ended = 0;
+    masked_reporter::failures         = 0;
+    masked_reporter::other_events     = 0;
+
+    framework.registry.add_reporter<masked_reporter>("masked");
+
+    std::size_t callback_events = 0;
+    auto count_events = [&](const snitch::registry&, const snitch::event::data&) noexcept {
+        ++callback_events;
+    };
+    framework.registry.add_reporter(
+        "callback", {}, {}, count_events, {},
+        snitch::event::mask_for<snitch::event::test_run_started>);
+
+    const auto reporters = framework.registry.reporters();
+    CHECK(reporters[0].events == snitch::event::all_events);
+    CHECK(reporters[1].events == masked_reporter::event_mask);
+    CHECK(reporters[2].events == snitch::event::mask_bit<snitch::event::test_run_started>);
+
+    SECTION("single reporter") {
+        const arg_vector args = {"test", "--reporter", "masked"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        CHECK(framework.registry.report_events == masked_reporter::event_mask);
+
+        framework.registry.run_tests(*input);
+
+        CHECK(masked_reporter::test_cases_ended > 0u);
+        CHECK(masked_reporter::failures > 0u);
+        CHECK(masked_reporter::other_events == 0u);
+    }
+
+    SECTION("multiple reporters") {
+        const arg_vector args = {"test", "--reporter", "masked", "--reporter", "callback"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        CHECK(
+            framework.registry.report_events ==
+            (masked_reporter::event_mask |
+             snitch::event::mask_for<snitch::event::test_run_started>));
+
+        framework.registry.run_tests(*input);
+
+        CHECK(masked_reporter::test_cases_ended > 0u);
+        CHECK(masked_reporter::failures > 0u);
+        CHECK(masked_reporter::other_events == 0u);
+        CHECK(callback_events == 1u);
+    }
+}
+
+#if SNITCH_WITH_TIMINGS
+TEST_CASE("configure profile", "[registry]") {
+    mock_framework framework;
+    framework.registry.add({"how many lights"}, SNITCH_CURRENT_LOCATION, []() {
+        SNITCH_SECTION("section 1") {
+            SNITCH_SECTION("section 1.1") {}
+            SNITCH_SECTION("section 1.2") {}
+        }
+        SNITCH_SECTION("section;2") {}
+    });
+    console_output_catcher console;
+
+    SECTION("collapsed stack") {
+        const arg_vector args = {"test", "--profile", "test_profile.txt"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+
+        CHECK(console.messages == contains_substring("all tests passed"));
+
+        std::vector<std::string> lines;
+        {
+            std::ifstream file("test_profile.txt");
+            for (std::string line; std::getline(file, line);) {
+                lines.push_back(line.substr(0, line.rfind(' ')));
+            }
+        }
+
+        std::filesystem::remove("test_profile.txt");
+
+        // Sections are aggregated over all runs, and listed in the order they are first exited.
+        REQUIRE(lines.size() == 5u);
+        CHECK(lines[0] == "how many lights");
+        CHECK(lines[1] == "how many lights;section 1;section 1.1");
+        CHECK(lines[2] == "how many lights;section 1");
+        CHECK(lines[3] == "how many lights;section 1;section 1.2");
+        CHECK(lines[4] == "how many lights;section:2");
+    }
+
+    SECTION("chrome trace") {
+        const arg_vector args = {"test", "--profile", "test_profile.json"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+
+        std::string content;
+        {
+            std::ifstream file("test_profile.json");
+            for (std::string line; std::getline(file, line);) {
+                content += line + "\n";
+            }
+        }
+
+        std::filesystem::remove("test_profile.json");
+
+        CHECK(content.starts_with("{\"traceEvents\":[\n"));
+        CHECK(content.ends_with("\n]}\n"));
+        CHECK(content == contains_substring("{\"name\":\"how many lights\",\"cat\":\"test\""));
+        CHECK(content == contains_substring("{\"name\":\"section 1\",\"cat\":\"section\""));
+        CHECK(content == contains_substring("{\"name\":\"section 1.2\",\"cat\":\"section\""));
+        CHECK(content == contains_substring("\"args\":{\"calls\":2}"));
+    }
+}
+#endif
+
+#if SNITCH_WITH_TIMINGS
+TEST_CASE("configure durations", "[registry]") {
+    mock_framework framework;
+    framework.registry.add({"how many lights"}, SNITCH_CURRENT_LOCATION, []() {
+        SNITCH_SECTION("section 1") {}
+    });
+    console_output_catcher console;
+
+    SECTION("durations yes") {
+        const arg_vector args = {"test", "--durations", "yes"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+
+        CHECK(console.messages == contains_substring(" s: how many lights\n"));
+        CHECK(console.messages == contains_substring("slowest test cases and sections:"));
+        CHECK(console.messages == contains_substring(" s: how many lights / section 1\n"));
+    }
+
+    SECTION("durations with another reporter") {
+        framework.setup_reporter();
+
+        const arg_vector args = {"test", "--durations", "yes"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+
+        CHECK(console.messages != contains_substring(" s: how many lights"));
+        CHECK(console.messages != contains_substring("slowest test cases and sections:"));
+    }
+
+    SECTION("durations no") {
+        const arg_vector args = {"test", "--durations", "no", "--min-duration", "0"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+
+        CHECK(console.messages != contains_substring(" s: how many lights"));
+        CHECK(console.messages != contains_substring("slowest test cases and sections:"));
+    }
+
+    SECTION("min duration") {
+        const arg_vector args = {"test", "--min-duration", "1000"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+
+        CHECK(console.messages == contains_substring("all tests passed"));
+        CHECK(console.messages != contains_substring(" s: how many lights"));
+        CHECK(console.messages != contains_substring("slowest test cases and sections:"));
+    }
+
+    SECTION("bad min duration") {
+        const arg_vector args = {"test", "--min-duration", "1.5s"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(console.messages == contains_substring("invalid minimum duration"));
+    }
+}
+
+TEST_CASE("durations of sections", "[registry]") {
+    mock_framework framework;
+    framework.registry.add({"how many lights"}, SNITCH_CURRENT_LOCATION, []() {
+        SNITCH_SECTION("parent") {
+            SNITCH_SECTION("child 1") {}
+            SNITCH_SECTION("child 2") {}
+        }
+    });
+    console_output_catcher console;
+
+    const arg_vector args = {"test", "--durations", "yes"};
+    auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+    framework.registry.configure(*input);
+    framework.registry.run_tests(*input);
+
+    const auto count = [&](std::string_view pattern) {
+        std::size_t      n       = 0u;
+        std::string_view message = console.messages;
+        for (auto pos = message.find(pattern); pos != message.npos;
+             pos      = message.find(pattern, pos + 1u)) {
+            ++n;
+        }
+        return n;
+    };
+
+    // The parent section is entered twice, but listed once.
+    CHECK(count(" s: how many lights / parent\n") == 1u);
+    CHECK(count(" s: how many lights / parent / child 1\n") == 1u);
+    CHECK(count(" s: how many lights / parent / child 2\n") == 1u);
+}
+
+TEST_CASE("duration tracker", "[registry]") {
+    snitch::impl::duration_tracker tracker;
+
+    SECTION("keeps the slowest") {
+        for (std::size_t i = 0; i < snitch::max_slowest_entries + 5u; ++i) {
+            // Interleave fast and slow entries.
+            const std::size_t duration = i % 2u == 0u ? i : 1000u - i;
+            CHECK(tracker.add("test", {}, duration));
+        }
+
+        const auto slowest = tracker.sort();
+        REQUIRE(slowest.size() == snitch::max_slowest_entries);
+        CHECK(slowest[0].duration == 999u);
+        for (std::size_t i = 1; i < slowest.size(); ++i) {
+            CHECK(slowest[i - 1].duration >= slowest[i].duration);
+        }
+    }
+
+    SECTION("threshold") {
+        tracker.min_duration = 500u;
+        CHECK(!tracker.add("fast", {}, 499u));
+        CHECK(tracker.add("slow", {}, 500u));
+
+        const auto slowest = tracker.sort();
+        REQUIRE(slowest.size() == 1u);
+        CHECK(slowest[0].name.str() == "slow"sv);
+    }
+
+    SECTION("parse seconds") {
+        CHECK(snitch::impl::parse_seconds("1").value_or(0u) == 1'000'000'000u);
+        CHECK(snitch::impl::parse_seconds("0.25").value_or(0u) == 250'000'000u);
+        CHECK(snitch::impl::parse_seconds(".5").value_or(0u) == 500'000'000u);
+        CHECK(!snitch::impl::parse_seconds("").has_value());
+        CHECK(!snitch::impl::parse_seconds(".").has_value());
+        CHECK(!snitch::impl::parse_seconds("-1").has_value());
+        CHECK(!snitch::impl::parse_seconds("1e3").has_value());
+    }
+}
+#endif
+
+#if SNITCH_WITH_PERF_COUNTERS
+TEST_CASE("perf counters", "[registry]") {
+    SECTION("delta") {
+        const snitch::perf_counters start = {.instructions = 10u, .cycles = 20u, .cache_misses = 5u};
+        const snitch::perf_counters end   = {.instructions = 15u, .cycles = 40u};
+
+        const auto delta = snitch::impl::get_perf_counters_delta(start, end);
+        CHECK(delta.instructions.value_or(0u) == 5u);
+        CHECK(delta.cycles.value_or(0u) == 20u);
+        CHECK(!delta.cache_misses.has_value());
+        CHECK(!delta.branch_misses.has_value());
+    }
+
+    SECTION("test case ended") {
+        mock_framework framework;
+        framework.registry.add({"how many lights"}, SNITCH_CURRENT_LOCATION, []() {
+            volatile std::size_t sum = 0;
+            for (std::size_t i = 0; i < 1000u; ++i) {
+                sum = sum + i;
+            }
+        });
+
+        framework.setup_reporter();
+        framework.registry.run(framework.registry.test_cases()[0]);
+
+        // Counters may not be available (e.g., in a virtual machine, or if not permitted);
+        // this is not an error, but if they are available they must have counted something.
+        auto event = framework.get_event<owning_event::test_case_ended>(1u);
+        REQUIRE(event.has_value());
+        if (event->counters.instructions.has_value()) {
+            CHECK(event->counters.instructions.value() > 1000u);
+        }
+    }
+}
+#endif
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+TEST_CASE("allocation tracking", "[registry]") {
+    SECTION("scope") {
+        // Call the allocation functions directly; allocations from new-expressions may be elided.
+        const snitch::impl::allocation_scope scope;
+
+        void* ptr1 = ::operator new(16u);
+        void* ptr2 = ::operator new(32u);
+        ::operator delete(ptr1);
+        ::operator delete(ptr2);
+        void* ptr3 = ::operator new(8u, std::align_val_t{64u});
+        ::operator delete(ptr3, std::align_val_t{64u});
+
+        const snitch::allocation_stats stats = scope.stop();
+        CHECK(stats.count == 3u);
+        CHECK(stats.bytes == 56u);
+        CHECK(stats.peak == 48u);
+    }
+
+    SECTION("test case ended") {
+        mock_framework framework;
+        framework.registry.add({"how many lights"}, SNITCH_CURRENT_LOCATION, []() {
+            ::operator delete(::operator new(100u));
+        });
+
+        framework.setup_reporter();
+        framework.registry.run(framework.registry.test_cases()[0]);
+
+        auto event = framework.get_event<owning_event::test_case_ended>(1u);
+        REQUIRE(event.has_value());
+        CHECK(event->allocations.count == 1u);
+        CHECK(event->allocations.bytes == 100u);
+        CHECK(event->allocations.peak == 100u);
+    }
+
+    SECTION("require aborts test") {
+        mock_framework framework;
+        test_called = false;
+        framework.registry.add({"how many lights"}, SNITCH_CURRENT_LOCATION, []() {
+            SNITCH_REQUIRE_NO_ALLOCATIONS {
+                ::operator delete(::operator new(4u));
+            }
+            test_called = true;
+        });
+
+        framework.setup_reporter();
+        framework.registry.run(framework.registry.test_cases()[0]);
+
+        CHECK(!test_called);
+        CHECK(framework.get_num_failures() == 1u);
+        CHECK_CASE(snitch::test_case_state::failed, 1u, 1u);
+    }
+}
+#endif
+
 TEST_CASE("run tests cli", "[registry][cli]") {
     mock_framework framework;
     framework.setup_reporter();
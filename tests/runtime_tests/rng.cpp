@@ -0,0 +1,89 @@
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+std::vector<std::uint64_t> drawn;
+} // namespace
+
+TEST_CASE("rng engine", "[rng]") {
+    SECTION("deterministic") {
+        snitch::rng_engine rng1{42u};
+        snitch::rng_engine rng2{42u};
+        for (std::size_t i = 0; i < 100u; ++i) {
+            CHECK(rng1() == rng2());
+        }
+    }
+
+    SECTION("seed") {
+        snitch::rng_engine rng{42u};
+        const auto         first = rng();
+        rng();
+        rng.seed(42u);
+        CHECK(rng() == first);
+        CHECK(snitch::rng_engine{43u}() != first);
+    }
+
+    SECTION("zero seed") {
+        snitch::rng_engine rng{0u};
+        CHECK(rng() != rng());
+    }
+
+    SECTION("standard library") {
+        snitch::rng_engine                 rng{1u};
+        std::uniform_int_distribution<int> dist(1, 6);
+        for (std::size_t i = 0; i < 1000u; ++i) {
+            const int v = dist(rng);
+            CHECK(v >= 1);
+            CHECK(v <= 6);
+        }
+
+        std::vector<int> values(10u);
+        std::iota(values.begin(), values.end(), 0);
+        std::shuffle(values.begin(), values.end(), rng);
+        const std::vector<int> sorted = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        CHECK(std::is_permutation(values.begin(), values.end(), sorted.begin()));
+    }
+}
+
+TEST_CASE("test rng", "[rng]") {
+    mock_framework framework;
+
+    SECTION("reseeded for each section") {
+        framework.test_case.func = []() {
+            SNITCH_SECTION("a") {
+                drawn.push_back(snitch::rng()());
+            }
+            SNITCH_SECTION("b") {
+                drawn.push_back(snitch::rng()());
+            }
+        };
+
+        drawn.clear();
+        framework.run_test();
+        REQUIRE(drawn.size() == 2u);
+        CHECK(drawn[0] == drawn[1]);
+    }
+
+    SECTION("depends on the name and the run seed") {
+        framework.test_case.func = []() { drawn.push_back(snitch::rng()()); };
+
+        drawn.clear();
+        framework.run_test();
+        framework.run_test();
+        framework.registry.rng_seed = 1u;
+        framework.run_test();
+        framework.test_case.id.name = "other test";
+        framework.run_test();
+
+        REQUIRE(drawn.size() == 4u);
+        CHECK(drawn[0] == drawn[1]);
+        CHECK(drawn[1] != drawn[2]);
+        CHECK(drawn[2] != drawn[3]);
+    }
+}
@@ -1,7 +1,10 @@
 #include "testing.hpp"
 #include "testing_assertions.hpp"
 
+#include <bit>
 #include <cmath>
+#include <cstdlib>
+#include <string>
 
 using namespace std::literals;
 
@@ -323,6 +326,32 @@ TEST_CASE("append ints", "[utility]") {
         CONSTEXPR_CHECK(a(12345678u) == ae{"12345"sv, false});
     }
 
+    SECTION("number of digits") {
+        // Check both sides of each power of ten.
+        constexpr auto powers_of_ten_ok = []() constexpr {
+            snitch::large_uint_t power = 10u;
+            for (std::size_t n = 1u; n < snitch::impl::max_uint_length; ++n, power *= 10u) {
+                if (snitch::impl::num_digits(power - 1u) != n ||
+                    snitch::impl::num_digits(power) != n + 1u) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        CONSTEXPR_CHECK(snitch::impl::num_digits(0u) == 1u);
+        CONSTEXPR_CHECK(snitch::impl::num_digits(0) == 1u);
+        CONSTEXPR_CHECK(snitch::impl::num_digits(-1) == 2u);
+        CONSTEXPR_CHECK(snitch::impl::num_digits(-100) == 4u);
+        CONSTEXPR_CHECK(powers_of_ten_ok());
+        CONSTEXPR_CHECK(
+            snitch::impl::num_digits(std::numeric_limits<snitch::large_uint_t>::max()) ==
+            snitch::impl::max_uint_length);
+        CONSTEXPR_CHECK(snitch::impl::num_digits(std::numeric_limits<std::int64_t>::min()) == 20u);
+        CONSTEXPR_CHECK(snitch::impl::num_digits<16>(255u) == 2u);
+        CONSTEXPR_CHECK(snitch::impl::num_digits<16>(256u) == 3u);
+    }
+
     SECTION("enums do fit") {
         constexpr auto a = [](const auto& value) constexpr {
             return append_test::to_string<21, false>(value);
@@ -342,6 +371,7 @@ TEST_CASE("append ints", "[utility]") {
     }
 }
 
+#if !SNITCH_SHORTEST_FLOAT_FORMAT
 TEST_CASE("append floats", "[utility]") {
     using ae = append_test::append_expected;
 #if !SNITCH_CONSTEXPR_FLOAT_USE_BITCAST && SNITCH_APPEND_TO_CHARS
@@ -553,6 +583,99 @@ TEST_CASE("append doubles", "[utility]") {
         CONSTEXPR_CHECK(a(-1.0) == ae{"-1.00"sv, false});
     }
 }
+#endif
+
+namespace append_test {
+template<std::size_t N, typename T>
+constexpr append_result2<N> to_string_shortest(T value) {
+    if (std::is_constant_evaluated()) {
+        snitch::small_string<N> str;
+        bool                    success = snitch::impl::append_constexpr_shortest(str, value);
+        return {{{str, success}}, {}};
+    } else {
+        snitch::small_string<N> str1, str2;
+        bool                    success1 = snitch::impl::append_fast_shortest(str1, value);
+        bool                    success2 = snitch::impl::append_constexpr_shortest(str2, value);
+        return {{{str2, success2}}, {{str1, success1}}};
+    }
+}
+} // namespace append_test
+
+TEST_CASE("append floats shortest", "[utility]") {
+    using ae = append_test::append_expected;
+
+    SECTION("floats do fit") {
+        constexpr auto a = [](float value) constexpr {
+            return append_test::to_string_shortest<21>(value);
+        };
+
+        CONSTEXPR_CHECK(a(0.0f) == ae{"0e+00"sv, true});
+        CONSTEXPR_CHECK(a(1.0f) == ae{"1e+00"sv, true});
+        CONSTEXPR_CHECK(a(-1.0f) == ae{"-1e+00"sv, true});
+        CONSTEXPR_CHECK(a(1.5f) == ae{"1.5e+00"sv, true});
+        CONSTEXPR_CHECK(a(0.1f) == ae{"1e-01"sv, true});
+        CONSTEXPR_CHECK(a(0.3f) == ae{"3e-01"sv, true});
+        CONSTEXPR_CHECK(a(1.0000001f) == ae{"1.0000001e+00"sv, true});
+        CONSTEXPR_CHECK(a(1e10f) == ae{"1e+10"sv, true});
+        CONSTEXPR_CHECK(a(16777216.0f) == ae{"1.6777216e+07"sv, true});
+        // Exactly half-way between two 9-digit candidates, the even one is picked.
+        CONSTEXPR_CHECK(a(7.038531e-26f) == ae{"7.038531e-26"sv, true});
+        CONSTEXPR_CHECK(a(std::numeric_limits<float>::max()) == ae{"3.4028235e+38"sv, true});
+        CONSTEXPR_CHECK(a(std::numeric_limits<float>::min()) == ae{"1.1754944e-38"sv, true});
+        CONSTEXPR_CHECK(a(std::numeric_limits<float>::denorm_min()) == ae{"1e-45"sv, true});
+        CONSTEXPR_CHECK(a(std::numeric_limits<float>::infinity()) == ae{"inf"sv, true});
+        CONSTEXPR_CHECK(a(-std::numeric_limits<float>::infinity()) == ae{"-inf"sv, true});
+        CONSTEXPR_CHECK(a(std::numeric_limits<float>::quiet_NaN()) == ae{"nan"sv, true});
+    }
+
+    SECTION("doubles do fit") {
+        constexpr auto a = [](double value) constexpr {
+            return append_test::to_string_shortest<35>(value);
+        };
+
+        CONSTEXPR_CHECK(a(0.0) == ae{"0e+00"sv, true});
+        CONSTEXPR_CHECK(a(0.1) == ae{"1e-01"sv, true});
+        CONSTEXPR_CHECK(a(0.1 + 0.2) == ae{"3.0000000000000004e-01"sv, true});
+        CONSTEXPR_CHECK(a(123456789.0) == ae{"1.23456789e+08"sv, true});
+        CONSTEXPR_CHECK(a(1e23) == ae{"1e+23"sv, true});
+        CONSTEXPR_CHECK(a(9007199254740993.0) == ae{"9.007199254740992e+15"sv, true});
+        // Start of a binade, where the gap to the previous value is halved.
+        CONSTEXPR_CHECK(a(9.5367431640625e-07) == ae{"9.5367431640625e-07"sv, true});
+        CONSTEXPR_CHECK(
+            a(std::numeric_limits<double>::max()) == ae{"1.7976931348623157e+308"sv, true});
+        CONSTEXPR_CHECK(
+            a(std::numeric_limits<double>::min()) == ae{"2.2250738585072014e-308"sv, true});
+        CONSTEXPR_CHECK(a(std::numeric_limits<double>::denorm_min()) == ae{"5e-324"sv, true});
+    }
+
+    SECTION("doubles don't fit") {
+        constexpr auto a = [](double value) constexpr {
+            return append_test::to_string_shortest<5>(value);
+        };
+
+        CONSTEXPR_CHECK(a(0.0) == ae{"0e+00"sv, true});
+        CONSTEXPR_CHECK(a(1.5) == ae{"1.5e+"sv, false});
+    }
+
+    SECTION("round trip") {
+        // Random bit patterns; the printed number must read back to the same value.
+        std::uint64_t state = 88172645463325252ull;
+        for (std::size_t i = 0; i < 10000u; ++i) {
+            state ^= state << 13u;
+            state ^= state >> 7u;
+            state ^= state << 17u;
+
+            const double value = std::bit_cast<double>(state);
+            if (!std::isfinite(value)) {
+                continue;
+            }
+
+            snitch::small_string<snitch::impl::max_float_length> str;
+            REQUIRE(snitch::impl::append_constexpr_shortest(str, value));
+            CHECK(std::strtod(std::string(std::string_view(str)).c_str(), nullptr) == value);
+        }
+    }
+}
 
 TEST_CASE("append multiple", "[utility]") {
     string_type s;
@@ -862,6 +985,21 @@ TEST_CASE("escape_all_or_truncate", "[utility]") {
 #endif
 }
 
+TEST_CASE("escape_json_or_truncate", "[utility]") {
+    const auto escape = [](std::string_view str) {
+        snitch::small_string<32> out;
+        append_or_truncate(out, str);
+        const bool success = escape_json_or_truncate(out);
+        return std::pair<std::string, bool>{std::string(out.str()), success};
+    };
+
+    CHECK(escape("abc") == std::pair<std::string, bool>{"abc", true});
+    CHECK(escape("a\"b\\c") == std::pair<std::string, bool>{"a\\\"b\\\\c", true});
+    CHECK(escape("a\tb\nc\r") == std::pair<std::string, bool>{"a\\tb\\nc\\r", true});
+    CHECK(escape("\x01\x1f") == std::pair<std::string, bool>{"\\u0001\\u001f", true});
+    CHECK(escape("\x01\x01\x01\x01\x01\x01").second == false);
+}
+
 TEST_CASE("is_match", "[utility]") {
     SECTION("empty") {
         CHECK(snitch::is_match(""sv, ""sv));
@@ -1149,3 +1287,13 @@ TEST_CASE("is_filter_match_id", "[utility]") {
     CHECK(is_filter_match_id("abc"sv, "[tag1][tag2]"sv, "ab*,"sv) == EI);
     CHECK(is_filter_match_id(""sv, "[tag1][tag2]"sv, "ab*,"sv) == EI);
 }
+
+TEST_CASE("parse_unsigned", "[utility]") {
+    CHECK(snitch::parse_unsigned("0") == 0u);
+    CHECK(snitch::parse_unsigned("42") == 42u);
+    CHECK(snitch::parse_unsigned("18446744073709551615") == 18446744073709551615u);
+    CHECK(!snitch::parse_unsigned("18446744073709551616").has_value());
+    CHECK(!snitch::parse_unsigned("").has_value());
+    CHECK(!snitch::parse_unsigned("-1").has_value());
+    CHECK(!snitch::parse_unsigned("12a").has_value());
+}
@@ -0,0 +1,160 @@
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#if SNITCH_WITH_MULTITHREADING && (defined(__unix__) || defined(__APPLE__))
+#    include <fcntl.h>
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
+
+using namespace std::literals;
+
+namespace {
+std::atomic<std::uint64_t> timed_out_ms = 0u;
+
+void record_timeout(const snitch::impl::test_state&, std::uint64_t timeout_ms) noexcept {
+    timed_out_ms = timeout_ms;
+}
+} // namespace
+
+TEST_CASE("parse timeout", "[watchdog]") {
+    CHECK(snitch::impl::parse_timeout("5") == 5000u);
+    CHECK(snitch::impl::parse_timeout("5s") == 5000u);
+    CHECK(snitch::impl::parse_timeout("250ms") == 250u);
+    CHECK(!snitch::impl::parse_timeout("").has_value());
+    CHECK(!snitch::impl::parse_timeout("s").has_value());
+    CHECK(!snitch::impl::parse_timeout("0s").has_value());
+    CHECK(!snitch::impl::parse_timeout("-1").has_value());
+    CHECK(!snitch::impl::parse_timeout("1.5s").has_value());
+    CHECK(!snitch::impl::parse_timeout("5min").has_value());
+    CHECK(!snitch::impl::parse_timeout("99999999999999999999").has_value());
+}
+
+#if SNITCH_WITH_MULTITHREADING
+TEST_CASE("watchdog", "[watchdog]") {
+    mock_framework           framework;
+    snitch::impl::test_state state{.reg = framework.registry, .test = framework.test_case};
+
+    timed_out_ms = 0u;
+
+    SECTION("expired") {
+        snitch::impl::watch_test(state, 10u, &record_timeout);
+        for (std::size_t i = 0; i < 500u && timed_out_ms == 0u; ++i) {
+            std::this_thread::sleep_for(10ms);
+        }
+        snitch::impl::unwatch_test();
+
+        CHECK(timed_out_ms == 10u);
+    }
+
+    SECTION("not expired") {
+        snitch::impl::watch_test(state, 50u, &record_timeout);
+        snitch::impl::unwatch_test();
+        std::this_thread::sleep_for(100ms);
+
+        CHECK(timed_out_ms == 0u);
+    }
+
+    SECTION("replaced") {
+        snitch::impl::watch_test(state, 50u, &record_timeout);
+        snitch::impl::watch_test(state, 60'000u, &record_timeout);
+        std::this_thread::sleep_for(100ms);
+        snitch::impl::unwatch_test();
+
+        CHECK(timed_out_ms == 0u);
+    }
+}
+#endif
+
+TEST_CASE("configure test timeout", "[watchdog]") {
+    mock_framework         framework;
+    console_output_catcher console;
+
+    const auto configure = [&](const char* value) {
+        const arg_vector args = {"test", "--test-timeout", value};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+    };
+
+#if SNITCH_WITH_MULTITHREADING
+    SECTION("valid") {
+        configure("2s");
+        CHECK(framework.registry.test_timeout_ms == 2000u);
+        CHECK(console.messages.empty());
+    }
+
+    SECTION("invalid") {
+        configure("bad");
+        CHECK(framework.registry.test_timeout_ms == 0u);
+        CHECK(console.messages == snitch::matchers::contains_substring("invalid test timeout"));
+    }
+
+    SECTION("tag") {
+        // A test case faster than its timeout runs normally.
+        framework.test_case.id.tags = "[!timeout=60s]";
+        framework.test_case.func    = []() { SNITCH_CHECK(true); };
+        framework.run_test();
+        CHECK(framework.test_case.state == snitch::impl::test_case_state::success);
+    }
+#else
+    configure("2s");
+    CHECK(framework.registry.test_timeout_ms == 0u);
+    CHECK(console.messages == snitch::matchers::contains_substring("require multithreading"));
+#endif
+}
+
+#if SNITCH_WITH_MULTITHREADING && (defined(__unix__) || defined(__APPLE__))
+TEST_CASE("report timeout", "[watchdog]") {
+    // The timed out test case is sent to the reporters, which complete their output before the
+    // test application is terminated.
+    constexpr const char* path = "test_timeout.txt";
+
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        const int null = ::open("/dev/null", O_WRONLY);
+        ::dup2(null, STDOUT_FILENO);
+        ::dup2(null, STDERR_FILENO);
+
+        mock_framework framework;
+        framework.registry.add({"stuck"}, SNITCH_CURRENT_LOCATION, []() {
+            SNITCH_SECTION("section") {
+                // Done by 'check_timeout()' otherwise, once flagged by the watchdog thread; the
+                // thread does not survive fork(), so it cannot be used here.
+                auto& state = snitch::impl::get_current_test();
+                state.reg.end_timed_out_run(state, 50u, "timed out after 50ms");
+                snitch::terminate_with("timed out");
+            }
+        });
+
+        const arg_vector args = {"test", "--out", path};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+        framework.registry.run_tests(*input);
+        std::_Exit(0);
+    }
+
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    CHECK(WIFSIGNALED(status));
+
+    std::ifstream     file(path);
+    const std::string content{
+        std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    CHECK(content == snitch::matchers::contains_substring("timed out after 50ms"));
+    CHECK(content == snitch::matchers::contains_substring("1 out of 1 test cases"));
+    CHECK(content == snitch::matchers::contains_substring("aborted"));
+
+    file.close();
+    std::filesystem::remove(path);
+}
+#endif
@@ -109,8 +109,9 @@ owning_event::data deep_copy(snitch::small_string_span pool, const snitch::event
                 copy_test_case_id(pool, c, a);
                 copy_assertion_location(pool, c, a);
                 copy_assertion_data(pool, c, a);
-                c.allowed  = a.allowed;
-                c.expected = a.expected;
+                c.allowed   = a.allowed;
+                c.expected  = a.expected;
+                c.may_retry = a.may_retry;
                 return c;
             },
             [&](const snitch::event::assertion_succeeded& a) -> owning_event::data {
@@ -124,6 +125,7 @@ owning_event::data deep_copy(snitch::small_string_span pool, const snitch::event
                 owning_event::test_case_started c;
                 copy_test_case_id(pool, c, s);
                 copy_location(pool, c, s);
+                c.retries = s.retries;
                 return c;
             },
             [&](const snitch::event::test_case_ended& s) -> owning_event::data {
@@ -134,8 +136,16 @@ owning_event::data deep_copy(snitch::small_string_span pool, const snitch::event
                 c.assertion_failure_count         = s.assertion_failure_count;
                 c.allowed_assertion_failure_count = s.allowed_assertion_failure_count;
                 c.state                           = s.state;
+                c.retries                         = s.retries;
+                c.will_retry                      = s.will_retry;
 #if SNITCH_WITH_TIMINGS
                 c.duration = s.duration;
+#endif
+#if SNITCH_WITH_PERF_COUNTERS
+                c.counters = s.counters;
+#endif
+#if SNITCH_WITH_ALLOCATION_TRACKING
+                c.allocations = s.allocations;
 #endif
                 c.failure_expected = s.failure_expected;
                 c.failure_allowed  = s.failure_allowed;
@@ -165,6 +175,7 @@ owning_event::data deep_copy(snitch::small_string_span pool, const snitch::event
             [&](const snitch::event::test_run_started& s) -> owning_event::data {
                 owning_event::test_run_started c;
                 copy_test_run_id(pool, c, s);
+                c.rng_seed = s.rng_seed;
                 return c;
             },
             [&](const snitch::event::test_run_ended& s) -> owning_event::data {
@@ -174,6 +185,7 @@ owning_event::data deep_copy(snitch::small_string_span pool, const snitch::event
                 c.fail_count                      = s.fail_count;
                 c.allowed_fail_count              = s.allowed_fail_count;
                 c.skip_count                      = s.skip_count;
+                c.flaky_count                     = s.flaky_count;
                 c.assertion_count                 = s.assertion_count;
                 c.assertion_failure_count         = s.assertion_failure_count;
                 c.allowed_assertion_failure_count = s.allowed_assertion_failure_count;
@@ -181,6 +193,7 @@ owning_event::data deep_copy(snitch::small_string_span pool, const snitch::event
                 c.duration = s.duration;
 #endif
                 c.success = s.success;
+                c.aborted = s.aborted;
                 return c;
             },
             [&](const snitch::event::test_case_skipped& s) -> owning_event::data {
@@ -6,8 +6,9 @@ using section_info = snitch::small_vector<snitch::section, snitch::max_nested_se
 using capture_info = snitch::small_vector<std::string_view, snitch::max_captures>;
 
 struct test_run_started {
-    std::string_view name    = {};
-    filter_info      filters = {};
+    std::string_view name     = {};
+    filter_info      filters  = {};
+    std::uint64_t    rng_seed = 0u;
 };
 
 struct test_run_ended {
@@ -18,6 +19,7 @@ struct test_run_ended {
     std::size_t fail_count         = 0;
     std::size_t allowed_fail_count = 0;
     std::size_t skip_count         = 0;
+    std::size_t flaky_count        = 0;
 
     std::size_t assertion_count                 = 0;
     std::size_t assertion_failure_count         = 0;
@@ -28,11 +30,14 @@ struct test_run_ended {
 #endif
 
     bool success = true;
+    bool aborted = false;
 };
 
 struct test_case_started {
     snitch::test_id         id       = {};
     snitch::source_location location = {};
+
+    std::size_t retries = 0;
 };
 
 struct test_case_ended {
@@ -43,12 +48,22 @@ struct test_case_ended {
     std::size_t assertion_failure_count         = 0;
     std::size_t allowed_assertion_failure_count = 0;
 
-    snitch::test_case_state state = snitch::test_case_state::success;
+    snitch::test_case_state state      = snitch::test_case_state::success;
+    std::size_t             retries    = 0;
+    bool                    will_retry = false;
 
 #if SNITCH_WITH_TIMINGS
     float duration = 0.0f;
 #endif
 
+#if SNITCH_WITH_PERF_COUNTERS
+    snitch::perf_counters counters = {};
+#endif
+
+#if SNITCH_WITH_ALLOCATION_TRACKING
+    snitch::allocation_stats allocations = {};
+#endif
+
     bool failure_expected = false;
     bool failure_allowed  = false;
 };
@@ -76,8 +91,9 @@ struct assertion_failed {
     capture_info            captures = {};
     snitch::source_location location = {};
     snitch::assertion_data  data     = {};
-    bool                    expected = false;
-    bool                    allowed  = false;
+    bool                    expected  = false;
+    bool                    allowed   = false;
+    bool                    may_retry = false;
 };
 
 struct assertion_succeeded {
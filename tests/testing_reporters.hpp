@@ -22,15 +22,8 @@ struct print_to_file {
 void regex_blank(std::string& line, const std::regex& ignores);
 void regex_blank(std::string& line, const std::vector<std::regex>& ignores);
 
-#define CHECK_FOR_DIFFERENCES(ARGS, IGNORES, FILENAME)                                             \
+#define CHECK_FILE_FOR_DIFFERENCES(IGNORES, FILENAME, EXPECTED_FILENAME)                           \
     do {                                                                                           \
-        {                                                                                          \
-            print_to_file file_override{framework.registry, FILENAME};                             \
-            auto          input =                                                                  \
-                snitch::cli::parse_arguments(static_cast<int>((ARGS).size()), (ARGS).data());      \
-            framework.registry.configure(input.value());                                           \
-            framework.registry.run_tests(input.value());                                           \
-        }                                                                                          \
         {                                                                                          \
             std::ifstream file_actual(test_data_path / "actual" / (FILENAME));                     \
             std::ofstream file_blanked(test_data_path / "blanked" / (FILENAME));                   \
@@ -43,7 +36,7 @@ void regex_blank(std::string& line, const std::vector<std::regex>& ignores);
         }                                                                                          \
         {                                                                                          \
             INFO("checking ", FILENAME);                                                           \
-            std::ifstream file_expected(test_data_path / "expected" / (FILENAME));                 \
+            std::ifstream file_expected(test_data_path / "expected" / (EXPECTED_FILENAME));        \
             std::ifstream file_actual(test_data_path / "blanked" / (FILENAME));                    \
             std::string   line_expected;                                                           \
             std::string   line_actual;                                                             \
@@ -62,3 +55,15 @@ void regex_blank(std::string& line, const std::vector<std::regex>& ignores);
             }                                                                                      \
         }                                                                                          \
     } while (0)
+
+#define CHECK_FOR_DIFFERENCES(ARGS, IGNORES, FILENAME)                                             \
+    do {                                                                                           \
+        {                                                                                          \
+            print_to_file file_override{framework.registry, FILENAME};                             \
+            auto          input =                                                                  \
+                snitch::cli::parse_arguments(static_cast<int>((ARGS).size()), (ARGS).data());      \
+            framework.registry.configure(input.value());                                           \
+            framework.registry.run_tests(input.value());                                           \
+        }                                                                                          \
+        CHECK_FILE_FOR_DIFFERENCES(IGNORES, FILENAME, FILENAME);                                   \
+    } while (0)
@@ -0,0 +1,68 @@
+// Renders a log written by the binary reporter, with any other reporter.
+//
+// Usage: snitch-replay <log> [options]
+//
+// The options are the same as for a test application (--reporter, --verbosity, --out, ...); test
+// filters are ignored, since the log only contains the test cases that were run. Logs with a path
+// ending in ".z" are decompressed first, if snitch was built with compressed output support.
+
+#include "snitch/snitch_cli.hpp"
+#include "snitch/snitch_compression.hpp"
+#include "snitch/snitch_registry.hpp"
+#include "snitch/snitch_reporter_binary.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <log> [options]\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "error: could not open '%s'\n", argv[1]);
+        return 1;
+    }
+
+    std::string log{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+#if SNITCH_WITH_COMPRESSED_OUTPUT
+    if (snitch::impl::is_compressed_path(argv[1])) {
+        std::string decompressed;
+        auto append = [&](std::string_view block) noexcept { decompressed.append(block); };
+        if (!snitch::impl::decompress(log, append)) {
+            std::fprintf(stderr, "error: '%s' is not a valid compressed file\n", argv[1]);
+            return 1;
+        }
+
+        log = std::move(decompressed);
+    }
+#endif
+
+    // Forward the remaining arguments, as if this was the test application.
+    std::vector<const char*> args = {argv[0]};
+    args.insert(args.end(), argv + 2, argv + argc);
+
+    std::optional<snitch::cli::input> input =
+        snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+    if (!input) {
+        return 1;
+    }
+
+    snitch::tests.configure(*input);
+
+    const bool success = snitch::reporter::binary::replay(snitch::tests, log);
+    snitch::tests.finish_callback(snitch::tests);
+
+    if (!success) {
+        std::fprintf(stderr, "error: '%s' is not a valid binary log\n", argv[1]);
+        return 1;
+    }
+
+    return 0;
+}